@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "cx.h"
+
+#define AES_BLOCK_SIZE  16
+#define AES_MAX_ROUNDS  14
+#define AES_CHAIN_MASK  (7 << 6)
+#define AES_ENCRYPT_BIT CX_ENCRYPT
+
+typedef struct {
+    uint8_t rounds;
+    uint8_t roundKeys[(AES_MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+} aes_schedule_t;
+
+static const uint8_t aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+static uint8_t aes_inv_sbox[256];
+
+static uint8_t xtime(uint8_t x) {
+    return (uint8_t) ((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+static uint8_t gf_mul(uint8_t x, uint8_t y) {
+    uint8_t r = 0;
+    while (y) {
+        if (y & 1) {
+            r ^= x;
+        }
+        x = xtime(x);
+        y >>= 1;
+    }
+    return r;
+}
+
+static void aes_expand_key(const uint8_t *key, size_t keyLen, aes_schedule_t *schedule) {
+    size_t nk = keyLen / 4;
+    size_t words = 4 * (nk + 7);
+    uint8_t *w = schedule->roundKeys;
+    uint8_t rcon = 0x01;
+
+    schedule->rounds = (uint8_t) (nk + 6);
+    memcpy(w, key, keyLen);
+    for (size_t i = nk; i < words; i++) {
+        uint8_t t[4];
+        memcpy(t, w + 4 * (i - 1), 4);
+        if (i % nk == 0) {
+            uint8_t first = t[0];
+            t[0] = aes_sbox[t[1]] ^ rcon;
+            t[1] = aes_sbox[t[2]];
+            t[2] = aes_sbox[t[3]];
+            t[3] = aes_sbox[first];
+            rcon = xtime(rcon);
+        } else if (nk > 6 && i % nk == 4) {
+            for (int j = 0; j < 4; j++) {
+                t[j] = aes_sbox[t[j]];
+            }
+        }
+        for (int j = 0; j < 4; j++) {
+            w[4 * i + j] = w[4 * (i - nk) + j] ^ t[j];
+        }
+    }
+}
+
+static void add_round_key(uint8_t *state, const uint8_t *roundKey) {
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        state[i] ^= roundKey[i];
+    }
+}
+
+static void aes_encrypt_block(const aes_schedule_t *schedule, uint8_t *state) {
+    add_round_key(state, schedule->roundKeys);
+    for (int round = 1; round <= schedule->rounds; round++) {
+        uint8_t t[AES_BLOCK_SIZE];
+        // SubBytes and ShiftRows
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            t[i] = aes_sbox[state[(i + 4 * (i % 4)) % AES_BLOCK_SIZE]];
+        }
+        // MixColumns, except in the last round
+        for (int c = 0; c < 4 && round != schedule->rounds; c++) {
+            uint8_t *col = t + 4 * c;
+            uint8_t all = col[0] ^ col[1] ^ col[2] ^ col[3];
+            uint8_t first = col[0];
+            col[0] ^= all ^ xtime(col[0] ^ col[1]);
+            col[1] ^= all ^ xtime(col[1] ^ col[2]);
+            col[2] ^= all ^ xtime(col[2] ^ col[3]);
+            col[3] ^= all ^ xtime(col[3] ^ first);
+        }
+        memcpy(state, t, AES_BLOCK_SIZE);
+        add_round_key(state, schedule->roundKeys + AES_BLOCK_SIZE * round);
+    }
+}
+
+static void aes_decrypt_block(const aes_schedule_t *schedule, uint8_t *state) {
+    add_round_key(state, schedule->roundKeys + AES_BLOCK_SIZE * schedule->rounds);
+    for (int round = schedule->rounds - 1; round >= 0; round--) {
+        uint8_t t[AES_BLOCK_SIZE];
+        // InvShiftRows and InvSubBytes
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            t[(i + 4 * (i % 4)) % AES_BLOCK_SIZE] = aes_inv_sbox[state[i]];
+        }
+        add_round_key(t, schedule->roundKeys + AES_BLOCK_SIZE * round);
+        // InvMixColumns, except after the last round
+        for (int c = 0; c < 4 && round != 0; c++) {
+            uint8_t *col = t + 4 * c;
+            uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+            col[0] = gf_mul(a0, 14) ^ gf_mul(a1, 11) ^ gf_mul(a2, 13) ^ gf_mul(a3, 9);
+            col[1] = gf_mul(a0, 9) ^ gf_mul(a1, 14) ^ gf_mul(a2, 11) ^ gf_mul(a3, 13);
+            col[2] = gf_mul(a0, 13) ^ gf_mul(a1, 9) ^ gf_mul(a2, 14) ^ gf_mul(a3, 11);
+            col[3] = gf_mul(a0, 11) ^ gf_mul(a1, 13) ^ gf_mul(a2, 9) ^ gf_mul(a3, 14);
+        }
+        memcpy(state, t, AES_BLOCK_SIZE);
+    }
+}
+
+cx_err_t cx_aes_init_key_no_throw(const uint8_t *raw_key, size_t key_len, cx_aes_key_t *key) {
+    if (raw_key == NULL || key == NULL || (key_len != 16 && key_len != 24 && key_len != 32)) {
+        return CX_INVALID_PARAMETER;
+    }
+    key->size = key_len;
+    memcpy(key->keys, raw_key, key_len);
+    return CX_OK;
+}
+
+cx_err_t cx_aes_iv_no_throw(const cx_aes_key_t *key,
+                            uint32_t mode,
+                            const uint8_t *iv,
+                            size_t iv_len,
+                            const uint8_t *in,
+                            size_t in_len,
+                            uint8_t *out,
+                            size_t *out_len) {
+    aes_schedule_t schedule;
+    uint8_t chain[AES_BLOCK_SIZE] = {0};
+    uint32_t chaining = mode & AES_CHAIN_MASK;
+
+    // Only the unpadded ECB and CBC modes are provided
+    if (key == NULL || out_len == NULL || (in_len % AES_BLOCK_SIZE) != 0 ||
+        *out_len < in_len || (chaining != CX_CHAIN_ECB && chaining != CX_CHAIN_CBC)) {
+        return CX_INVALID_PARAMETER;
+    }
+    if (chaining == CX_CHAIN_CBC) {
+        if (iv == NULL || iv_len != AES_BLOCK_SIZE) {
+            return CX_INVALID_PARAMETER;
+        }
+        memcpy(chain, iv, AES_BLOCK_SIZE);
+    }
+    if (aes_inv_sbox[0] == 0) {
+        for (int i = 0; i < 256; i++) {
+            aes_inv_sbox[aes_sbox[i]] = (uint8_t) i;
+        }
+    }
+    aes_expand_key(key->keys, key->size, &schedule);
+
+    for (size_t offset = 0; offset < in_len; offset += AES_BLOCK_SIZE) {
+        uint8_t block[AES_BLOCK_SIZE];
+        memcpy(block, in + offset, AES_BLOCK_SIZE);
+        if (mode & AES_ENCRYPT_BIT) {
+            if (chaining == CX_CHAIN_CBC) {
+                add_round_key(block, chain);
+            }
+            aes_encrypt_block(&schedule, block);
+            memcpy(chain, block, AES_BLOCK_SIZE);
+        } else {
+            uint8_t cipher[AES_BLOCK_SIZE];
+            memcpy(cipher, block, AES_BLOCK_SIZE);
+            aes_decrypt_block(&schedule, block);
+            if (chaining == CX_CHAIN_CBC) {
+                add_round_key(block, chain);
+            }
+            memcpy(chain, cipher, AES_BLOCK_SIZE);
+        }
+        memcpy(out + offset, block, AES_BLOCK_SIZE);
+    }
+    *out_len = in_len;
+    memset(&schedule, 0, sizeof(schedule));
+    return CX_OK;
+}
@@ -0,0 +1,394 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "cx.h"
+
+/*
+ * Ed25519 with a selectable 512-bit hash, after the public domain TweetNaCl implementation.
+ * NEM uses Keccak-512 (CX_KECCAK) on mainnet and testnet, and SHA3-512 (CX_SHA3) on mijin.
+ */
+
+#define ED25519_KEY_LENGTH       32
+#define ED25519_SIGNATURE_LENGTH 64
+
+typedef int64_t gf[16];
+
+static const gf gf0 = {0};
+static const gf gf1 = {1};
+static const gf D2 = {0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283, 0x149a, 0x00e0,
+                      0xd130, 0xeef3, 0x80f2, 0x198e, 0xfce7, 0x56df, 0xd9dc, 0x2406};
+static const gf X = {0xd51a, 0x8f25, 0x2d60, 0xc956, 0xa7b2, 0x9525, 0xc760, 0x692c,
+                     0xdc5c, 0xfdd6, 0xe231, 0xc0a4, 0x53fe, 0xcd6e, 0x36d3, 0x2169};
+static const gf Y = {0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
+                     0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666};
+
+// Order of the base point, little endian
+static const uint64_t L[32] = {0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7,
+                               0xa2, 0xde, 0xf9, 0xde, 0x14, 0,    0,    0,    0,    0,    0,
+                               0,    0,    0,    0,    0,    0,    0,    0,    0,    0x10};
+
+static void set25519(gf r, const gf a) {
+    for (int i = 0; i < 16; i++) {
+        r[i] = a[i];
+    }
+}
+
+static void car25519(gf o) {
+    for (int i = 0; i < 16; i++) {
+        o[i] += (int64_t) 1 << 16;
+        int64_t c = o[i] >> 16;
+        o[(i + 1) * (i < 15)] += c - 1 + 37 * (c - 1) * (i == 15);
+        o[i] -= c * ((int64_t) 1 << 16);
+    }
+}
+
+static void sel25519(gf p, gf q, int b) {
+    int64_t c = ~(b - 1);
+    for (int i = 0; i < 16; i++) {
+        int64_t t = c & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+static void pack25519(uint8_t *o, const gf n) {
+    gf m, t;
+    set25519(t, n);
+    car25519(t);
+    car25519(t);
+    car25519(t);
+    for (int j = 0; j < 2; j++) {
+        m[0] = t[0] - 0xffed;
+        for (int i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xffff;
+        }
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        int b = (m[15] >> 16) & 1;
+        m[14] &= 0xffff;
+        sel25519(t, m, 1 - b);
+    }
+    for (int i = 0; i < 16; i++) {
+        o[2 * i] = t[i] & 0xff;
+        o[2 * i + 1] = (uint8_t) (t[i] >> 8);
+    }
+}
+
+static uint8_t par25519(const gf a) {
+    uint8_t d[32];
+    pack25519(d, a);
+    return d[0] & 1;
+}
+
+static void A(gf o, const gf a, const gf b) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] + b[i];
+    }
+}
+
+static void Z(gf o, const gf a, const gf b) {
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] - b[i];
+    }
+}
+
+static void M(gf o, const gf a, const gf b) {
+    int64_t t[31] = {0};
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            t[i + j] += a[i] * b[j];
+        }
+    }
+    for (int i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    for (int i = 0; i < 16; i++) {
+        o[i] = t[i];
+    }
+    car25519(o);
+    car25519(o);
+}
+
+static void S(gf o, const gf a) {
+    M(o, a, a);
+}
+
+static void inv25519(gf o, const gf i) {
+    gf c;
+    set25519(c, i);
+    for (int a = 253; a >= 0; a--) {
+        S(c, c);
+        if (a != 2 && a != 4) {
+            M(c, c, i);
+        }
+    }
+    set25519(o, c);
+}
+
+// Extended coordinates (X:Y:Z:T)
+static void point_add(gf p[4], gf q[4]) {
+    gf a, b, c, d, t, e, f, g, h;
+
+    Z(a, p[1], p[0]);
+    Z(t, q[1], q[0]);
+    M(a, a, t);
+    A(b, p[0], p[1]);
+    A(t, q[0], q[1]);
+    M(b, b, t);
+    M(c, p[3], q[3]);
+    M(c, c, D2);
+    M(d, p[2], q[2]);
+    A(d, d, d);
+    Z(e, b, a);
+    Z(f, d, c);
+    A(g, d, c);
+    A(h, b, a);
+
+    M(p[0], e, f);
+    M(p[1], h, g);
+    M(p[2], g, f);
+    M(p[3], e, h);
+}
+
+static void cswap(gf p[4], gf q[4], uint8_t b) {
+    for (int i = 0; i < 4; i++) {
+        sel25519(p[i], q[i], b);
+    }
+}
+
+static void pack(uint8_t *r, gf p[4]) {
+    gf tx, ty, zi;
+    inv25519(zi, p[2]);
+    M(tx, p[0], zi);
+    M(ty, p[1], zi);
+    pack25519(r, ty);
+    r[31] ^= par25519(tx) << 7;
+}
+
+static void scalarmult(gf p[4], gf q[4], const uint8_t *s) {
+    set25519(p[0], gf0);
+    set25519(p[1], gf1);
+    set25519(p[2], gf1);
+    set25519(p[3], gf0);
+    for (int i = 255; i >= 0; --i) {
+        uint8_t b = (s[i / 8] >> (i & 7)) & 1;
+        cswap(p, q, b);
+        point_add(q, p);
+        point_add(p, p);
+        cswap(p, q, b);
+    }
+}
+
+static void scalarbase(gf p[4], const uint8_t *s) {
+    gf q[4];
+    set25519(q[0], X);
+    set25519(q[1], Y);
+    set25519(q[2], gf1);
+    M(q[3], X, Y);
+    scalarmult(p, q, s);
+}
+
+static void modL(uint8_t *r, int64_t x[64]) {
+    int64_t carry;
+    for (int i = 63; i >= 32; --i) {
+        int j;
+        carry = 0;
+        for (j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * (int64_t) L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+    carry = 0;
+    for (int j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * (int64_t) L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (int j = 0; j < 32; j++) {
+        x[j] -= carry * (int64_t) L[j];
+    }
+    for (int i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = x[i] & 255;
+    }
+}
+
+static void reduce(uint8_t *r) {
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) {
+        x[i] = (uint64_t) r[i];
+    }
+    for (int i = 0; i < 64; i++) {
+        r[i] = 0;
+    }
+    modL(r, x);
+}
+
+static cx_err_t hash512(cx_md_t hashID,
+                        const uint8_t *in1,
+                        size_t len1,
+                        const uint8_t *in2,
+                        size_t len2,
+                        const uint8_t *in3,
+                        size_t len3,
+                        uint8_t out[64]) {
+    union {
+        cx_hash_t header;
+        cx_sha3_t sha3;
+        cx_sha512_t sha512;
+    } ctx;
+    cx_err_t error;
+
+    switch (hashID) {
+        case CX_KECCAK:
+            CX_CHECK(cx_keccak_init_no_throw(&ctx.sha3, 512));
+            break;
+        case CX_SHA3:
+            CX_CHECK(cx_sha3_init_no_throw(&ctx.sha3, 512));
+            break;
+        case CX_SHA512:
+            CX_CHECK(cx_sha512_init_no_throw(&ctx.sha512));
+            break;
+        default:
+            return CX_INVALID_PARAMETER;
+    }
+    CX_CHECK(cx_hash_no_throw(&ctx.header, 0, in1, len1, NULL, 0));
+    CX_CHECK(cx_hash_no_throw(&ctx.header, 0, in2, len2, NULL, 0));
+    CX_CHECK(cx_hash_no_throw(&ctx.header, CX_LAST, in3, len3, out, 64));
+end:
+    memset(&ctx, 0, sizeof(ctx));
+    return error;
+}
+
+// Expands the private key into the secret scalar (clamped) and the nonce prefix
+static cx_err_t expand_private_key(const cx_ecfp_private_key_t *pvkey,
+                                   cx_md_t hashID,
+                                   uint8_t expanded[64]) {
+    cx_err_t error = hash512(hashID, pvkey->d, pvkey->d_len, NULL, 0, NULL, 0, expanded);
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+    return error;
+}
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve,
+                                           const uint8_t *raw_key,
+                                           size_t key_len,
+                                           cx_ecfp_private_key_t *pvkey) {
+    if (curve != CX_CURVE_Ed25519) {
+        return CX_EC_INVALID_CURVE;
+    }
+    if (pvkey == NULL || raw_key == NULL || key_len != ED25519_KEY_LENGTH) {
+        return CX_INVALID_PARAMETER;
+    }
+    pvkey->curve = curve;
+    pvkey->d_len = key_len;
+    memcpy(pvkey->d, raw_key, key_len);
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_generate_pair2_no_throw(cx_curve_t curve,
+                                         cx_ecfp_public_key_t *pubkey,
+                                         cx_ecfp_private_key_t *privkey,
+                                         int keep_private,
+                                         cx_md_t hashID) {
+    uint8_t expanded[64];
+    gf p[4], tx, ty, zi;
+    cx_err_t error;
+
+    if (curve != CX_CURVE_Ed25519) {
+        return CX_EC_INVALID_CURVE;
+    }
+    // The host implementation does not generate random private keys
+    if (pubkey == NULL || privkey == NULL || !keep_private) {
+        return CX_INVALID_PARAMETER;
+    }
+    CX_CHECK(expand_private_key(privkey, hashID, expanded));
+
+    // W = 04 || x || y, big endian, as the device does for Ed25519
+    scalarbase(p, expanded);
+    inv25519(zi, p[2]);
+    M(tx, p[0], zi);
+    M(ty, p[1], zi);
+    pubkey->curve = curve;
+    pubkey->W_len = 65;
+    pubkey->W[0] = 0x04;
+    pack25519(pubkey->W + 1, tx);
+    pack25519(pubkey->W + 33, ty);
+    for (int i = 0; i < 16; i++) {
+        uint8_t t = pubkey->W[1 + i];
+        pubkey->W[1 + i] = pubkey->W[32 - i];
+        pubkey->W[32 - i] = t;
+        t = pubkey->W[33 + i];
+        pubkey->W[33 + i] = pubkey->W[64 - i];
+        pubkey->W[64 - i] = t;
+    }
+end:
+    memset(expanded, 0, sizeof(expanded));
+    return error;
+}
+
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey,
+                                cx_md_t hashID,
+                                const uint8_t *hash,
+                                size_t hash_len,
+                                uint8_t *sig,
+                                size_t sig_len) {
+    uint8_t expanded[64];
+    uint8_t publicKey[ED25519_KEY_LENGTH];
+    uint8_t r[64];
+    uint8_t k[64];
+    int64_t x[64];
+    gf p[4];
+    cx_err_t error;
+
+    if (pvkey == NULL || pvkey->curve != CX_CURVE_Ed25519 || sig == NULL ||
+        sig_len < ED25519_SIGNATURE_LENGTH || (hash == NULL && hash_len > 0)) {
+        return CX_INVALID_PARAMETER;
+    }
+    CX_CHECK(expand_private_key(pvkey, hashID, expanded));
+    scalarbase(p, expanded);
+    pack(publicKey, p);
+
+    // r = H(prefix || M) mod L, R = rB
+    CX_CHECK(hash512(hashID, expanded + 32, 32, hash, hash_len, NULL, 0, r));
+    reduce(r);
+    scalarbase(p, r);
+    pack(sig, p);
+
+    // S = r + H(R || A || M) * a mod L
+    CX_CHECK(hash512(hashID, sig, 32, publicKey, sizeof(publicKey), hash, hash_len, k));
+    reduce(k);
+    memset(x, 0, sizeof(x));
+    for (int i = 0; i < 32; i++) {
+        x[i] = (uint64_t) r[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            x[i + j] += k[i] * (uint64_t) expanded[j];
+        }
+    }
+    modL(sig + 32, x);
+end:
+    memset(expanded, 0, sizeof(expanded));
+    memset(r, 0, sizeof(r));
+    memset(x, 0, sizeof(x));
+    return error;
+}
@@ -0,0 +1,463 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "cx.h"
+
+#define KECCAK_STATE_SIZE 200
+#define KECCAK_ROUNDS     24
+#define KECCAK_PADDING    0x01
+#define SHA3_PADDING      0x06
+
+#define SHA512_BLOCK_SIZE     128
+#define SHA512_DIGEST_SIZE    64
+#define RIPEMD160_BLOCK_SIZE  64
+#define RIPEMD160_DIGEST_SIZE 20
+
+#define ROL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+#define ROR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+/* Keccak-f[1600], shared by Keccak and SHA3 */
+
+static const uint64_t keccak_round_constants[KECCAK_ROUNDS] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+    0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+    0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+// Rotation offsets and destination lanes of the combined rho and pi steps
+static const uint8_t keccak_rho[24] = {1,  3,  6,  10, 15, 21, 28, 36, 45, 55, 2,  14,
+                                       27, 41, 56, 8,  25, 43, 62, 18, 39, 61, 20, 44};
+static const uint8_t keccak_pi[24] = {10, 7,  11, 17, 18, 3, 5,  16, 8,  21, 24, 4,
+                                      15, 23, 19, 13, 12, 2, 20, 14, 22, 9,  6,  1};
+
+static void keccak_f(uint64_t state[25]) {
+    uint64_t bc[5];
+    for (int round = 0; round < KECCAK_ROUNDS; round++) {
+        // theta
+        for (int i = 0; i < 5; i++) {
+            bc[i] = state[i] ^ state[i + 5] ^ state[i + 10] ^ state[i + 15] ^ state[i + 20];
+        }
+        for (int i = 0; i < 5; i++) {
+            uint64_t t = bc[(i + 4) % 5] ^ ROL64(bc[(i + 1) % 5], 1);
+            for (int j = 0; j < 25; j += 5) {
+                state[j + i] ^= t;
+            }
+        }
+        // rho and pi
+        uint64_t current = state[1];
+        for (int i = 0; i < 24; i++) {
+            uint64_t next = state[keccak_pi[i]];
+            state[keccak_pi[i]] = ROL64(current, keccak_rho[i]);
+            current = next;
+        }
+        // chi
+        for (int j = 0; j < 25; j += 5) {
+            for (int i = 0; i < 5; i++) {
+                bc[i] = state[j + i];
+            }
+            for (int i = 0; i < 5; i++) {
+                state[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // iota
+        state[0] ^= keccak_round_constants[round];
+    }
+}
+
+static void keccak_absorb_block(cx_sha3_t *hash, const uint8_t *block) {
+    for (size_t i = 0; i < hash->block_size / 8; i++) {
+        uint64_t lane = 0;
+        for (int j = 7; j >= 0; j--) {
+            lane = (lane << 8) | block[8 * i + j];
+        }
+        hash->acc[i] ^= lane;
+    }
+    keccak_f(hash->acc);
+}
+
+static cx_err_t sha3_init(cx_sha3_t *hash, cx_md_t algo, size_t size) {
+    if (size != 224 && size != 256 && size != 384 && size != 512) {
+        return CX_INVALID_PARAMETER;
+    }
+    memset(hash, 0, sizeof(cx_sha3_t));
+    hash->header.algo = algo;
+    hash->output_size = size / 8;
+    hash->block_size = KECCAK_STATE_SIZE - 2 * hash->output_size;
+    return CX_OK;
+}
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size) {
+    return sha3_init(hash, CX_KECCAK, size);
+}
+
+cx_err_t cx_sha3_init_no_throw(cx_sha3_t *hash, size_t size) {
+    return sha3_init(hash, CX_SHA3, size);
+}
+
+static void sha3_update(cx_sha3_t *hash, const uint8_t *in, size_t len) {
+    while (len > 0) {
+        size_t n = hash->block_size - hash->blen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen == hash->block_size) {
+            keccak_absorb_block(hash, hash->block);
+            hash->blen = 0;
+        }
+    }
+}
+
+static void sha3_final(cx_sha3_t *hash, uint8_t *out) {
+    memset(hash->block + hash->blen, 0, hash->block_size - hash->blen);
+    hash->block[hash->blen] = hash->header.algo == CX_KECCAK ? KECCAK_PADDING : SHA3_PADDING;
+    hash->block[hash->block_size - 1] |= 0x80;
+    keccak_absorb_block(hash, hash->block);
+    for (size_t i = 0; i < hash->output_size; i++) {
+        out[i] = (uint8_t) (hash->acc[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+/* SHA-512 */
+
+static const uint64_t sha512_constants[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+cx_err_t cx_sha512_init_no_throw(cx_sha512_t *hash) {
+    static const uint64_t iv[8] = {0x6a09e667f3bcc908,
+                                   0xbb67ae8584caa73b,
+                                   0x3c6ef372fe94f82b,
+                                   0xa54ff53a5f1d36f1,
+                                   0x510e527fade682d1,
+                                   0x9b05688c2b3e6c1f,
+                                   0x1f83d9abfb41bd6b,
+                                   0x5be0cd19137e2179};
+    memset(hash, 0, sizeof(cx_sha512_t));
+    hash->header.algo = CX_SHA512;
+    memcpy(hash->acc, iv, sizeof(iv));
+    return CX_OK;
+}
+
+static void sha512_block(cx_sha512_t *hash, const uint8_t *block) {
+    uint64_t w[80];
+    uint64_t s[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (int j = 0; j < 8; j++) {
+            w[i] = (w[i] << 8) | block[8 * i + j];
+        }
+    }
+    for (int i = 16; i < 80; i++) {
+        uint64_t s0 = ROR64(w[i - 15], 1) ^ ROR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        uint64_t s1 = ROR64(w[i - 2], 19) ^ ROR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    memcpy(s, hash->acc, sizeof(s));
+    for (int i = 0; i < 80; i++) {
+        uint64_t t1 = s[7] + (ROR64(s[4], 14) ^ ROR64(s[4], 18) ^ ROR64(s[4], 41)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + sha512_constants[i] + w[i];
+        uint64_t t2 = (ROR64(s[0], 28) ^ ROR64(s[0], 34) ^ ROR64(s[0], 39)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+        memmove(s + 1, s, 7 * sizeof(uint64_t));
+        s[4] += t1;
+        s[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) {
+        hash->acc[i] += s[i];
+    }
+}
+
+static void sha512_update(cx_sha512_t *hash, const uint8_t *in, size_t len) {
+    hash->length += len;
+    while (len > 0) {
+        size_t n = SHA512_BLOCK_SIZE - hash->blen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen == SHA512_BLOCK_SIZE) {
+            sha512_block(hash, hash->block);
+            hash->blen = 0;
+        }
+    }
+}
+
+static void sha512_final(cx_sha512_t *hash, uint8_t *out) {
+    uint64_t bits = hash->length * 8;
+    hash->block[hash->blen++] = 0x80;
+    if (hash->blen > SHA512_BLOCK_SIZE - 16) {
+        memset(hash->block + hash->blen, 0, SHA512_BLOCK_SIZE - hash->blen);
+        sha512_block(hash, hash->block);
+        hash->blen = 0;
+    }
+    memset(hash->block + hash->blen, 0, SHA512_BLOCK_SIZE - hash->blen);
+    for (int i = 0; i < 8; i++) {
+        hash->block[SHA512_BLOCK_SIZE - 1 - i] = (uint8_t) (bits >> (8 * i));
+    }
+    sha512_block(hash, hash->block);
+    for (int i = 0; i < SHA512_DIGEST_SIZE; i++) {
+        out[i] = (uint8_t) (hash->acc[i / 8] >> (8 * (7 - i % 8)));
+    }
+}
+
+/* RIPEMD-160 */
+
+static const uint8_t ripemd160_r[80] = {
+    0, 1, 2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 7,  4,  13, 1,
+    10, 6, 15, 3,  12, 0,  9,  5,  2,  14, 11, 8,  3,  10, 14, 4, 9,  15, 8,  1,
+    2,  7, 0,  6,  13, 11, 5,  12, 1,  9,  11, 10, 0,  8,  12, 4, 13, 3,  7,  15,
+    14, 5, 6,  2,  4,  0,  5,  9,  7,  12, 2,  10, 14, 1,  3,  8, 11, 6,  15, 13};
+static const uint8_t ripemd160_rp[80] = {
+    5,  14, 7,  0, 9, 2,  11, 4,  13, 6,  15, 8,  1,  10, 3,  12, 6,  11, 3,  7,
+    0,  13, 5,  10, 14, 15, 8,  12, 4,  9,  1,  2,  15, 5,  1,  3,  7,  14, 6,  9,
+    11, 8,  12, 2,  10, 0,  4,  13, 8,  6,  4,  1,  3,  11, 15, 0,  5,  12, 2,  13,
+    9,  7,  10, 14, 12, 15, 10, 4,  1,  5,  8,  7,  6,  2,  13, 14, 0,  3,  9,  11};
+static const uint8_t ripemd160_s[80] = {
+    11, 14, 15, 12, 5,  8,  7,  9,  11, 13, 14, 15, 6,  7,  9,  8,  7,  6,  8,  13,
+    11, 9,  7,  15, 7,  12, 15, 9,  11, 7,  13, 12, 11, 13, 6,  7,  14, 9,  13, 15,
+    14, 8,  13, 6,  5,  12, 7,  5,  11, 12, 14, 15, 14, 15, 9,  8,  9,  14, 5,  6,
+    8,  6,  5,  12, 9,  15, 5,  11, 6,  8,  13, 12, 5,  12, 13, 14, 11, 8,  5,  6};
+static const uint8_t ripemd160_sp[80] = {
+    8,  9,  9,  11, 13, 15, 15, 5,  7,  7,  8,  11, 14, 14, 12, 6,  9,  13, 15, 7,
+    12, 8,  9,  11, 7,  7,  12, 7,  6,  15, 13, 11, 9,  7,  15, 11, 8,  6,  6,  14,
+    12, 13, 5,  14, 13, 13, 7,  5,  15, 5,  8,  11, 14, 14, 6,  14, 6,  9,  12, 9,
+    12, 5,  15, 8,  8,  5,  12, 9,  12, 5,  14, 6,  8,  13, 6,  5,  15, 13, 11, 11};
+static const uint32_t ripemd160_k[5] = {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+static const uint32_t ripemd160_kp[5] =
+    {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+
+static uint32_t ripemd160_f(int round, uint32_t x, uint32_t y, uint32_t z) {
+    switch (round) {
+        case 0:
+            return x ^ y ^ z;
+        case 1:
+            return (x & y) | (~x & z);
+        case 2:
+            return (x | ~y) ^ z;
+        case 3:
+            return (x & z) | (y & ~z);
+        default:
+            return x ^ (y | ~z);
+    }
+}
+
+cx_err_t cx_ripemd160_init_no_throw(cx_ripemd160_t *hash) {
+    memset(hash, 0, sizeof(cx_ripemd160_t));
+    hash->header.algo = CX_RIPEMD160;
+    hash->acc[0] = 0x67452301;
+    hash->acc[1] = 0xEFCDAB89;
+    hash->acc[2] = 0x98BADCFE;
+    hash->acc[3] = 0x10325476;
+    hash->acc[4] = 0xC3D2E1F0;
+    return CX_OK;
+}
+
+static void ripemd160_block(cx_ripemd160_t *hash, const uint8_t *block) {
+    uint32_t x[16];
+    for (int i = 0; i < 16; i++) {
+        x[i] = (uint32_t) block[4 * i] | ((uint32_t) block[4 * i + 1] << 8) |
+               ((uint32_t) block[4 * i + 2] << 16) | ((uint32_t) block[4 * i + 3] << 24);
+    }
+
+    uint32_t a = hash->acc[0], b = hash->acc[1], c = hash->acc[2], d = hash->acc[3];
+    uint32_t e = hash->acc[4];
+    uint32_t ap = a, bp = b, cp = c, dp = d, ep = e;
+    for (int j = 0; j < 80; j++) {
+        int round = j / 16;
+        uint32_t t = a + ripemd160_f(round, b, c, d) + x[ripemd160_r[j]] + ripemd160_k[round];
+        t = ROL32(t, ripemd160_s[j]) + e;
+        a = e;
+        e = d;
+        d = ROL32(c, 10);
+        c = b;
+        b = t;
+        t = ap + ripemd160_f(4 - round, bp, cp, dp) + x[ripemd160_rp[j]] + ripemd160_kp[round];
+        t = ROL32(t, ripemd160_sp[j]) + ep;
+        ap = ep;
+        ep = dp;
+        dp = ROL32(cp, 10);
+        cp = bp;
+        bp = t;
+    }
+    uint32_t t = hash->acc[1] + c + dp;
+    hash->acc[1] = hash->acc[2] + d + ep;
+    hash->acc[2] = hash->acc[3] + e + ap;
+    hash->acc[3] = hash->acc[4] + a + bp;
+    hash->acc[4] = hash->acc[0] + b + cp;
+    hash->acc[0] = t;
+}
+
+static void ripemd160_update(cx_ripemd160_t *hash, const uint8_t *in, size_t len) {
+    hash->length += len;
+    while (len > 0) {
+        size_t n = RIPEMD160_BLOCK_SIZE - hash->blen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen == RIPEMD160_BLOCK_SIZE) {
+            ripemd160_block(hash, hash->block);
+            hash->blen = 0;
+        }
+    }
+}
+
+static void ripemd160_final(cx_ripemd160_t *hash, uint8_t *out) {
+    uint64_t bits = hash->length * 8;
+    hash->block[hash->blen++] = 0x80;
+    if (hash->blen > RIPEMD160_BLOCK_SIZE - 8) {
+        memset(hash->block + hash->blen, 0, RIPEMD160_BLOCK_SIZE - hash->blen);
+        ripemd160_block(hash, hash->block);
+        hash->blen = 0;
+    }
+    memset(hash->block + hash->blen, 0, RIPEMD160_BLOCK_SIZE - hash->blen);
+    for (int i = 0; i < 8; i++) {
+        hash->block[RIPEMD160_BLOCK_SIZE - 8 + i] = (uint8_t) (bits >> (8 * i));
+    }
+    ripemd160_block(hash, hash->block);
+    for (int i = 0; i < RIPEMD160_DIGEST_SIZE; i++) {
+        out[i] = (uint8_t) (hash->acc[i / 4] >> (8 * (i % 4)));
+    }
+}
+
+/* Generic hash interface */
+
+static size_t hash_output_size(const cx_hash_t *hash) {
+    switch (hash->algo) {
+        case CX_KECCAK:
+        case CX_SHA3:
+            return ((const cx_sha3_t *) hash)->output_size;
+        case CX_SHA512:
+            return SHA512_DIGEST_SIZE;
+        case CX_RIPEMD160:
+            return RIPEMD160_DIGEST_SIZE;
+        default:
+            return 0;
+    }
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len) {
+    size_t output_size = hash_output_size(hash);
+    if (output_size == 0 || (in == NULL && len > 0)) {
+        return CX_INVALID_PARAMETER;
+    }
+    if ((mode & CX_LAST) && (out == NULL || out_len < output_size)) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    switch (hash->algo) {
+        case CX_KECCAK:
+        case CX_SHA3:
+            sha3_update((cx_sha3_t *) hash, in, len);
+            if (mode & CX_LAST) {
+                sha3_final((cx_sha3_t *) hash, out);
+            }
+            break;
+        case CX_SHA512:
+            sha512_update((cx_sha512_t *) hash, in, len);
+            if (mode & CX_LAST) {
+                sha512_final((cx_sha512_t *) hash, out);
+            }
+            break;
+        default:  // CX_RIPEMD160
+            ripemd160_update((cx_ripemd160_t *) hash, in, len);
+            if (mode & CX_LAST) {
+                ripemd160_final((cx_ripemd160_t *) hash, out);
+            }
+            break;
+    }
+    return CX_OK;
+}
+
+size_t cx_hmac_sha512(const uint8_t *key,
+                      size_t key_len,
+                      const uint8_t *in,
+                      size_t len,
+                      uint8_t *mac,
+                      size_t mac_len) {
+    uint8_t pad[SHA512_BLOCK_SIZE];
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    cx_sha512_t hash;
+
+    if (mac_len < SHA512_DIGEST_SIZE) {
+        return 0;
+    }
+    memset(pad, 0, sizeof(pad));
+    if (key_len > SHA512_BLOCK_SIZE) {
+        cx_sha512_init_no_throw(&hash);
+        cx_hash_no_throw(&hash.header, CX_LAST, key, key_len, pad, sizeof(pad));
+    } else {
+        memcpy(pad, key, key_len);
+    }
+
+    // inner hash, the input may overlap the output buffer
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36;
+    }
+    cx_sha512_init_no_throw(&hash);
+    cx_hash_no_throw(&hash.header, 0, pad, sizeof(pad), NULL, 0);
+    cx_hash_no_throw(&hash.header, CX_LAST, in, len, digest, sizeof(digest));
+
+    // outer hash
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36 ^ 0x5C;
+    }
+    cx_sha512_init_no_throw(&hash);
+    cx_hash_no_throw(&hash.header, 0, pad, sizeof(pad), NULL, 0);
+    cx_hash_no_throw(&hash.header, CX_LAST, digest, sizeof(digest), mac, mac_len);
+
+    memset(pad, 0, sizeof(pad));
+    memset(digest, 0, sizeof(digest));
+    return SHA512_DIGEST_SIZE;
+}
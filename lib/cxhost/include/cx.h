@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_CXHOST_CX_H
+#define LEDGER_APP_NEM_CXHOST_CX_H
+
+/*
+ * Host implementation of the subset of the BOLOS cryptographic API used by the application.
+ * Types, constants and prototypes follow the SDK ones so that the application sources build
+ * unchanged; the implementations are portable C and are not hardened against side channels.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t cx_err_t;
+
+#define CX_OK                0x00000000
+#define CX_INVALID_PARAMETER 0xFFFFFF82
+#define CX_EC_INVALID_CURVE  0xFFFFFFA2
+
+#define CX_CHECK(call)     \
+    do {                   \
+        error = call;      \
+        if (error) {       \
+            goto end;      \
+        }                  \
+    } while (0)
+
+// cx_hash_no_throw / cx_aes_iv_no_throw modes
+#define CX_LAST      (1 << 0)
+#define CX_DECRYPT   (0 << 1)
+#define CX_ENCRYPT   (2 << 1)
+#define CX_PAD_NONE  (0 << 3)
+#define CX_CHAIN_ECB (0 << 6)
+#define CX_CHAIN_CBC (1 << 6)
+
+typedef enum cx_md_e {
+    CX_NONE = 0,
+    CX_RIPEMD160 = 1,
+    CX_SHA224 = 2,
+    CX_SHA256 = 3,
+    CX_SHA384 = 4,
+    CX_SHA512 = 5,
+    CX_KECCAK = 6,
+    CX_SHA3 = 7,
+} cx_md_t;
+
+typedef enum cx_curve_e {
+    CX_CURVE_NONE = 0,
+    CX_CURVE_Ed25519 = 0x71,
+} cx_curve_t;
+
+typedef struct cx_hash_header_s {
+    cx_md_t algo;
+} cx_hash_t;
+
+typedef struct {
+    cx_hash_t header;
+    size_t output_size;
+    size_t block_size;
+    size_t blen;
+    uint8_t block[200];
+    uint64_t acc[25];
+} cx_sha3_t;
+
+typedef struct {
+    cx_hash_t header;
+    size_t blen;
+    uint8_t block[64];
+    uint64_t length;
+    uint32_t acc[5];
+} cx_ripemd160_t;
+
+typedef struct {
+    cx_hash_t header;
+    size_t blen;
+    uint8_t block[128];
+    uint64_t length;
+    uint64_t acc[8];
+} cx_sha512_t;
+
+typedef struct {
+    size_t size;
+    uint8_t keys[32];
+} cx_aes_key_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t d_len;
+    uint8_t d[32];
+} cx_ecfp_private_key_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t W_len;
+    uint8_t W[65];
+} cx_ecfp_public_key_t;
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size);
+cx_err_t cx_sha3_init_no_throw(cx_sha3_t *hash, size_t size);
+cx_err_t cx_ripemd160_init_no_throw(cx_ripemd160_t *hash);
+cx_err_t cx_sha512_init_no_throw(cx_sha512_t *hash);
+
+static inline int cx_ripemd160_init(cx_ripemd160_t *hash) {
+    cx_ripemd160_init_no_throw(hash);
+    return CX_RIPEMD160;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len);
+
+size_t cx_hmac_sha512(const uint8_t *key,
+                      size_t key_len,
+                      const uint8_t *in,
+                      size_t len,
+                      uint8_t *mac,
+                      size_t mac_len);
+
+cx_err_t cx_aes_init_key_no_throw(const uint8_t *raw_key, size_t key_len, cx_aes_key_t *key);
+cx_err_t cx_aes_iv_no_throw(const cx_aes_key_t *key,
+                            uint32_t mode,
+                            const uint8_t *iv,
+                            size_t iv_len,
+                            const uint8_t *in,
+                            size_t in_len,
+                            uint8_t *out,
+                            size_t *out_len);
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve,
+                                           const uint8_t *raw_key,
+                                           size_t key_len,
+                                           cx_ecfp_private_key_t *pvkey);
+cx_err_t cx_ecfp_generate_pair2_no_throw(cx_curve_t curve,
+                                         cx_ecfp_public_key_t *pubkey,
+                                         cx_ecfp_private_key_t *privkey,
+                                         int keep_private,
+                                         cx_md_t hashID);
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey,
+                                cx_md_t hashID,
+                                const uint8_t *hash,
+                                size_t hash_len,
+                                uint8_t *sig,
+                                size_t sig_len);
+
+#endif  // LEDGER_APP_NEM_CXHOST_CX_H
@@ -0,0 +1,37 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_CXHOST_H
+#define LEDGER_APP_NEM_CXHOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CXHOST_SEED_LENGTH 64
+
+/**
+ * Replaces the BIP39 seed used by os_derive_bip32_with_seed_no_throw().
+ * The default seed is the one of the Speculos default mnemonic, so that keys derived on the
+ * host match the values expected by the functional tests.
+ */
+int cxhost_set_seed(const uint8_t *seed, size_t seedLen);
+
+/**
+ * Restores the Speculos default seed.
+ */
+void cxhost_reset_seed(void);
+
+#endif  // LEDGER_APP_NEM_CXHOST_H
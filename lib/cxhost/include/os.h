@@ -0,0 +1,47 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_CXHOST_OS_H
+#define LEDGER_APP_NEM_CXHOST_OS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "cx.h"
+#include "status_words.h"
+
+#ifndef UNUSED
+#define UNUSED(x) (void) (x)
+#endif
+
+#define HDW_NORMAL         0
+#define HDW_ED25519_SLIP10 1
+
+/**
+ * SLIP-0010 Ed25519 derivation from the host seed, see cxhost_set_seed().
+ * Only hardened indexes are supported, as for Ed25519 on the device.
+ */
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivation_mode,
+                                            cx_curve_t curve,
+                                            const uint32_t *path,
+                                            size_t path_len,
+                                            uint8_t raw_privkey[64],
+                                            uint8_t *chain_code,
+                                            unsigned char *seed_key,
+                                            size_t seed_key_len);
+
+#endif  // LEDGER_APP_NEM_CXHOST_OS_H
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_CXHOST_STATUS_WORDS_H
+#define LEDGER_APP_NEM_CXHOST_STATUS_WORDS_H
+
+// Status words of the SDK used by the application
+#define SWO_SUCCESS                          0x9000
+#define SWO_DATA_MAY_BE_CORRUPTED            0x6281
+#define SWO_WRONG_DATA_LENGTH                0x6700
+#define SWO_SECURITY_CONDITION_NOT_SATISFIED 0x6982
+#define SWO_CONDITIONS_NOT_SATISFIED         0x6985
+#define SWO_INCORRECT_DATA                   0x6A80
+#define SWO_NOT_ENOUGH_MEMORY_SPACE          0x6A84
+#define SWO_WRONG_P1_P2                      0x6B00
+#define SWO_PARAMETER_ERROR_NO_INFO          0x6B00
+#define SWO_INVALID_INS                      0x6D00
+#define SWO_INVALID_CLA                      0x6E00
+#define SWO_COMMAND_ERROR_NO_INFO            0x6F00
+
+#endif  // LEDGER_APP_NEM_CXHOST_STATUS_WORDS_H
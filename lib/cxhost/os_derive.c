@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "os.h"
+#include "cxhost.h"
+
+#define SLIP10_HARDENED 0x80000000u
+
+// BIP39 seed of the Speculos default mnemonic ("glory promote mansion idle axis finger ...")
+static const uint8_t default_seed[CXHOST_SEED_LENGTH] = {
+    0xb1, 0x19, 0x97, 0xfa, 0xff, 0x42, 0x0a, 0x33, 0x1b, 0xb4, 0xa4, 0xff,
+    0xdc, 0x8b, 0xdc, 0x8b, 0xa7, 0xc0, 0x17, 0x32, 0xa9, 0x9a, 0x30, 0xd8,
+    0x3d, 0xbb, 0xeb, 0xd4, 0x69, 0x66, 0x6c, 0x84, 0xb4, 0x7d, 0x09, 0xd3,
+    0xf5, 0xf4, 0x72, 0xb3, 0xb9, 0x38, 0x4a, 0xc6, 0x34, 0xbe, 0xba, 0x2a,
+    0x44, 0x0b, 0xa3, 0x6e, 0xc7, 0x66, 0x11, 0x44, 0x13, 0x2f, 0x35, 0xe2,
+    0x06, 0x87, 0x35, 0x64};
+
+static uint8_t host_seed[CXHOST_SEED_LENGTH];
+static size_t host_seed_length;
+static bool host_seed_set;
+
+int cxhost_set_seed(const uint8_t *seed, size_t seedLen) {
+    if (seed == NULL || seedLen == 0 || seedLen > sizeof(host_seed)) {
+        return -1;
+    }
+    memcpy(host_seed, seed, seedLen);
+    host_seed_length = seedLen;
+    host_seed_set = true;
+    return 0;
+}
+
+void cxhost_reset_seed(void) {
+    memset(host_seed, 0, sizeof(host_seed));
+    host_seed_length = 0;
+    host_seed_set = false;
+}
+
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivation_mode,
+                                            cx_curve_t curve,
+                                            const uint32_t *path,
+                                            size_t path_len,
+                                            uint8_t raw_privkey[64],
+                                            uint8_t *chain_code,
+                                            unsigned char *seed_key,
+                                            size_t seed_key_len) {
+    uint8_t node[64];
+    uint8_t data[1 + 32 + 4];
+
+    if (derivation_mode != HDW_ED25519_SLIP10 || curve != CX_CURVE_Ed25519 ||
+        raw_privkey == NULL || (path == NULL && path_len > 0) || seed_key == NULL) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    // master node: I = HMAC-SHA512(seed key, seed), private key = IL, chain code = IR
+    const uint8_t *seed = host_seed_set ? host_seed : default_seed;
+    size_t seedLength = host_seed_set ? host_seed_length : sizeof(default_seed);
+    cx_hmac_sha512(seed_key, seed_key_len, seed, seedLength, node, sizeof(node));
+
+    // hardened child: I = HMAC-SHA512(chain code, 0x00 || private key || index)
+    for (size_t i = 0; i < path_len; i++) {
+        if ((path[i] & SLIP10_HARDENED) == 0) {
+            memset(node, 0, sizeof(node));
+            return CX_INVALID_PARAMETER;
+        }
+        data[0] = 0x00;
+        memcpy(data + 1, node, 32);
+        data[33] = (uint8_t) (path[i] >> 24);
+        data[34] = (uint8_t) (path[i] >> 16);
+        data[35] = (uint8_t) (path[i] >> 8);
+        data[36] = (uint8_t) path[i];
+        cx_hmac_sha512(node + 32, 32, data, sizeof(data), node, sizeof(node));
+    }
+
+    memset(raw_privkey, 0, 64);
+    memcpy(raw_privkey, node, 32);
+    if (chain_code != NULL) {
+        memcpy(chain_code, node + 32, 32);
+    }
+    memset(node, 0, sizeof(node));
+    memset(data, 0, sizeof(data));
+    return CX_OK;
+}
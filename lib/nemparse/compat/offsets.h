@@ -0,0 +1,9 @@
+// Host replacement of the BOLOS SDK header
+#pragma once
+
+#define OFFSET_CLA   0
+#define OFFSET_INS   1
+#define OFFSET_P1    2
+#define OFFSET_P2    3
+#define OFFSET_LC    4
+#define OFFSET_CDATA 5
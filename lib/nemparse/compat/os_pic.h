@@ -0,0 +1,4 @@
+// Host replacement of the BOLOS SDK header: the code runs at its link address
+#pragma once
+
+#define PIC(x) (x)
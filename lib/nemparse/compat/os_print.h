@@ -0,0 +1,4 @@
+// Host replacement of the BOLOS SDK header: debug traces are not printed
+#pragma once
+
+#define PRINTF(...)
@@ -0,0 +1,13 @@
+// Host replacement of the BOLOS SDK header, limited to what the parser and formatters use
+#pragma once
+
+#include <stdint.h>
+
+#define U2BE(buf, off) ((uint16_t) (((uint16_t) (buf)[(off)] << 8) | (uint16_t) (buf)[(off) + 1]))
+#define U4BE(buf, off) \
+    ((uint32_t) (((uint32_t) U2BE(buf, off) << 16) | (uint32_t) U2BE(buf, (off) + 2)))
+#define U2LE(buf, off) ((uint16_t) (((uint16_t) (buf)[(off) + 1] << 8) | (uint16_t) (buf)[(off)]))
+#define U4LE(buf, off) \
+    ((uint32_t) (((uint32_t) U2LE(buf, (off) + 2) << 16) | (uint32_t) U2LE(buf, off)))
+#define U8LE(buf, off) \
+    ((uint64_t) (((uint64_t) U4LE(buf, (off) + 4) << 32) | (uint64_t) U4LE(buf, off)))
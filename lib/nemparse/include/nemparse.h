@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LIBNEMPARSE_H
+#define LIBNEMPARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Buffer sizes used by the application review screens
+#define NEMPARSE_FIELDNAME_LEN 50
+#define NEMPARSE_FIELD_LEN     1024
+#define NEMPARSE_ADDRESS_LEN   40
+
+enum nemparse_error {
+    NEMPARSE_OK = 0,
+    NEMPARSE_NOT_ENOUGH_DATA = -1,
+    NEMPARSE_INVALID_DATA = -2,
+    NEMPARSE_TOO_MANY_FIELDS = -3,
+    NEMPARSE_BAD_ARGUMENT = -10,
+    NEMPARSE_HASH_FAILURE = -11,
+};
+
+typedef struct nemparse_ctx nemparse_ctx_t;
+
+// Raw field as produced by the application parser
+typedef struct {
+    uint8_t id;
+    uint8_t dataType;
+    uint16_t length;
+    const uint8_t *data;
+} nemparse_field_t;
+
+// Hash functions used to derive addresses, each returns 0 on success
+typedef int (*nemparse_hash_fn_t)(const uint8_t *in, size_t inLen, uint8_t *out, void *user);
+
+typedef struct {
+    // 32 bytes digest, used by mainnet and testnet
+    nemparse_hash_fn_t keccak256;
+    // 32 bytes digest, used by mijin networks
+    nemparse_hash_fn_t sha3_256;
+    // 20 bytes digest
+    nemparse_hash_fn_t ripemd160;
+    void *user;
+} nemparse_hash_backend_t;
+
+nemparse_ctx_t *nemparse_new(void);
+void nemparse_free(nemparse_ctx_t *ctx);
+
+/**
+ * Parses the serialized transaction 'data'. The buffer must stay valid as long as fields are
+ * accessed, it is not copied.
+ *
+ */
+int nemparse_parse(nemparse_ctx_t *ctx, const uint8_t *data, size_t length);
+
+uint32_t nemparse_transaction_type(const nemparse_ctx_t *ctx);
+// Length of the data signed by the application
+size_t nemparse_sign_length(const nemparse_ctx_t *ctx);
+
+size_t nemparse_field_count(const nemparse_ctx_t *ctx);
+int nemparse_get_field(const nemparse_ctx_t *ctx, size_t index, nemparse_field_t *field);
+
+/**
+ * Write the name and the value of a field as displayed by the application. The output is always
+ * null terminated and truncated to 'dstLen'. Return the length of the untruncated string or a
+ * negative error.
+ *
+ */
+int nemparse_field_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen);
+int nemparse_format_field(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen);
+
+/**
+ * The review screens show a field per pair, except the messages longer than 256 characters which
+ * are split into several parts. Return the number of parts of a field or a negative error, and
+ * write one part as 'nemparse_format_field' does.
+ *
+ */
+int nemparse_field_chunk_count(const nemparse_ctx_t *ctx, size_t index);
+int nemparse_format_field_chunk(const nemparse_ctx_t *ctx,
+                                size_t index,
+                                size_t chunk,
+                                char *dst,
+                                size_t dstLen);
+
+/**
+ * The transactions wrapping others and the transfers of mosaics other than XEM are reviewed after
+ * a summary page: XEM moved, fees, other mosaics and cosignatory changes. Return the number of
+ * summary pairs, 0 without summary page, and write the name and the value of a pair.
+ *
+ */
+size_t nemparse_summary_pair_count(const nemparse_ctx_t *ctx);
+int nemparse_summary_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen);
+int nemparse_format_summary_pair(const nemparse_ctx_t *ctx,
+                                 size_t index,
+                                 char *dst,
+                                 size_t dstLen);
+
+/**
+ * Pairs of the review screens, in their order: the summary pairs, then the parts of each field.
+ * The parts of a split message are named "<name> <part>/<parts>". These are also the pairs listed
+ * by the PARSE NEM TRANSACTION command.
+ *
+ */
+size_t nemparse_review_pair_count(const nemparse_ctx_t *ctx);
+int nemparse_review_pair_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen);
+int nemparse_format_review_pair(const nemparse_ctx_t *ctx,
+                                size_t index,
+                                char *dst,
+                                size_t dstLen);
+
+/**
+ * Set the hash functions used to display the addresses of remote and cosignatory public keys.
+ * Without backend these fields are left empty, as in the application fuzzing builds.
+ *
+ */
+void nemparse_set_hash_backend(nemparse_ctx_t *ctx, const nemparse_hash_backend_t *backend);
+
+int nemparse_public_key_to_address(const nemparse_hash_backend_t *backend,
+                                   const uint8_t *publicKey,
+                                   uint8_t networkType,
+                                   char *dst,
+                                   size_t dstLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBNEMPARSE_H
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nemparse.h"
+#include "nem_parse.h"
+#include "app_format.h"
+#include "printers.h"
+#include "nem_helpers.h"
+
+// Offset of the network type in the common transaction header
+#define COMMON_HEADER_NETWORK_OFFSET 7
+
+struct nemparse_ctx {
+    parse_context_t parse;
+    nemparse_hash_backend_t backend;
+    uint8_t hasBackend;
+};
+
+nemparse_ctx_t *nemparse_new(void) {
+    return calloc(1, sizeof(nemparse_ctx_t));
+}
+
+void nemparse_free(nemparse_ctx_t *ctx) {
+    free(ctx);
+}
+
+int nemparse_parse(nemparse_ctx_t *ctx, const uint8_t *data, size_t length) {
+    if (ctx == NULL || data == NULL || length > UINT32_MAX) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    memset(&ctx->parse, 0, sizeof(ctx->parse));
+    // The parser never writes to the transaction data
+    ctx->parse.data = (uint8_t *) data;
+    ctx->parse.length = length;
+    int error = parse_txn_context(&ctx->parse);
+    if (error != E_SUCCESS) {
+        ctx->parse.result.numFields = 0;
+    }
+    return error;
+}
+
+uint32_t nemparse_transaction_type(const nemparse_ctx_t *ctx) {
+    return ctx->parse.transactionType;
+}
+
+size_t nemparse_sign_length(const nemparse_ctx_t *ctx) {
+    return ctx->parse.signLength;
+}
+
+size_t nemparse_field_count(const nemparse_ctx_t *ctx) {
+    return ctx->parse.result.numFields;
+}
+
+static const field_t *get_field(const nemparse_ctx_t *ctx, size_t index) {
+    if (ctx == NULL || index >= ctx->parse.result.numFields) {
+        return NULL;
+    }
+    return &ctx->parse.result.fields[index];
+}
+
+int nemparse_get_field(const nemparse_ctx_t *ctx, size_t index, nemparse_field_t *field) {
+    const field_t *f = get_field(ctx, index);
+    if (f == NULL || field == NULL) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    field->id = f->id;
+    field->dataType = f->dataType;
+    field->length = f->length;
+    field->data = f->data;
+    return NEMPARSE_OK;
+}
+
+static int copy_string(const char *src, char *dst, size_t dstLen) {
+    size_t len = strlen(src);
+    if (dstLen > 0) {
+        size_t n = len < dstLen - 1 ? len : dstLen - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return (int) len;
+}
+
+int nemparse_field_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen) {
+    const field_t *field = get_field(ctx, index);
+    if (field == NULL || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    return copy_string(get_fieldname(field), dst, dstLen);
+}
+
+static uint8_t get_header_network_type(const nemparse_ctx_t *ctx) {
+    return ctx->parse.data[COMMON_HEADER_NETWORK_OFFSET];
+}
+
+static int is_public_key_address(const field_t *field) {
+    return field->dataType == STI_ADDRESS && (field->id == NEM_PUBLICKEY_IT_REMOTE ||
+                                              field->id == NEM_PUBLICKEY_AM_COSIGNATORY);
+}
+
+// Formats a part of a field, the addresses of public keys with the hash backend
+static int format_value(const nemparse_ctx_t *ctx,
+                        const field_t *field,
+                        uint8_t chunk,
+                        char *dst,
+                        size_t dstLen) {
+    char value[MAX_FIELD_LEN];
+    if (ctx->hasBackend && is_public_key_address(field)) {
+        int error = nemparse_public_key_to_address(&ctx->backend,
+                                                   field->data,
+                                                   get_header_network_type(ctx),
+                                                   value,
+                                                   sizeof(value));
+        if (error != NEMPARSE_OK) {
+            return error;
+        }
+    } else {
+        format_field_chunk(field, chunk, value);
+    }
+    return copy_string(value, dst, dstLen);
+}
+
+int nemparse_format_field(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen) {
+    char value[MAX_FIELD_LEN];
+    const field_t *field = get_field(ctx, index);
+    if (field == NULL || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    if (get_field_chunk_count(field) == 1) {
+        return format_value(ctx, field, 0, dst, dstLen);
+    }
+    format_field(field, value);
+    return copy_string(value, dst, dstLen);
+}
+
+int nemparse_field_chunk_count(const nemparse_ctx_t *ctx, size_t index) {
+    const field_t *field = get_field(ctx, index);
+    if (field == NULL) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    return get_field_chunk_count(field);
+}
+
+int nemparse_format_field_chunk(const nemparse_ctx_t *ctx,
+                                size_t index,
+                                size_t chunk,
+                                char *dst,
+                                size_t dstLen) {
+    const field_t *field = get_field(ctx, index);
+    if (field == NULL || chunk >= get_field_chunk_count(field) || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    return format_value(ctx, field, chunk, dst, dstLen);
+}
+
+size_t nemparse_summary_pair_count(const nemparse_ctx_t *ctx) {
+    return get_summary_pair_count(&ctx->parse.result.summary);
+}
+
+int nemparse_summary_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen) {
+    if (ctx == NULL || index >= nemparse_summary_pair_count(ctx) || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    return copy_string(get_summary_name(index), dst, dstLen);
+}
+
+int nemparse_format_summary_pair(const nemparse_ctx_t *ctx,
+                                 size_t index,
+                                 char *dst,
+                                 size_t dstLen) {
+    char value[MAX_FIELD_LEN];
+    if (ctx == NULL || index >= nemparse_summary_pair_count(ctx) || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    format_summary_pair(&ctx->parse.result.summary, index, value);
+    return copy_string(value, dst, dstLen);
+}
+
+size_t nemparse_review_pair_count(const nemparse_ctx_t *ctx) {
+    return get_review_pair_count(&ctx->parse.result);
+}
+
+int nemparse_review_pair_name(const nemparse_ctx_t *ctx, size_t index, char *dst, size_t dstLen) {
+    char name[REVIEW_PAIR_NAME_LEN];
+    review_pair_t pair;
+    if (ctx == NULL || index >= nemparse_review_pair_count(ctx) || (dst == NULL && dstLen > 0) ||
+        !find_review_pair(&ctx->parse.result, index, &pair)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    format_review_pair_name(&pair, name, sizeof(name));
+    return copy_string(name, dst, dstLen);
+}
+
+int nemparse_format_review_pair(const nemparse_ctx_t *ctx,
+                                size_t index,
+                                char *dst,
+                                size_t dstLen) {
+    char value[MAX_FIELD_LEN];
+    review_pair_t pair;
+    if (ctx == NULL || index >= nemparse_review_pair_count(ctx) || (dst == NULL && dstLen > 0) ||
+        !find_review_pair(&ctx->parse.result, index, &pair)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    if (pair.field != NULL) {
+        return format_value(ctx, pair.field, pair.index, dst, dstLen);
+    }
+    format_review_pair_value(&ctx->parse.result, &pair, value);
+    return copy_string(value, dst, dstLen);
+}
+
+void nemparse_set_hash_backend(nemparse_ctx_t *ctx, const nemparse_hash_backend_t *backend) {
+    if (backend == NULL) {
+        memset(&ctx->backend, 0, sizeof(ctx->backend));
+        ctx->hasBackend = 0;
+    } else {
+        ctx->backend = *backend;
+        ctx->hasBackend = 1;
+    }
+}
+
+int nemparse_public_key_to_address(const nemparse_hash_backend_t *backend,
+                                   const uint8_t *publicKey,
+                                   uint8_t networkType,
+                                   char *dst,
+                                   size_t dstLen) {
+    char address[NEMPARSE_ADDRESS_LEN + 1];
+
+    if (backend == NULL || publicKey == NULL || (dst == NULL && dstLen > 0)) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+    // Same algorithm selection as the application, see get_algo()
+    const nem_address_hasher_t hasher = {
+        (networkType == MAINNET || networkType == TESTNET) ? backend->keccak256
+                                                           : backend->sha3_256,
+        backend->ripemd160,
+        backend->user};
+    if (hasher.sha3 == NULL || hasher.ripemd160 == NULL) {
+        return NEMPARSE_BAD_ARGUMENT;
+    }
+
+    switch (nem_hash_public_keys_to_addresses(&hasher,
+                                              publicKey,
+                                              1,
+                                              networkType,
+                                              address,
+                                              sizeof(address))) {
+        case NEM_ADDRESS_OK:
+            break;
+        case NEM_ADDRESS_HASH_FAILURE:
+            return NEMPARSE_HASH_FAILURE;
+        default:
+            return NEMPARSE_INVALID_DATA;
+    }
+    copy_string(address, dst, dstLen);
+    return NEMPARSE_OK;
+}
@@ -23,6 +23,13 @@
 #define CTR 0
 #endif
 
+// AES_TTABLE runs the CBC rounds on 32-bit words with lookup tables merging SubBytes, ShiftRows
+// and MixColumns (2 KB of tables). Their indexes depend on the key and data, as the S-box ones:
+// it is meant for the emulator and host builds deriving many keys.
+#ifndef AES_TTABLE
+#define AES_TTABLE 0
+#endif
+
 #define AES128         1
 #define AES_BLOCKLEN   16  // Block length in bytes - AES is 128b block only
 #define AES_KEYLEN     16  // Key length in bytes
@@ -30,6 +37,11 @@
 
 struct AES_ctx {
     uint8_t RoundKey[AES_keyExpSize];
+#if defined(AES_TTABLE) && (AES_TTABLE == 1)
+    // Round keys as big endian words, the decryption ones for the equivalent inverse cipher
+    uint32_t EncRoundKey[AES_keyExpSize / 4];
+    uint32_t DecRoundKey[AES_keyExpSize / 4];
+#endif
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
     uint8_t Iv[AES_BLOCKLEN];
 #endif
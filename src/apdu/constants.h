@@ -25,6 +25,8 @@
 #define INS_SIGN                  0x04
 #define INS_GET_REMOTE_ACCOUNT    0x05
 #define INS_GET_APP_CONFIGURATION 0x06
+#define INS_PARSE_TRANSACTION     0x07
+#define INS_GET_REMOTE_ACCOUNTS   0x08
 #define P1_CONFIRM                0x01
 #define P1_NON_CONFIRM            0x00
 #define P2_NO_CHAINCODE           0x00
@@ -33,5 +35,26 @@
 #define P1_MASK_MORE              0x80u
 #define P2_SECP256K1              0x40u
 #define P2_ED25519                0x80u
+#define P1_APP_VERSION            0x00
+#define P1_APP_CAPABILITIES       0x01
+#define P1_MORE_FIELDS            0x02
+#define P1_MORE_KEYS              0x02
+
+// Version of the APDU protocol reported by GET_APP_CONFIGURATION
+#define PROTOCOL_VERSION 0x01
+
+// Optional features reported by GET_APP_CONFIGURATION (bitmask)
+#define FEATURE_NONE             0x00000000u
+#define FEATURE_REMOTE_KEY_CACHE 0x00000001u  // GET_REMOTE_ACCOUNT keys kept in the session
+
+// Transaction types signed by the build, reported by GET_APP_CONFIGURATION (bitmask)
+#define TX_TYPE_MASK_TRANSFER                        0x0001u
+#define TX_TYPE_MASK_IMPORTANCE_TRANSFER             0x0002u
+#define TX_TYPE_MASK_MULTISIG_AGGREGATE_MODIFICATION 0x0004u
+#define TX_TYPE_MASK_MULTISIG_SIGNATURE              0x0008u
+#define TX_TYPE_MASK_MULTISIG                        0x0010u
+#define TX_TYPE_MASK_PROVISION_NAMESPACE             0x0020u
+#define TX_TYPE_MASK_MOSAIC_DEFINITION               0x0040u
+#define TX_TYPE_MASK_MOSAIC_SUPPLY_CHANGE            0x0080u
 
 #endif  // LEDGER_APP_NEM_CONSTANTS_H
@@ -24,6 +24,11 @@
 #include "sign_transaction.h"
 #include "get_remote_account.h"
 #include "get_app_configuration.h"
+#include "parse_transaction.h"
+#include "remote_key_cache.h"
+#ifdef HAVE_SWAP
+#include "swap.h"
+#endif
 
 static unsigned char lastINS = 0;
 
@@ -31,11 +36,20 @@ int handle_apdu(const command_t *cmd) {
     if (cmd->cla != CLA) {
         return io_send_sw(SWO_INVALID_CLA);
     }
+#ifdef HAVE_SWAP
+    // Started by the exchange application, only the transfer it validated is signed
+    if (G_called_from_swap && cmd->ins != INS_SIGN) {
+        return io_send_sw(SWO_INVALID_INS);
+    }
+#endif
 
     // Reset transaction context before starting to parse a new APDU message type.
     // This helps protect against "Instruction Change" attacks
     if (cmd->ins != lastINS) {
         reset_transaction_context();
+#ifdef HAVE_REMOTE_KEY_CACHE
+        remote_key_cache_wipe();
+#endif
     }
     lastINS = cmd->ins;
 
@@ -50,7 +64,13 @@ int handle_apdu(const command_t *cmd) {
             return handle_remote_private_key(cmd);
 
         case INS_GET_APP_CONFIGURATION:
-            return handle_app_configuration();
+            return handle_app_configuration(cmd);
+
+        case INS_PARSE_TRANSACTION:
+            return handle_parse_transaction(cmd);
+
+        case INS_GET_REMOTE_ACCOUNTS:
+            return handle_remote_private_keys(cmd);
 
         default:
             return io_send_sw(SWO_INVALID_INS);
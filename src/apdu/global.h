@@ -26,6 +26,9 @@ typedef enum {
     IDLE,
     WAITING_FOR_MORE,
     PENDING_REVIEW,
+    STREAMING_FIELDS,
+    PENDING_EXPORT,
+    STREAMING_KEYS,
 } sign_state_e;
 
 typedef struct {
@@ -18,17 +18,99 @@
 #include "get_app_configuration.h"
 #include "os.h"
 #include "io.h"
+#include "constants.h"
+#include "limitations.h"
+#include "tx_types.h"
+
+// Features advertised to the host (see FEATURE_* in constants.h)
+#ifdef HAVE_REMOTE_KEY_CACHE
+#define APP_FEATURES FEATURE_REMOTE_KEY_CACHE
+#else
+#define APP_FEATURES FEATURE_NONE
+#endif
+
+static const uint8_t SUPPORTED_INS[] = {
+    INS_GET_PUBLIC_KEY,
+    INS_SIGN,
+    INS_GET_REMOTE_ACCOUNT,
+    INS_GET_APP_CONFIGURATION,
+    INS_PARSE_TRANSACTION,
+    INS_GET_REMOTE_ACCOUNTS,
+};
+
+// Version (4) + protocol (1) + max tx (2) + max fields (1) + chunk (1) + features (4) + INS list
+// + transaction types (2)
+#define APP_CONFIGURATION_MAX_LEN (4 + 1 + 2 + 1 + 1 + 4 + 1 + sizeof(SUPPORTED_INS) + 2)
+
+// Transaction types selected by NEM_TX_TYPES (see TX_TYPE_MASK_* in constants.h)
+static uint16_t get_tx_types(void) {
+    uint16_t txTypes = 0;
+
+#ifdef HAVE_NEM_TXN_TRANSFER
+    txTypes |= TX_TYPE_MASK_TRANSFER;
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
+    txTypes |= TX_TYPE_MASK_IMPORTANCE_TRANSFER;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
+    txTypes |= TX_TYPE_MASK_MULTISIG_AGGREGATE_MODIFICATION;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
+    txTypes |= TX_TYPE_MASK_MULTISIG_SIGNATURE;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG
+    txTypes |= TX_TYPE_MASK_MULTISIG;
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
+    txTypes |= TX_TYPE_MASK_PROVISION_NAMESPACE;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
+    txTypes |= TX_TYPE_MASK_MOSAIC_DEFINITION;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
+    txTypes |= TX_TYPE_MASK_MOSAIC_SUPPLY_CHANGE;
+#endif
+    return txTypes;
+}
 
 /*
  * MAJOR_VERSION, MINOR_VERSION, PATCH_VERSION defined in Makefile
+ *
+ * P1 = P1_APP_VERSION returns the version only, P1 = P1_APP_CAPABILITIES appends the capability
+ * descriptor so that hosts do not have to hard-code the application limits. Other P1 values are
+ * rejected since version 0.0.13, they returned the version before.
  */
-int handle_app_configuration(void) {
-    unsigned char data[4];
-    data[0] = 0x00;
-    data[1] = MAJOR_VERSION;
-    data[2] = MINOR_VERSION;
-    data[3] = PATCH_VERSION;
-
-    buffer_t buffer = {data, 4, 0};
+int handle_app_configuration(const command_t *cmd) {
+    uint8_t data[APP_CONFIGURATION_MAX_LEN];
+    uint32_t tx = 0;
+
+    if ((cmd->p1 != P1_APP_VERSION) && (cmd->p1 != P1_APP_CAPABILITIES)) {
+        return io_send_sw(SWO_WRONG_P1_P2);
+    }
+
+    data[tx++] = 0x00;
+    data[tx++] = MAJOR_VERSION;
+    data[tx++] = MINOR_VERSION;
+    data[tx++] = PATCH_VERSION;
+
+    if (cmd->p1 == P1_APP_CAPABILITIES) {
+        data[tx++] = PROTOCOL_VERSION;
+        data[tx++] = (uint8_t) (MAX_RAW_TX >> 8);
+        data[tx++] = (uint8_t) MAX_RAW_TX;
+        data[tx++] = MAX_FIELD_COUNT;
+        data[tx++] = MAX_APDU_CHUNK_SIZE;
+        data[tx++] = (uint8_t) (APP_FEATURES >> 24);
+        data[tx++] = (uint8_t) (APP_FEATURES >> 16);
+        data[tx++] = (uint8_t) (APP_FEATURES >> 8);
+        data[tx++] = (uint8_t) APP_FEATURES;
+        data[tx++] = sizeof(SUPPORTED_INS);
+        memcpy(data + tx, SUPPORTED_INS, sizeof(SUPPORTED_INS));
+        tx += sizeof(SUPPORTED_INS);
+        uint16_t txTypes = get_tx_types();
+        data[tx++] = (uint8_t) (txTypes >> 8);
+        data[tx++] = (uint8_t) txTypes;
+    }
+
+    buffer_t buffer = {data, tx, 0};
     return io_send_response_buffer(&buffer, SWO_SUCCESS);
 }
@@ -19,7 +19,8 @@
 #define LEDGER_APP_NEM_GETAPPCONFIGURATION_H
 
 #include <stdint.h>
+#include "parser.h"
 
-int handle_app_configuration(void);
+int handle_app_configuration(const command_t *cmd);
 
 #endif  // LEDGER_APP_NEM_GETAPPCONFIGURATION_H
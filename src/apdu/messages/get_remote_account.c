@@ -21,6 +21,7 @@
 #include "nem_helpers.h"
 #include "idle_menu.h"
 #include "remote_ui.h"
+#include "remote_key_cache.h"
 
 typedef struct {
     uint8_t bip32PathLength;
@@ -30,6 +31,18 @@ typedef struct {
     uint8_t encrypt;
 } KeyData_t;
 
+// Keys of GET_REMOTE_ACCOUNTS sent per response, after its "more data" flag
+#define KEYS_PER_CHUNK ((MAX_APDU_CHUNK_SIZE - 1) / (1 + NEM_PRIVATE_KEY_LENGTH))
+
+typedef struct {
+    account_path_t accounts[MAX_REMOTE_ACCOUNTS];
+    uint8_t count;
+    // Index of the next key to send
+    uint8_t nextKey;
+} account_list_t;
+
+static account_list_t accountList;
+
 #if defined(IOCUSTOMCRYPT)
 uint8_t nem_remote_private_key[NEM_PRIVATE_KEY_LENGTH];
 #else
@@ -95,12 +108,20 @@ static int extract_parameters(const command_t *cmd, KeyData_t *keyData) {
 /**
  * Calculates and returns a public key which corresponds to bip32 path in 'keyData'
  *
+ * With HAVE_REMOTE_KEY_CACHE, a key already derived in the session is returned without
+ * derivation.
  */
 static int get_harvesting_key(KeyData_t *keyData) {
     uint8_t privateKeyData[NEM_RAW_PRIVATE_KEY_LENGTH];
     cx_ecfp_private_key_t privateKey;
     int error = SWO_PARAMETER_ERROR_NO_INFO;
 
+#ifdef HAVE_REMOTE_KEY_CACHE
+    if (remote_key_cache_get(keyData->bip32Path, keyData->bip32PathLength, nem_remote_private_key)) {
+        return SWO_SUCCESS;
+    }
+#endif
+
     // ensure a I/O channel is not timing out
     io_seproxyhal_io_heartbeat();
 
@@ -129,6 +150,11 @@ static int get_harvesting_key(KeyData_t *keyData) {
                                        nem_remote_private_key,
                                        sizeof(nem_remote_private_key));
     io_seproxyhal_io_heartbeat();
+#ifdef HAVE_REMOTE_KEY_CACHE
+    if (error == SWO_SUCCESS) {
+        remote_key_cache_put(keyData->bip32Path, keyData->bip32PathLength, nem_remote_private_key);
+    }
+#endif
 end:
     explicit_bzero(privateKeyData, sizeof(privateKeyData));
     explicit_bzero(&privateKey, sizeof(privateKey));
@@ -162,3 +188,144 @@ int handle_remote_private_key(const command_t *cmd) {
     }
     return error;
 }
+
+static void reset_account_list(void) {
+    explicit_bzero(&accountList, sizeof(accountList));
+    reset_transaction_context();
+}
+
+/**
+ * Derives and sends the next keys of the approved account list, each one encoded as the answer
+ * of GET_REMOTE_ACCOUNT, after a "more data" flag.
+ */
+static int send_keys_chunk(void) {
+    KeyData_t keyData = {0};
+    uint32_t tx = 1;
+
+    for (uint8_t i = 0; i < KEYS_PER_CHUNK && accountList.nextKey < accountList.count; i++) {
+        const account_path_t *account = &accountList.accounts[accountList.nextKey++];
+        keyData.bip32PathLength = account->length;
+        memcpy(keyData.bip32Path, account->path, sizeof(keyData.bip32Path));
+        keyData.encrypt = 1;
+
+        int error = get_harvesting_key(&keyData);
+        if (SWO_SUCCESS != error) {
+            explicit_bzero(G_io_apdu_buffer, tx);
+            reset_account_list();
+            return io_send_sw(error);
+        }
+        G_io_apdu_buffer[tx++] = NEM_PRIVATE_KEY_LENGTH;
+        memcpy(G_io_apdu_buffer + tx, nem_remote_private_key, NEM_PRIVATE_KEY_LENGTH);
+        tx += NEM_PRIVATE_KEY_LENGTH;
+        explicit_bzero(nem_remote_private_key, sizeof(nem_remote_private_key));
+    }
+
+    G_io_apdu_buffer[0] = accountList.nextKey < accountList.count ? 0x01 : 0x00;
+    if (G_io_apdu_buffer[0] == 0x00) {
+        // All the keys sent, the paths are not kept for a later request
+        reset_account_list();
+    }
+    return io_send_response_pointer(G_io_apdu_buffer, tx, SWO_SUCCESS);
+}
+
+static void on_privatekeys_confirmed(void) {
+    if (signState != PENDING_EXPORT) {
+        reset_account_list();
+        display_idle_menu();
+        return;
+    }
+    signState = STREAMING_KEYS;
+    if (send_keys_chunk() < 0) {
+        return;
+    }
+    display_remote_account_done(true);
+}
+
+static void on_privatekeys_rejected(void) {
+    reset_account_list();
+    io_send_sw(SWO_CONDITIONS_NOT_SATISFIED);
+    display_remote_account_done(false);
+}
+
+/**
+ * Appends the paths of a command to the account list: path length (1) || path (4 each), as many
+ * times as the command holds.
+ */
+static int read_account_paths(const command_t *cmd) {
+    const uint8_t *dataBuffer = cmd->data;
+    uint8_t remaining = cmd->lc;
+
+    if (remaining < 1) {
+        return SWO_WRONG_DATA_LENGTH;
+    }
+    while (remaining > 0) {
+        if (accountList.count == MAX_REMOTE_ACCOUNTS) {
+            return SWO_WRONG_DATA_LENGTH;
+        }
+        account_path_t *account = &accountList.accounts[accountList.count];
+        account->length = *(dataBuffer++);
+        remaining--;
+        if (remaining < 4 * account->length) {
+            return SWO_WRONG_DATA_LENGTH;
+        }
+        if ((account->length < 1) || (account->length > MAX_BIP32_PATH)) {
+            return SWO_INCORRECT_DATA;
+        }
+        for (int i = 0; i < account->length; i++) {
+            account->path[i] = U4BE(dataBuffer, 0);
+            dataBuffer += 4;
+        }
+        remaining -= 4 * account->length;
+        accountList.count++;
+    }
+    return SWO_SUCCESS;
+}
+
+static int handle_account_paths(const command_t *cmd) {
+    bool first = (cmd->p1 & P1_MASK_ORDER) == 0;
+
+    if (first) {
+        reset_account_list();
+    } else if (signState != WAITING_FOR_MORE) {
+        return SWO_INCORRECT_DATA;
+    }
+
+    int error = read_account_paths(cmd);
+    if (SWO_SUCCESS != error) {
+        return error;
+    }
+
+    if ((cmd->p1 & P1_MASK_MORE) != 0) {
+        // Reply to sender with status OK
+        signState = WAITING_FOR_MORE;
+        io_send_sw(SWO_SUCCESS);
+        return 0;
+    }
+    // All the paths received, the keys are derived once the list is approved
+    signState = PENDING_EXPORT;
+    display_remote_accounts_confirmation_ui(accountList.accounts,
+                                            accountList.count,
+                                            on_privatekeys_confirmed,
+                                            on_privatekeys_rejected);
+    return 0;
+}
+
+int handle_remote_private_keys(const command_t *cmd) {
+    if (cmd->p1 == P1_MORE_KEYS) {
+        if (signState != STREAMING_KEYS) {
+            return io_send_sw(SWO_INCORRECT_DATA);
+        }
+        return send_keys_chunk();
+    }
+    if ((cmd->p1 & ~(P1_MASK_ORDER | P1_MASK_MORE)) != 0) {
+        reset_account_list();
+        return io_send_sw(SWO_WRONG_P1_P2);
+    }
+
+    int error = handle_account_paths(cmd);
+    if (error > 0) {
+        reset_account_list();
+        return io_send_sw(error);
+    }
+    return error;
+}
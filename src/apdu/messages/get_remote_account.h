@@ -22,5 +22,7 @@
 #include "parser.h"
 
 int handle_remote_private_key(const command_t *cmd);
+// Exports the keys of a list of accounts, approved on a single review
+int handle_remote_private_keys(const command_t *cmd);
 
 #endif  // LEDGER_APP_NEM_GETREMOTEACCOUNT_H
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *    NEM Wallet
+ *    (c) 2020 Ledger
+ *    (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "parse_transaction.h"
+#include "os.h"
+#include "io.h"
+#include "global.h"
+#include "constants.h"
+#include "fields.h"
+#include "app_format.h"
+#include "sign_transaction.h"
+#include "heartbeat.h"
+
+// TLV tags of a review pair record: tag (1) || length (2, big endian) || value
+#define TAG_FIELD_ID    0x01
+#define TAG_FIELD_TYPE  0x02
+#define TAG_FIELD_NAME  0x03
+#define TAG_FIELD_VALUE 0x04
+
+#define TLV_HEADER_LEN 3
+// Record up to the value: id, type and name TLVs, then the header of the value TLV
+#define RECORD_HEADER_MAX_LEN \
+    (2 * (TLV_HEADER_LEN + 1) + 2 * TLV_HEADER_LEN + REVIEW_PAIR_NAME_LEN)
+// Id and type of the summary pairs, not used by the fields
+#define SUMMARY_FIELD_ID   0x00
+#define SUMMARY_FIELD_TYPE 0x00
+
+// Each response is a "more data" flag followed by a slice of the record stream
+#define FIELDS_CHUNK_LEN MAX_APDU_CHUNK_SIZE
+
+// Position in the record stream. The records are not kept: the one being sent is built again
+// from parseContext.result for each response.
+typedef struct {
+    // Number of review pairs of the transaction
+    uint8_t pairCount;
+    // Record being sent: 0 is the number of pairs, then one record per pair
+    uint16_t record;
+    // Bytes of the record already sent
+    uint16_t offset;
+} field_stream_t;
+
+static field_stream_t stream;
+
+static uint16_t write_tlv_header(uint8_t *dst, uint8_t tag, uint16_t length) {
+    dst[0] = tag;
+    dst[1] = (uint8_t) (length >> 8);
+    dst[2] = (uint8_t) length;
+    return TLV_HEADER_LEN;
+}
+
+/**
+ * Builds a record of the stream. The record of a review pair is serialized as it is displayed on
+ * the review screens: id, type, name and value, each of them encoded as a TLV. The summary pairs
+ * have the id and type 0, the parts of a message have the id and type of the message.
+ *
+ * @param header set to the record up to the value, RECORD_HEADER_MAX_LEN bytes
+ * @param value set to the value of the pair, MAX_FIELD_LEN bytes
+ * @return length of the header
+ */
+static uint16_t build_record(uint16_t record, uint8_t *header, char *value) {
+    if (record == 0) {
+        header[0] = stream.pairCount;
+        value[0] = '\0';
+        return 1;
+    }
+    review_pair_t pair;
+    if (!find_review_pair(&parseContext.result, record - 1, &pair)) {
+        value[0] = '\0';
+        return 0;
+    }
+
+    uint16_t tx = 0;
+    tx += write_tlv_header(header + tx, TAG_FIELD_ID, 1);
+    header[tx++] = pair.field != NULL ? pair.field->id : SUMMARY_FIELD_ID;
+    tx += write_tlv_header(header + tx, TAG_FIELD_TYPE, 1);
+    header[tx++] = pair.field != NULL ? pair.field->dataType : SUMMARY_FIELD_TYPE;
+    // The name is written after its TLV header, once its length is known
+    uint16_t nameLen = format_review_pair_name(&pair,
+                                               (char *) header + tx + TLV_HEADER_LEN,
+                                               REVIEW_PAIR_NAME_LEN);
+    tx += write_tlv_header(header + tx, TAG_FIELD_NAME, nameLen);
+    tx += nameLen;
+    // Formatted while the APDU is processed, unlike the review pages
+    heartbeat_consume(pair.field != NULL ? get_field_cost(pair.field) : HEARTBEAT_COST_FIELD);
+    format_review_pair_value(&parseContext.result, &pair, value);
+    tx += write_tlv_header(header + tx, TAG_FIELD_VALUE, strnlen(value, MAX_FIELD_LEN));
+    return tx;
+}
+
+// Copies the part of src after *offset that fits in the room left, returns the bytes copied
+static uint16_t copy_part(const uint8_t *src,
+                          uint16_t srcLen,
+                          uint16_t *offset,
+                          uint8_t *dst,
+                          uint16_t room) {
+    if (*offset >= srcLen) {
+        *offset -= srcLen;
+        return 0;
+    }
+    uint16_t len = srcLen - *offset;
+    if (len > room) {
+        len = room;
+    }
+    memcpy(dst, src + *offset, len);
+    *offset = 0;
+    return len;
+}
+
+static int send_fields_chunk(void) {
+    uint8_t header[RECORD_HEADER_MAX_LEN];
+    char value[MAX_FIELD_LEN];
+    uint16_t tx = 1;
+
+    while (tx < FIELDS_CHUNK_LEN && stream.record <= stream.pairCount) {
+        uint16_t headerLen = build_record(stream.record, header, value);
+        uint16_t valueLen = strnlen(value, MAX_FIELD_LEN);
+        uint16_t offset = stream.offset;
+        uint16_t len = copy_part(header,
+                                 headerLen,
+                                 &offset,
+                                 G_io_apdu_buffer + tx,
+                                 FIELDS_CHUNK_LEN - tx);
+        len += copy_part((const uint8_t *) value,
+                         valueLen,
+                         &offset,
+                         G_io_apdu_buffer + tx + len,
+                         FIELDS_CHUNK_LEN - tx - len);
+        tx += len;
+        stream.offset += len;
+        if (stream.offset == headerLen + valueLen) {
+            stream.record++;
+            stream.offset = 0;
+        }
+    }
+
+    G_io_apdu_buffer[0] = stream.record <= stream.pairCount ? 0x01 : 0x00;
+    if (G_io_apdu_buffer[0] == 0x00) {
+        // Whole field list sent, nothing is kept for a later request
+        reset_transaction_context();
+    }
+    return io_send_response_pointer(G_io_apdu_buffer, tx, SWO_SUCCESS);
+}
+
+static int on_transaction_parsed(void) {
+    signState = STREAMING_FIELDS;
+
+    // The stream starts with the number of review pairs, sent as a one byte record
+    explicit_bzero(&stream, sizeof(stream));
+    stream.pairCount = get_review_pair_count(&parseContext.result);
+
+    return send_fields_chunk() < 0 ? -1 : 0;
+}
+
+int handle_parse_transaction(const command_t *cmd) {
+    if (cmd->p1 == P1_MORE_FIELDS) {
+        if (signState != STREAMING_FIELDS) {
+            return io_send_sw(SWO_INCORRECT_DATA);
+        }
+        return send_fields_chunk();
+    }
+
+    if (signState == STREAMING_FIELDS) {
+        // A new transaction is sent before the previous field list was fully read
+        reset_transaction_context();
+    }
+
+    int error = handle_transaction_chunk(cmd, on_transaction_parsed);
+    if (error > 0) {
+        reset_transaction_context();
+        return io_send_sw(error);
+    }
+    return error;
+}
@@ -24,6 +24,10 @@
 #include "idle_menu.h"
 #include "review_menu.h"
 #include "transaction.h"
+#ifdef HAVE_SWAP
+#include "swap.h"
+#include "handle_swap.h"
+#endif
 
 #define PREFIX_LENGTH            4
 #define ED25519_SIGNATURE_LENGTH 64
@@ -70,17 +74,35 @@ void sign_transaction(void) {
                                     signature,
                                     IO_APDU_BUFFER_SIZE));
 
+end:
+    explicit_bzero(privateKeyData, sizeof(privateKeyData));
+    explicit_bzero(&privateKey, sizeof(privateKey));
+    // Always reset transaction context after a transaction has been signed
+    reset_transaction_context();
+    if (error != CX_OK) {
+#ifdef HAVE_SWAP
+        if (G_called_from_swap) {
+            // The exchange application waits for a response to be resumed
+            io_send_sw(SWO_PARAMETER_ERROR_NO_INFO);
+        }
+#endif
+        return;
+    }
+
     // send response
     response.ptr = signature;
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        // G_swap_response_ready is set: the I/O layer finalizes the swap with the response and
+        // returns to the exchange application, which displays the outcome itself
+        io_send_response_buffer(&response, SWO_SUCCESS);
+        return;
+    }
+#endif
     io_send_response_buffer(&response, SWO_SUCCESS);
     explicit_bzero(signature, sizeof(signature));
 
     display_review_done(true);
-end:
-    explicit_bzero(privateKeyData, sizeof(privateKeyData));
-    explicit_bzero(&privateKey, sizeof(privateKey));
-    // Always reset transaction context after a transaction has been signed
-    reset_transaction_context();
 }
 
 void reject_transaction(void) {
@@ -105,7 +127,7 @@ bool hasMore(uint8_t p1) {
     return (p1 & P1_MASK_MORE) != 0;
 }
 
-int handle_packet_content(const command_t *cmd) {
+int handle_packet_content(const command_t *cmd, transaction_parsed_t onParsed) {
     uint16_t totalLength = PREFIX_LENGTH + parseContext.length + cmd->lc;
     if (totalLength > MAX_RAW_TX) {
         // Abort if the user is trying to sign a too large transaction
@@ -124,21 +146,20 @@ int handle_packet_content(const command_t *cmd) {
         // No more data to receive, finish up and present transaction to user
         signState = PENDING_REVIEW;
 
-        transactionContext.rawTxLength = parseContext.length;
-
         // Try to parse the transaction. If the parsing fails, throw an exception
         // to cause the processing to abort and the transaction context to be reset.
         if (parse_txn_context(&parseContext)) {
             // Mask real cause behind generic error (INCORRECT_DATA)
             return SWO_INCORRECT_DATA;
         }
+        transactionContext.rawTxLength = parseContext.signLength;
 
-        review_transaction(&parseContext.result, sign_transaction, reject_transaction);
+        return onParsed();
     }
     return 0;
 }
 
-int handle_first_packet(command_t *cmd) {
+int handle_first_packet(command_t *cmd, transaction_parsed_t onParsed) {
     int error = SWO_PARAMETER_ERROR_NO_INFO;
     uint32_t i;
     if (!isFirst(cmd->p1)) {
@@ -178,25 +199,49 @@ int handle_first_packet(command_t *cmd) {
     } else {
         transactionContext.algo = CX_SHA3;
     }
-    return handle_packet_content(cmd);
+    return handle_packet_content(cmd, onParsed);
 }
 
-int handle_subsequent_packet(const command_t *cmd) {
+int handle_subsequent_packet(const command_t *cmd, transaction_parsed_t onParsed) {
     if (isFirst(cmd->p1)) {
         return SWO_INCORRECT_DATA;
     }
 
-    return handle_packet_content(cmd);
+    return handle_packet_content(cmd, onParsed);
 }
 
-int handle_sign(const command_t *cmd) {
+int handle_transaction_chunk(const command_t *cmd, transaction_parsed_t onParsed) {
     switch (signState) {
         case IDLE:
-            return handle_first_packet((command_t *) cmd);
+            return handle_first_packet((command_t *) cmd, onParsed);
         case WAITING_FOR_MORE:
-            return handle_subsequent_packet(cmd);
+            return handle_subsequent_packet(cmd, onParsed);
         default:
             return SWO_INCORRECT_DATA;
     }
     return 0;
 }
+
+static int on_transaction_parsed(void) {
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        // Reviewed in the exchange application
+        return handle_swap_sign_transaction();
+    }
+#endif
+    review_transaction(&parseContext.result, sign_transaction, reject_transaction);
+    return 0;
+}
+
+int handle_sign(const command_t *cmd) {
+    int error = handle_transaction_chunk(cmd, on_transaction_parsed);
+#ifdef HAVE_SWAP
+    if (G_called_from_swap && error > 0) {
+        // The exchange application is resumed with the first error
+        G_swap_response_ready = true;
+        reset_transaction_context();
+        return io_send_sw(error);
+    }
+#endif
+    return error;
+}
@@ -24,6 +24,12 @@
 
 extern parse_context_t parseContext;
 
+// Called once the last chunk of a transaction has been received and parsed
+typedef int (*transaction_parsed_t)(void);
+
+int handle_transaction_chunk(const command_t *cmd, transaction_parsed_t onParsed);
+// Signs the parsed transaction with the key of its path and sends the signature
+void sign_transaction(void);
 int handle_sign(const command_t *cmd);
 
 #endif  // LEDGER_APP_NEM_SIGNTRANSACTION_H
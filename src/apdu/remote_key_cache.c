@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifdef HAVE_REMOTE_KEY_CACHE
+
+#include <string.h>
+#include "remote_key_cache.h"
+
+typedef struct {
+    bool used;
+    uint8_t bip32PathLength;
+    uint32_t bip32Path[MAX_BIP32_PATH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH];
+} cached_key_t;
+
+static cached_key_t cache[REMOTE_KEY_CACHE_SIZE];
+// Entry of the next key stored when the cache is full, the oldest one
+static uint8_t oldest;
+
+static cached_key_t *find(const uint32_t *bip32Path, uint8_t bip32PathLength) {
+    for (uint8_t i = 0; i < REMOTE_KEY_CACHE_SIZE; i++) {
+        cached_key_t *entry = &cache[i];
+        if (entry->used && entry->bip32PathLength == bip32PathLength &&
+            memcmp(entry->bip32Path, bip32Path, bip32PathLength * sizeof(uint32_t)) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool remote_key_cache_get(const uint32_t *bip32Path, uint8_t bip32PathLength, uint8_t *key) {
+    const cached_key_t *entry = find(bip32Path, bip32PathLength);
+    if (entry == NULL) {
+        return false;
+    }
+    memcpy(key, entry->key, NEM_PRIVATE_KEY_LENGTH);
+    return true;
+}
+
+void remote_key_cache_put(const uint32_t *bip32Path, uint8_t bip32PathLength, const uint8_t *key) {
+    if (bip32PathLength > MAX_BIP32_PATH) {
+        return;
+    }
+    cached_key_t *entry = find(bip32Path, bip32PathLength);
+    if (entry == NULL) {
+        entry = &cache[oldest];
+        oldest = (oldest + 1) % REMOTE_KEY_CACHE_SIZE;
+        explicit_bzero(entry, sizeof(cached_key_t));
+        entry->used = true;
+        entry->bip32PathLength = bip32PathLength;
+        memcpy(entry->bip32Path, bip32Path, bip32PathLength * sizeof(uint32_t));
+    }
+    memcpy(entry->key, key, NEM_PRIVATE_KEY_LENGTH);
+}
+
+void remote_key_cache_wipe(void) {
+    explicit_bzero(cache, sizeof(cache));
+    oldest = 0;
+}
+
+#endif  // HAVE_REMOTE_KEY_CACHE
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_REMOTE_KEY_CACHE_H
+#define LEDGER_APP_NEM_REMOTE_KEY_CACHE_H
+
+#ifdef HAVE_REMOTE_KEY_CACHE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "limitations.h"
+#include "nem_helpers.h"
+
+// Remote keys kept at once, the oldest one is replaced by a new key when the cache is full
+#define REMOTE_KEY_CACHE_SIZE 8
+
+/**
+ * Looks up the delegated harvesting key derived from a path during the session. The key only
+ * depends on the path: GET_REMOTE_ACCOUNT always derives it with encryption and no confirmation
+ * option.
+ *
+ * @param bip32Path derivation path of the account
+ * @param bip32PathLength number of path elements
+ * @param key set to the NEM_PRIVATE_KEY_LENGTH bytes of the key when found
+ * @return whether the key is in the cache
+ */
+bool remote_key_cache_get(const uint32_t *bip32Path, uint8_t bip32PathLength, uint8_t *key);
+
+/**
+ * Keeps a delegated harvesting key until the cache is wiped.
+ *
+ * @param bip32Path derivation path of the account
+ * @param bip32PathLength number of path elements, up to MAX_BIP32_PATH
+ * @param key NEM_PRIVATE_KEY_LENGTH bytes of the key
+ */
+void remote_key_cache_put(const uint32_t *bip32Path, uint8_t bip32PathLength, const uint8_t *key);
+
+/**
+ * Erases all the keys, when the session ends: on application exit and when a command of another
+ * instruction is received.
+ */
+void remote_key_cache_wipe(void);
+
+#endif  // HAVE_REMOTE_KEY_CACHE
+
+#endif  // LEDGER_APP_NEM_REMOTE_KEY_CACHE_H
@@ -21,10 +21,23 @@
 // Hardware independent limits
 #define MAX_BIP32_PATH    5
 #define MAX_FIELDNAME_LEN 50
+// Accounts of a GET_REMOTE_ACCOUNTS request, listed on a single review
+#define MAX_REMOTE_ACCOUNTS 64
+
+// The transaction and field limits can be raised by the deployment profile of a lean build (see
+// NEM_TX_TYPES in the Makefile). GET_APP_CONFIGURATION reports them on 1 and 2 bytes.
+#ifndef MAX_FIELD_COUNT
+#define MAX_FIELD_COUNT 60
+#endif
+#ifndef MAX_RAW_TX
+#define MAX_RAW_TX 10000
+#endif
+#if MAX_FIELD_COUNT > 0xFF || MAX_RAW_TX > 0xFFFF
+#error "MAX_FIELD_COUNT or MAX_RAW_TX exceeds what GET_APP_CONFIGURATION reports"
+#endif
 
-#define MAX_FIELD_COUNT        60
 #define MAX_FIELD_LEN          1024
-#define MAX_RAW_TX             10000
+#define MAX_APDU_CHUNK_SIZE    255
 #define DISPLAY_SEGMENTED_ADDR false
 
 #endif  // LEDGER_APP_NEM_LIMITATIONS_H
@@ -25,6 +25,11 @@
 #include "address_ui.h"
 #include "io.h"
 #include "parser.h"
+#include "remote_key_cache.h"
+#ifdef HAVE_SWAP
+#include "swap.h"
+#include "review_menu.h"
+#endif
 
 void app_main(void) {
     // Length of APDU command received in G_io_apdu_buffer
@@ -35,14 +40,22 @@ void app_main(void) {
     io_init();
 
     reset_transaction_context();
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        display_swap_signing();
+    } else {
+        display_idle_menu();
+    }
+#else
     display_idle_menu();
+#endif
 
     while (true) {
         // Receive command bytes in G_io_apdu_buffer
         input_len = io_recv_command();
         if (input_len < 0) {
             PRINTF("=> io_recv_command failure\n");
-            return;
+            break;
         }
 
         // Parse APDU command from G_io_apdu_buffer
@@ -63,7 +76,11 @@ void app_main(void) {
 
         if (handle_apdu(&cmd) < 0) {
             PRINTF("=> handle_apdu returned an error\n");
-            return;
+            break;
         }
     }
+
+#ifdef HAVE_REMOTE_KEY_CACHE
+    remote_key_cache_wipe();
+#endif
 }
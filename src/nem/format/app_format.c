@@ -26,6 +26,8 @@
 #include "global.h"
 #include "common.h"
 #include "base32.h"
+#include "heartbeat.h"
+#include "tx_types.h"
 
 typedef void (*field_formatter_t)(const field_t *field, char *dst);
 
@@ -36,29 +38,50 @@ static void uint8_formatter(const field_t *field, char *dst) {
 
 static void uint32_formatter(const field_t *field, char *dst) {
     uint32_t value = U4LE(field->data, 0);
-    if (field->id == NEM_UINT32_MOSAIC_COUNT) {
-        SNPRINTF(dst, "Found %d", value);
-    } else if (field->id == NEM_UINT32_TRANSACTION_TYPE ||
-               field->id == NEM_UINT32_INNER_TRANSACTION_TYPE ||
-               field->id == NEM_UINT32_DETAIL_TRANSACTION_TYPE) {
+    if (field->id == NEM_UINT32_TRANSACTION_TYPE ||
+        field->id == NEM_UINT32_INNER_TRANSACTION_TYPE ||
+        field->id == NEM_UINT32_DETAIL_TRANSACTION_TYPE) {
         switch (value) {
+#ifdef HAVE_NEM_TXN_TRANSFER
             CASE_FIELDVALUE(NEM_TXN_TRANSFER, "Transfer TX")
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
             CASE_FIELDVALUE(NEM_TXN_IMPORTANCE_TRANSFER, "Importance Transfer TX")
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
             CASE_FIELDVALUE(NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION, "Modify Multisig Aggregate TX")
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
             CASE_FIELDVALUE(NEM_TXN_MULTISIG_SIGNATURE, "Multi Sig. TX")
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG
             CASE_FIELDVALUE(NEM_TXN_MULTISIG, "Multisig TX")
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
             CASE_FIELDVALUE(NEM_TXN_PROVISION_NAMESPACE, "Provision Namespace TX")
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
             CASE_FIELDVALUE(NEM_TXN_MOSAIC_DEFINITION, "Mosaic Definition TX")
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
             CASE_FIELDVALUE(NEM_TXN_MOSAIC_SUPPLY_CHANGE, "Mosaic Supply Change")
+#endif
             default:
                 SNPRINTF(dst, "%s", "Unknown");
         }
+#ifdef HAVE_NEM_TXN_TRANSFER
+    } else if (field->id == NEM_UINT32_MOSAIC_COUNT) {
+        SNPRINTF(dst, "Found %d", value);
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
     } else if (field->id == NEM_UINT32_IT_MODE) {
         if (value == 1) {
             SNPRINTF(dst, "%s", "Activate");
         } else if (value == 2) {
             SNPRINTF(dst, "%s", "Deactivate");
         }
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
     } else if (field->id == NEM_UINT32_AM_MODICATION_TYPE) {
         if (value == 1) {
             SNPRINTF(dst, "%s", "Add cosignatory");
@@ -71,12 +94,15 @@ static void uint32_formatter(const field_t *field, char *dst) {
         } else {
             SNPRINTF(dst, "%d", value);
         }
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
     } else if (field->id == NEM_UINT32_LEVY_FEE_TYPE) {
         if (value == 1) {
             SNPRINTF(dst, "%s", "Absolute");
         } else {
             SNPRINTF(dst, "%s", "Percentile");
         }
+#endif
     } else {
         SNPRINTF(dst, "%d", value);
     }
@@ -87,9 +113,11 @@ static void uint16_formatter(const field_t *field, char *dst) {
     SNPRINTF(dst, "%x", value);
 }
 
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
 static void hash_formatter(const field_t *field, char *dst) {
     snprintf_hex(dst, MAX_FIELD_LEN, field->data, field->length, 0);
 }
+#endif
 
 static void uint64_formatter(const field_t *field, char *dst) {
     if (field->id == NEM_UINT64_DURATION) {
@@ -108,6 +136,8 @@ static void uint64_formatter(const field_t *field, char *dst) {
 }
 
 static void address_formatter(const field_t *field, char *dst) {
+#if defined(HAVE_NEM_TXN_IMPORTANCE_TRANSFER) || \
+    defined(HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION)
     if (field->id == NEM_PUBLICKEY_IT_REMOTE || field->id == NEM_PUBLICKEY_AM_COSIGNATORY) {
 #ifndef FUZZ
         nem_public_key_to_address(field->data,
@@ -116,29 +146,49 @@ static void address_formatter(const field_t *field, char *dst) {
                                   dst,
                                   MAX_FIELD_LEN);
 #endif
-    } else {
-        snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, field->length);
+        return;
     }
+#endif
+    snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, field->length);
 }
 
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE)
 static void mosaic_formatter(const field_t *field, char *dst) {
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
     if (field->id == NEM_MOSAIC_CREATE_SUPPLY_DELTA ||
         field->id == NEM_MOSAIC_DELETE_SUPPLY_DELTA) {
         snprintf_number(dst, MAX_FIELD_LEN, U8LE(field->data, 0));
-    } else {
-        // data = mosaic name + amount
-        snprintf_number(dst, MAX_FIELD_LEN, U8LE(field->data + field->length - 8, 0));
+        return;
     }
+#endif
+    // data = mosaic name + amount
+    snprintf_number(dst, MAX_FIELD_LEN, U8LE(field->data + field->length - 8, 0));
 }
+#endif
 
 static void nem_formatter(const field_t *field, char *dst) {
+#ifdef HAVE_NEM_TXN_TRANSFER
+    // Multiplier of the mosaic quantities, in millionths
+    if (field->id == NEM_UINT64_MULTIPLIER) {
+        snprintf_token(dst, MAX_FIELD_LEN, U8LE(field->data, 0), 6, NULL);
+        return;
+    }
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
     if (field->id == NEM_UINT64_LEVY_FEE) {
         snprintf_token(dst, MAX_FIELD_LEN, U8LE(field->data, 0), 6, (char *) "micro");
-    } else {
-        snprintf_token(dst, MAX_FIELD_LEN, U8LE(field->data, 0), 6, (char *) "XEM");
+        return;
     }
+#endif
+    snprintf_token(dst, MAX_FIELD_LEN, U8LE(field->data, 0), 6, (char *) "XEM");
 }
 
+// Hex messages start with 0xFE and are shown with two characters per byte
+static bool is_hex_message(const field_t *field) {
+    return field->length > 0 && field->data[0] == 0xFE;
+}
+
+#ifdef HAVE_NEM_TXN_TRANSFER
 static void msg_formatter(const field_t *field, char *dst) {
     if (field->length == 0) {
         if (field->id == NEM_STR_ENC_MESSAGE) {
@@ -147,12 +197,14 @@ static void msg_formatter(const field_t *field, char *dst) {
             SNPRINTF(dst, "%s", "<empty msg>");
         }
     } else {
-        if (field->data[0] == 0xFE) {  // hex message
-            if (field->length - 1 >= MAX_FIELD_LEN) {
-                snprintf_hex2ascii(dst, MAX_FIELD_LEN, &field->data[1], MAX_FIELD_LEN - 1);
-            } else {
-                snprintf_hex2ascii(dst, MAX_FIELD_LEN, &field->data[1], field->length - 1);
-            }
+        if (is_hex_message(field)) {
+            // Truncated to the bytes whose characters fit in the buffer
+            uint32_t maxBytes = (MAX_FIELD_LEN - 1) / 2;
+            uint32_t length = field->length - 1;
+            snprintf_hex2ascii(dst,
+                               MAX_FIELD_LEN,
+                               &field->data[1],
+                               length < maxBytes ? length : maxBytes);
         } else {
             if (field->length >= MAX_FIELD_LEN) {
                 snprintf_ascii(dst, 0, MAX_FIELD_LEN, &field->data[0], MAX_FIELD_LEN - 1);
@@ -162,13 +214,23 @@ static void msg_formatter(const field_t *field, char *dst) {
         }
     }
 }
+#endif
 
 static void string_formatter(const field_t *field, char *dst) {
+#ifdef HAVE_NEM_TXN_TRANSFER
     if (field->id == NEM_MOSAIC_UNKNOWN_TYPE) {
         SNPRINTF(dst, "%s", "Divisibility and levy cannot be shown");
-    } else if (field->id == NEM_STR_ROOT_NAMESPACE) {
+        return;
+    }
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
+    if (field->id == NEM_STR_ROOT_NAMESPACE) {
         SNPRINTF(dst, "%s", "namespace");
-    } else if (field->id == NEM_STR_LEVY_MOSAIC || field->id == NEM_STR_TRANSFER_MOSAIC) {
+        return;
+    }
+#endif
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_MOSAIC_DEFINITION)
+    if (field->id == NEM_STR_LEVY_MOSAIC || field->id == NEM_STR_TRANSFER_MOSAIC) {
         // Show levy mosaic: namespace:mosaic name
         // data=len namespace id, namespaceId, len mosaic name, mosaic name
 
@@ -189,35 +251,45 @@ static void string_formatter(const field_t *field, char *dst) {
                        MAX_FIELD_LEN,
                        field->data + nsid_len + 2 * sizeof(uint32_t),
                        ms_len);
+        return;
+    }
+#endif
+    if (field->length > MAX_FIELD_LEN) {
+        snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, MAX_FIELD_LEN - 1);
     } else {
-        if (field->length > MAX_FIELD_LEN) {
-            snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, MAX_FIELD_LEN - 1);
-        } else {
-            snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, field->length);
-        }
+        snprintf_ascii(dst, 0, MAX_FIELD_LEN, field->data, field->length);
     }
 }
 
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
 static void property_formatter(const field_t *field, char *dst) {
     // field->data = len name, name, len value, value (ignore field->length)
     // Length of the property name
     uint32_t nameLen = U4LE(field->data, 0);
-    // Length of the property name
+    // Length of the property value
     uint32_t valueLen = U4LE(field->data + sizeof(uint32_t) + nameLen, 0);
-    if (valueLen > MAX_FIELD_LEN) {
-        snprintf_ascii(dst,
-                       0,
-                       MAX_FIELD_LEN,
-                       field->data + nameLen + 2 * sizeof(uint32_t),
-                       MAX_FIELD_LEN - 1);
-    } else {
-        snprintf_ascii(dst,
-                       0,
-                       MAX_FIELD_LEN,
-                       field->data + nameLen + 2 * sizeof(uint32_t),
-                       valueLen);
+    uint32_t pos = 0;
+    if (!is_known_property(field)) {
+        // The name of the pair does not show it, it comes before the value
+        int len = snprintf_ascii(dst,
+                                 0,
+                                 MAX_FIELDNAME_LEN,
+                                 field->data + sizeof(uint32_t),
+                                 nameLen < MAX_FIELDNAME_LEN ? nameLen : MAX_FIELDNAME_LEN - 1);
+        if (len > 0) {
+            pos = len;
+            dst[pos++] = ':';
+            dst[pos++] = ' ';
+        }
     }
+    uint32_t maxValueLen = MAX_FIELD_LEN - 1 - pos;
+    snprintf_ascii(dst,
+                   pos,
+                   MAX_FIELD_LEN,
+                   field->data + nameLen + 2 * sizeof(uint32_t),
+                   valueLen < maxValueLen ? valueLen : maxValueLen);
 }
+#endif
 
 static field_formatter_t get_formatter(const field_t *field) {
     switch (field->dataType) {
@@ -229,20 +301,28 @@ static field_formatter_t get_formatter(const field_t *field) {
             return uint32_formatter;
         case STI_UINT64:
             return uint64_formatter;
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
         case STI_HASH256:
             return hash_formatter;
+#endif
         case STI_ADDRESS:
             return address_formatter;
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE)
         case STI_MOSAIC_CURRENCY:
             return mosaic_formatter;
+#endif
         case STI_NEM:
             return nem_formatter;
+#ifdef HAVE_NEM_TXN_TRANSFER
         case STI_MESSAGE:
             return msg_formatter;
+#endif
         case STI_STR:
             return string_formatter;
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
         case STI_PROPERTY:
             return property_formatter;
+#endif
         default:
             return NULL;
     }
@@ -261,3 +341,153 @@ void format_field(const field_t *field, char *dst) {
         dst[0] = ' ';
     }
 }
+
+// Bytes of the message payload shown per review pair
+static uint16_t message_chunk_bytes(const field_t *field) {
+    return is_hex_message(field) ? MESSAGE_CHUNK_LEN / 2 : MESSAGE_CHUNK_LEN;
+}
+
+uint32_t get_field_cost(const field_t *field) {
+    if (field->dataType == STI_ADDRESS &&
+        (field->id == NEM_PUBLICKEY_IT_REMOTE || field->id == NEM_PUBLICKEY_AM_COSIGNATORY)) {
+        return HEARTBEAT_COST_ADDRESS;
+    }
+    return HEARTBEAT_COST_FIELD;
+}
+
+uint8_t get_field_chunk_count(const field_t *field) {
+    if (field->dataType != STI_MESSAGE || field->length == 0) {
+        return 1;
+    }
+    uint32_t payloadLength = is_hex_message(field) ? field->length - 1 : field->length;
+    uint16_t chunkBytes = message_chunk_bytes(field);
+    uint32_t count = (payloadLength + chunkBytes - 1) / chunkBytes;
+    return count > 1 ? count : 1;
+}
+
+void format_field_chunk(const field_t *field, uint8_t chunk, char *dst) {
+    uint8_t count = get_field_chunk_count(field);
+    if (count == 1) {
+        format_field(field, dst);
+        return;
+    }
+    memset(dst, 0, MAX_FIELD_LEN);
+    if (chunk < count) {
+        bool hex = is_hex_message(field);
+        const uint8_t *payload = field->data + (hex ? 1 : 0);
+        uint32_t payloadLength = field->length - (hex ? 1 : 0);
+        uint32_t offset = (uint32_t) chunk * message_chunk_bytes(field);
+        uint32_t length = payloadLength - offset;
+        if (length > message_chunk_bytes(field)) {
+            length = message_chunk_bytes(field);
+        }
+        if (hex) {
+            snprintf_hex2ascii(dst, MAX_FIELD_LEN, payload + offset, length);
+        } else {
+            snprintf_ascii(dst, 0, MAX_FIELD_LEN, payload + offset, length);
+        }
+    }
+    if (dst[0] == 0x00) {
+        dst[0] = ' ';
+    }
+}
+
+uint8_t get_summary_pair_count(const summary_t *summary) {
+    return summary->wrapper || summary->mosaicCount > 0 ? SUMMARY_PAIR_COUNT : 0;
+}
+
+// A saturated total is not shown
+static void total_formatter(uint64_t total, char *dst) {
+    if (total == UINT64_MAX) {
+        SNPRINTF(dst, "%s", "Overflow");
+    } else {
+        snprintf_token(dst, MAX_FIELD_LEN, total, 6, (char *) "XEM");
+    }
+}
+
+const char *get_summary_name(uint8_t index) {
+    switch (index) {
+        case 0:
+            return "Total XEM";
+        case 1:
+            return "Total fees";
+        case 2:
+            return "Other mosaics";
+        default:
+            return "Cosig. changes";
+    }
+}
+
+void format_summary_pair(const summary_t *summary, uint8_t index, char *dst) {
+    memset(dst, 0, MAX_FIELD_LEN);
+    switch (index) {
+        case 0:
+            total_formatter(summary->xemAmount, dst);
+            break;
+        case 1:
+            total_formatter(summary->fees, dst);
+            break;
+        case 2:
+            SNPRINTF(dst, "%d", summary->mosaicCount);
+            break;
+        default:
+            SNPRINTF(dst, "%d", summary->cosignatoryChanges);
+            break;
+    }
+}
+
+uint8_t get_review_pair_count(const result_t *result) {
+    uint8_t count = get_summary_pair_count(&result->summary);
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        count += get_field_chunk_count(&result->fields[i]);
+    }
+    return count;
+}
+
+bool find_review_pair(const result_t *result, uint8_t index, review_pair_t *pair) {
+    uint8_t summaryPairs = get_summary_pair_count(&result->summary);
+    if (index < summaryPairs) {
+        pair->field = NULL;
+        pair->index = index;
+        pair->count = 1;
+        return true;
+    }
+    index -= summaryPairs;
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        const field_t *field = &result->fields[i];
+        uint8_t count = get_field_chunk_count(field);
+        if (index < count) {
+            pair->field = field;
+            pair->index = index;
+            pair->count = count;
+            return true;
+        }
+        index -= count;
+    }
+    return false;
+}
+
+uint16_t format_review_pair_name(const review_pair_t *pair, char *dst, uint16_t dstLen) {
+    int length;
+    if (pair->field == NULL) {
+        length = snprintf(dst, dstLen, "%s", get_summary_name(pair->index));
+    } else if (pair->count > 1) {
+        length = snprintf(dst,
+                          dstLen,
+                          "%s %d/%d",
+                          get_fieldname(pair->field),
+                          pair->index + 1,
+                          pair->count);
+    } else {
+        length = snprintf(dst, dstLen, "%s", get_fieldname(pair->field));
+    }
+    return length < dstLen ? length : dstLen - 1;
+}
+
+void format_review_pair_value(const result_t *result, const review_pair_t *pair, char *dst) {
+    if (pair->field == NULL) {
+        format_summary_pair(&result->summary, pair->index, dst);
+    } else {
+        format_field_chunk(pair->field, pair->index, dst);
+    }
+}
@@ -18,7 +18,10 @@
 #ifndef LEDGER_APP_NEM_FORMAT_H
 #define LEDGER_APP_NEM_FORMAT_H
 
+#include <stdbool.h>
 #include "fields.h"
+#include "limitations.h"
+#include "nem_parse.h"
 
 #define SNPRINTF(strbuf, ...) snprintf(strbuf, MAX_FIELD_LEN, __VA_ARGS__)
 // Simple macro for building more readable switch statements
@@ -27,6 +30,117 @@
         SNPRINTF(dst, "%s", src); \
         return;
 
+// Characters of a long message shown per review pair
+#define MESSAGE_CHUNK_LEN 256
+// Review pairs of the longest message: a hex message of MAX_RAW_TX bytes, two characters per byte
+#define MAX_FIELD_CHUNKS ((2 * MAX_RAW_TX + MESSAGE_CHUNK_LEN - 1) / MESSAGE_CHUNK_LEN)
+// The pairs of a field are counted on a byte
+#if MAX_FIELD_CHUNKS > 0xFF
+#error "MAX_RAW_TX gives messages of more review pairs than a field can count"
+#endif
+// Review pairs of the summary page: XEM moved, fees, other mosaics, cosignatory changes
+#define SUMMARY_PAIR_COUNT 4
+// Review pairs of a transaction: the summary, one per field, and one more per
+// MESSAGE_CHUNK_LEN / 2 bytes of message at most, out of the MAX_RAW_TX bytes of the transaction
+#define REVIEW_MAX_PAIRS \
+    (SUMMARY_PAIR_COUNT + MAX_FIELD_COUNT + 2 * MAX_RAW_TX / MESSAGE_CHUNK_LEN)
+// NBGL and the PARSE_TRANSACTION field list count the pairs on a byte
+#if REVIEW_MAX_PAIRS > 0xFF
+#error "MAX_FIELD_COUNT and MAX_RAW_TX give more review pairs than NBGL can show"
+#endif
+// Name of a review pair: a field name, numbered for the parts of a message
+#define REVIEW_PAIR_NAME_LEN (MAX_FIELDNAME_LEN + sizeof(" 255/255"))
+
+// Pair of the review screens: a pair of the summary page, a field, or a part of a long message
+typedef struct {
+    // Field shown by the pair, NULL for a summary pair
+    const field_t *field;
+    // Index of the summary pair, or of the part of the field
+    uint8_t index;
+    // Number of parts of the field, 1 for a summary pair
+    uint8_t count;
+} review_pair_t;
+
 void format_field(const field_t *field, char *dst);
 
+/**
+ * @param field parsed field
+ * @return work units of the formatting of the field, see heartbeat.h: the public keys shown as
+ * addresses are hashed, the other fields are copied or printed
+ */
+uint32_t get_field_cost(const field_t *field);
+
+/**
+ * @param field parsed field
+ * @return number of review pairs showing the field: messages longer than MESSAGE_CHUNK_LEN
+ * characters are split, the other fields have one pair. The parser refuses the messages longer
+ * than MAX_RAW_TX bytes, so that the count is at most MAX_FIELD_CHUNKS.
+ */
+uint8_t get_field_chunk_count(const field_t *field);
+
+/**
+ * Formats one review pair of a field, only reading the part of the payload it shows.
+ *
+ * @param field parsed field
+ * @param chunk index of the pair, below get_field_chunk_count(field)
+ * @param dst buffer of MAX_FIELD_LEN bytes
+ */
+void format_field_chunk(const field_t *field, uint8_t chunk, char *dst);
+
+/**
+ * @param summary totals of the parsed transaction
+ * @return number of summary pairs shown before the fields: the summary is shown for the
+ * transactions wrapping others and the transfers of mosaics other than XEM, 0 otherwise
+ */
+uint8_t get_summary_pair_count(const summary_t *summary);
+
+/**
+ * @param index index of a summary pair, below SUMMARY_PAIR_COUNT
+ * @return name of the pair, a constant string
+ */
+const char *get_summary_name(uint8_t index);
+
+/**
+ * Formats the value of one pair of the summary page.
+ *
+ * @param summary totals of the parsed transaction
+ * @param index index of the pair, below SUMMARY_PAIR_COUNT
+ * @param dst buffer of MAX_FIELD_LEN bytes
+ */
+void format_summary_pair(const summary_t *summary, uint8_t index, char *dst);
+
+/**
+ * @param result parsed transaction
+ * @return number of review pairs: the summary page when the transaction has one, then the fields,
+ * the long messages being split into several pairs
+ */
+uint8_t get_review_pair_count(const result_t *result);
+
+/**
+ * Finds what a review pair shows. The device screens and the PARSE_TRANSACTION field list both
+ * walk this list.
+ *
+ * @param result parsed transaction
+ * @param index index of the pair, below get_review_pair_count(result)
+ * @param pair set to the summary pair, field or message part shown
+ * @return false when the index is out of the list
+ */
+bool find_review_pair(const result_t *result, uint8_t index, review_pair_t *pair);
+
+/**
+ * @param pair review pair
+ * @param dst buffer of dstLen bytes, REVIEW_PAIR_NAME_LEN bytes always fit the name
+ * @return length of the name
+ */
+uint16_t format_review_pair_name(const review_pair_t *pair, char *dst, uint16_t dstLen);
+
+/**
+ * Formats the value of a review pair.
+ *
+ * @param result parsed transaction
+ * @param pair review pair of the transaction
+ * @param dst buffer of MAX_FIELD_LEN bytes
+ */
+void format_review_pair_value(const result_t *result, const review_pair_t *pair, char *dst);
+
 #endif  // LEDGER_APP_NEM_FORMAT_H
@@ -14,104 +14,124 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  ********************************************************************************/
-#include <stdio.h>
+#include <string.h>
 #include "fields.h"
 #include "common.h"
-#include "limitations.h"
 #include "os_utils.h"
-#include "printers.h"
+#include "os_pic.h"
+#include "tx_types.h"
 
-void resolve_fieldname(const field_t *field, char *dst) {
-    if (field->dataType == STI_UINT32) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_UINT32_TRANSACTION_TYPE, "Transaction Type")
-            CASE_FIELDNAME(NEM_UINT32_INNER_TRANSACTION_TYPE, "Inner TX Type")
-            CASE_FIELDNAME(NEM_UINT32_DETAIL_TRANSACTION_TYPE, "Detail TX Type")
-            CASE_FIELDNAME(NEM_UINT32_MOSAIC_COUNT, "Mosaics")
-            CASE_FIELDNAME(NEM_UINT32_IT_MODE, "Importance Mode")
-            CASE_FIELDNAME(NEM_UINT32_AM_COSIGNATORY_NUM, "Cosignatory Num")
-            CASE_FIELDNAME(NEM_UINT32_AM_MODICATION_TYPE, "Mod. Type")
-            CASE_FIELDNAME(NEM_UINT32_AM_RELATIVE_CHANGE, "Relative Change")
-            CASE_FIELDNAME(NEM_UINT32_LEVY_FEE_TYPE, "Levy Fee Type")
-        }
-    }
+typedef struct {
+    uint8_t dataType;
+    const char *name;
+} field_name_t;
 
-    if (field->dataType == STI_UINT64) {
-        switch (field->id) { CASE_FIELDNAME(NEM_UINT64_DURATION, "Duration") }
-    }
+#define FIRST_FIELD_ID NEM_UINT32_TRANSACTION_TYPE
+#define LAST_FIELD_ID  NEM_MOSAIC_XEM_QUANTITY
 
-    if (field->dataType == STI_HASH256) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_HASH256, "SHA3 Tx Hash")
-            CASE_FIELDNAME(NEM_PUBLICKEY_IT_REMOTE, "Rmt. Public Key")
-            CASE_FIELDNAME(NEM_PUBLICKEY_AM_COSIGNATORY, "Cosignatory PbK")
-        }
-    }
+#define FIELD_NAME(id, type, str) [(id) - FIRST_FIELD_ID] = {type, str}
 
-    if (field->dataType == STI_ADDRESS) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_STR_RECIPIENT_ADDRESS, "Recipient")
-            CASE_FIELDNAME(NEM_STR_MULTISIG_ADDRESS, "Multisig Address")
-            CASE_FIELDNAME(NEM_STR_SINK_ADDRESS, "Sink Address")
-            CASE_FIELDNAME(NEM_STR_LEVY_ADDRESS, "Levy Address")
-            CASE_FIELDNAME(NEM_PUBLICKEY_IT_REMOTE, "Rmt. Address")
-            CASE_FIELDNAME(NEM_PUBLICKEY_AM_COSIGNATORY, "CosignatoryAddr")
-        }
-    }
+// Name of each field id, for the data type the parser gives it, grouped by the transaction types
+// showing the field (see tx_types.h). The pointers of the tables are link addresses, read through
+// PIC()
+static const field_name_t FIELD_NAMES[LAST_FIELD_ID - FIRST_FIELD_ID + 1] = {
+    FIELD_NAME(NEM_UINT32_TRANSACTION_TYPE, STI_UINT32, "Transaction Type"),
+#ifdef HAVE_NEM_TXN_WRAPPER
+    FIELD_NAME(NEM_UINT32_INNER_TRANSACTION_TYPE, STI_UINT32, "Inner TX Type"),
+    FIELD_NAME(NEM_UINT32_DETAIL_TRANSACTION_TYPE, STI_UINT32, "Detail TX Type"),
+    FIELD_NAME(NEM_UINT64_MULTISIG_FEE, STI_NEM, "Multisig Fee"),
+#endif
+#ifdef HAVE_NEM_TXN_TRANSFER
+    FIELD_NAME(NEM_UINT32_MOSAIC_COUNT, STI_UINT32, "Mosaics"),
+    FIELD_NAME(NEM_STR_RECIPIENT_ADDRESS, STI_ADDRESS, "Recipient"),
+    FIELD_NAME(NEM_MOSAIC_UNITS, STI_MOSAIC_CURRENCY, "Micro Units"),
+    FIELD_NAME(NEM_MOSAIC_AMOUNT, STI_NEM, "Amount"),
+    FIELD_NAME(NEM_MOSAIC_XEM_QUANTITY, STI_NEM, "XEM Quantity"),
+    FIELD_NAME(NEM_UINT64_MULTIPLIER, STI_NEM, "Multiplier"),
+    FIELD_NAME(NEM_STR_TXN_MESSAGE, STI_MESSAGE, "Message"),
+    FIELD_NAME(NEM_STR_ENC_MESSAGE, STI_MESSAGE, "Message"),
+    FIELD_NAME(NEM_MOSAIC_UNKNOWN_TYPE, STI_STR, "Unknown Mosaic"),
+    FIELD_NAME(NEM_STR_TRANSFER_MOSAIC, STI_STR, "Namespace"),
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
+    FIELD_NAME(NEM_UINT32_IT_MODE, STI_UINT32, "Importance Mode"),
+    FIELD_NAME(NEM_PUBLICKEY_IT_REMOTE, STI_ADDRESS, "Rmt. Address"),
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
+    FIELD_NAME(NEM_UINT32_AM_COSIGNATORY_NUM, STI_UINT32, "Cosignatory Num"),
+    FIELD_NAME(NEM_UINT32_AM_MODICATION_TYPE, STI_UINT32, "Mod. Type"),
+    FIELD_NAME(NEM_UINT32_AM_RELATIVE_CHANGE, STI_UINT32, "Relative Change"),
+    FIELD_NAME(NEM_PUBLICKEY_AM_COSIGNATORY, STI_ADDRESS, "CosignatoryAddr"),
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
+    FIELD_NAME(NEM_HASH256, STI_HASH256, "SHA3 Tx Hash"),
+    FIELD_NAME(NEM_STR_MULTISIG_ADDRESS, STI_ADDRESS, "Multisig Address"),
+#endif
+#ifdef HAVE_NEM_TXN_NAMESPACE
+    FIELD_NAME(NEM_STR_NAMESPACE, STI_STR, "Namespace"),
+    FIELD_NAME(NEM_STR_PARENT_NAMESPACE, STI_STR, "Parent Name"),
+    FIELD_NAME(NEM_STR_MOSAIC, STI_STR, "Mosaic Name"),
+#endif
+#if defined(HAVE_NEM_TXN_PROVISION_NAMESPACE) || defined(HAVE_NEM_TXN_MOSAIC_DEFINITION)
+    FIELD_NAME(NEM_STR_SINK_ADDRESS, STI_ADDRESS, "Sink Address"),
+    FIELD_NAME(NEM_UINT64_RENTAL_FEE, STI_NEM, "Rental Fee"),
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
+    FIELD_NAME(NEM_STR_ROOT_NAMESPACE, STI_STR, "Create new root"),
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
+    FIELD_NAME(NEM_UINT32_LEVY_FEE_TYPE, STI_UINT32, "Levy Fee Type"),
+    FIELD_NAME(NEM_STR_LEVY_ADDRESS, STI_ADDRESS, "Levy Address"),
+    FIELD_NAME(NEM_UINT64_LEVY_FEE, STI_NEM, "Levy Fee"),
+    FIELD_NAME(NEM_STR_DESCRIPTION, STI_STR, "Description"),
+    FIELD_NAME(NEM_STR_LEVY_MOSAIC, STI_STR, "Levy Mosaic"),
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
+    FIELD_NAME(NEM_MOSAIC_DELETE_SUPPLY_DELTA, STI_MOSAIC_CURRENCY, "Delete Supply"),
+    FIELD_NAME(NEM_MOSAIC_CREATE_SUPPLY_DELTA, STI_MOSAIC_CURRENCY, "Create Supply"),
+#endif
+    FIELD_NAME(NEM_UINT64_TXN_FEE, STI_NEM, "Fee"),
+    FIELD_NAME(NEM_UINT64_DURATION, STI_UINT64, "Duration"),
+};
 
-    if (field->dataType == STI_PROPERTY) {
-        switch (field->id) {
-            case NEM_STR_PROPERTY: {
-                // field->data = len name, name, len value, value (ignore field->length)
-                snprintf_ascii(dst,
-                               0,
-                               MAX_FIELDNAME_LEN,
-                               field->data + sizeof(uint32_t),
-                               U4LE(field->data, 0));
-                return;
-            }
-        }
-    }
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
+// Properties of the NEM mosaic definitions, named after themselves
+#define MOSAIC_PROPERTY_COUNT 4
+static const char *const MOSAIC_PROPERTIES[MOSAIC_PROPERTY_COUNT] = {"divisibility",
+                                                                     "initialSupply",
+                                                                     "supplyMutable",
+                                                                     "transferable"};
 
-    if (field->dataType == STI_MOSAIC_CURRENCY) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_MOSAIC_AMOUNT, "Amount")
-            CASE_FIELDNAME(NEM_MOSAIC_UNITS, "Micro Units")
-            CASE_FIELDNAME(NEM_MOSAIC_DELETE_SUPPLY_DELTA, "Delete Supply")
-            CASE_FIELDNAME(NEM_MOSAIC_CREATE_SUPPLY_DELTA, "Create Supply")
+static const char *get_property_name(const field_t *field) {
+    // field->data = len name, name, len value, value (ignore field->length)
+    uint32_t nameLen = U4LE(field->data, 0);
+    for (size_t i = 0; i < MOSAIC_PROPERTY_COUNT; i++) {
+        const char *property = (const char *) PIC(MOSAIC_PROPERTIES[i]);
+        if (strlen(property) == nameLen &&
+            memcmp(property, field->data + sizeof(uint32_t), nameLen) == 0) {
+            return property;
         }
     }
+    return NULL;
+}
 
-    if (field->dataType == STI_NEM) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_UINT64_TXN_FEE, "Fee")
-            CASE_FIELDNAME(NEM_UINT64_RENTAL_FEE, "Rental Fee")
-            CASE_FIELDNAME(NEM_MOSAIC_AMOUNT, "Amount")
-            CASE_FIELDNAME(NEM_UINT64_LEVY_FEE, "Levy Fee")
-            CASE_FIELDNAME(NEM_UINT64_MULTISIG_FEE, "Multisig Fee")
-        }
-    }
+bool is_known_property(const field_t *field) {
+    return get_property_name(field) != NULL;
+}
+#endif
 
-    if (field->dataType == STI_MESSAGE) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_STR_TXN_MESSAGE, "Message")
-            CASE_FIELDNAME(NEM_STR_ENC_MESSAGE, "Message")
-        }
+const char *get_fieldname(const field_t *field) {
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
+    if (field->dataType == STI_PROPERTY && field->id == NEM_STR_PROPERTY) {
+        const char *name = get_property_name(field);
+        return name != NULL ? name : "Unknown Property";
     }
-
-    if (field->dataType == STI_STR) {
-        switch (field->id) {
-            CASE_FIELDNAME(NEM_MOSAIC_UNKNOWN_TYPE, "Unknown Mosaic")
-            CASE_FIELDNAME(NEM_STR_TRANSFER_MOSAIC, "Namespace")
-            CASE_FIELDNAME(NEM_STR_NAMESPACE, "Namespace")
-            CASE_FIELDNAME(NEM_STR_PARENT_NAMESPACE, "Parent Name")
-            CASE_FIELDNAME(NEM_STR_ROOT_NAMESPACE, "Create new root")
-            CASE_FIELDNAME(NEM_STR_MOSAIC, "Mosaic Name")
-            CASE_FIELDNAME(NEM_STR_DESCRIPTION, "Description")
-            CASE_FIELDNAME(NEM_STR_LEVY_MOSAIC, "Levy Mosaic")
+#endif
+    if (field->id >= FIRST_FIELD_ID && field->id <= LAST_FIELD_ID) {
+        const field_name_t *entry = &FIELD_NAMES[field->id - FIRST_FIELD_ID];
+        if (entry->name != NULL && entry->dataType == field->dataType) {
+            return (const char *) PIC(entry->name);
         }
     }
-
-    // Default case
-    snprintf(dst, MAX_FIELDNAME_LEN, "Unknown Field");
+    return "Unknown Field";
 }
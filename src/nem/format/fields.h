@@ -17,6 +17,7 @@
 #ifndef LEDGER_APP_NEM_FIELDS_H
 #define LEDGER_APP_NEM_FIELDS_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -60,6 +61,7 @@
 #define NEM_UINT64_DURATION     0x72
 #define NEM_UINT64_RENTAL_FEE   0x73
 #define NEM_UINT64_LEVY_FEE     0x74
+#define NEM_UINT64_MULTIPLIER   0x75
 
 // PUBLICKEY defines
 #define NEM_PUBLICKEY_IT_REMOTE      0x80
@@ -90,6 +92,7 @@
 #define NEM_MOSAIC_CREATE_SUPPLY_DELTA 0xD2
 #define NEM_MOSAIC_DELETE_SUPPLY_DELTA 0xD3
 #define NEM_MOSAIC_UNKNOWN_TYPE        0xD4
+#define NEM_MOSAIC_XEM_QUANTITY        0xD5
 
 typedef struct {
     uint8_t id;
@@ -98,12 +101,22 @@ typedef struct {
     const uint8_t *data;
 } field_t;
 
-// Simple macro for building more readable switch statements
-#define CASE_FIELDNAME(v, src)                       \
-    case v:                                          \
-        snprintf(dst, MAX_FIELDNAME_LEN, "%s", src); \
-        return;
+/**
+ * Returns the name of a field on the review screens, a constant string: the screens point to it
+ * without copy. Mosaic properties are named after themselves, except the ones NEM does not define,
+ * named "Unknown Property" with their name in the formatted value.
+ *
+ * @param field parsed field
+ * @return name of the field, never NULL
+ */
+const char *get_fieldname(const field_t *field);
 
-void resolve_fieldname(const field_t *field, char *dst);
+/**
+ * Built with the mosaic definitions only (HAVE_NEM_TXN_MOSAIC_DEFINITION, see tx_types.h).
+ *
+ * @param field mosaic property field
+ * @return whether the property is one of the NEM mosaic properties
+ */
+bool is_known_property(const field_t *field);
 
 #endif  // LEDGER_APP_NEM_FIELDS_H
@@ -0,0 +1,33 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "heartbeat.h"
+#include "os_io_seproxyhal.h"
+
+static uint32_t workDone;
+
+void heartbeat_reset(void) {
+    workDone = 0;
+}
+
+void heartbeat_consume(uint32_t cost) {
+    workDone += cost;
+    if (workDone >= HEARTBEAT_WORK_BUDGET) {
+        workDone = 0;
+        // ensure a I/O channel is not timing out
+        io_seproxyhal_io_heartbeat();
+    }
+}
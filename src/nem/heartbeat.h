@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_HEARTBEAT_H
+#define LEDGER_APP_NEM_HEARTBEAT_H
+
+#include <stdint.h>
+
+// Work units between two heartbeats of the I/O channel, about the time of one address derivation.
+// Only the work done while an APDU is processed is counted: the parser loops and the records of
+// the PARSE_TRANSACTION dry-run. The formatters also run in the NBGL page callbacks, where no
+// heartbeat is sent, so they do not count work themselves.
+#define HEARTBEAT_WORK_BUDGET 8
+
+// Cost of the steps, in work units
+#define HEARTBEAT_COST_ITEM    1  // mosaic, cosignatory, property or inner transaction parsed
+#define HEARTBEAT_COST_FIELD   1  // field formatted
+#define HEARTBEAT_COST_ADDRESS 8  // field formatted with an address derived from a public key
+
+#ifdef FUZZ
+// No I/O channel in the host builds (libnemparse, fuzzers): nothing is counted, so that parse
+// contexts used from different threads share no state
+static inline void heartbeat_reset(void) {
+}
+
+static inline void heartbeat_consume(uint32_t cost) {
+    (void) cost;
+}
+#else
+/**
+ * Starts the work count of a new transaction.
+ */
+void heartbeat_reset(void);
+
+/**
+ * Counts work done by a long loop and keeps the I/O channel alive, with a heartbeat each time
+ * the work since the previous one reaches HEARTBEAT_WORK_BUDGET.
+ *
+ * @param cost work units of the step
+ */
+void heartbeat_consume(uint32_t cost);
+#endif
+
+#endif  // LEDGER_APP_NEM_HEARTBEAT_H
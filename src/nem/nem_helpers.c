@@ -18,6 +18,35 @@
 #include "base32.h"
 #include "nem_helpers.h"
 
+int nem_hash_public_keys_to_addresses(const nem_address_hasher_t *hasher,
+                                      const uint8_t *inPublicKeys,
+                                      uint8_t count,
+                                      uint8_t inNetworkId,
+                                      char *outAddresses,
+                                      uint32_t outLen) {
+    uint8_t digest[NEM_ADDRESS_HASH_LENGTH];
+    // network (1) || RIPEMD-160 of the hash of the public key (20) || checksum (4)
+    uint8_t rawAddress[NEM_RAW_ADDRESS_LENGTH];
+
+    rawAddress[0] = inNetworkId;
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t *publicKey = inPublicKeys + i * NEM_PUBLIC_KEY_LENGTH;
+        if (hasher->sha3(publicKey, NEM_PUBLIC_KEY_LENGTH, digest, hasher->user) != 0 ||
+            hasher->ripemd160(digest, sizeof(digest), rawAddress + 1, hasher->user) != 0) {
+            return NEM_ADDRESS_HASH_FAILURE;
+        }
+        // The checksum is the beginning of the hash of the network and RIPEMD-160
+        if (hasher->sha3(rawAddress, 1 + NEM_ADDRESS_RIPEMD160_LENGTH, digest, hasher->user) != 0) {
+            return NEM_ADDRESS_HASH_FAILURE;
+        }
+        memcpy(rawAddress + 1 + NEM_ADDRESS_RIPEMD160_LENGTH, digest, NEM_ADDRESS_CHECKSUM_LENGTH);
+        if (base32_encode(rawAddress, sizeof(rawAddress), outAddresses + i * outLen, outLen) < 0) {
+            return NEM_ADDRESS_ENCODING_FAILURE;
+        }
+    }
+    return NEM_ADDRESS_OK;
+}
+
 #ifndef FUZZ
 #if defined(IOCUSTOMCRYPT)
 #include "aes.h"
@@ -51,27 +80,70 @@ uint8_t get_algo(uint8_t network_type) {
     }
 }
 
-int sha_calculation(uint8_t algorithm,
-                    const uint8_t *in,
-                    uint8_t inlen,
-                    uint8_t *out,
-                    uint8_t outlen) {
-    int error = SWO_PARAMETER_ERROR_NO_INFO;
-    cx_sha3_t hash;
-    if (algorithm == CX_KECCAK) {
-        CX_CHECK(cx_keccak_init_no_throw(&hash, 256));
+// Hash contexts of the address derivation, used one at a time
+typedef union {
+    cx_sha3_t sha3;
+    cx_ripemd160_t ripemd160;
+} address_hash_t;
+
+typedef struct {
+    address_hash_t hash;
+    unsigned int algo;
+    cx_err_t error;
+} address_hasher_ctx_t;
+
+static int sha3_256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    address_hasher_ctx_t *ctx = user;
+    cx_err_t error;
+    if (ctx->algo == CX_KECCAK) {
+        CX_CHECK(cx_keccak_init_no_throw(&ctx->hash.sha3, 256));
     } else {  // CX_SHA3
-        CX_CHECK(cx_sha3_init_no_throw(&hash, 256));
+        CX_CHECK(cx_sha3_init_no_throw(&ctx->hash.sha3, 256));
     }
-    CX_CHECK(cx_hash_no_throw(&hash.header, CX_LAST, in, inlen, out, outlen));
+    CX_CHECK(
+        cx_hash_no_throw(&ctx->hash.sha3.header, CX_LAST, in, inLen, out, NEM_ADDRESS_HASH_LENGTH));
 end:
+    ctx->error = error;
     return error;
 }
 
-int ripemd(const uint8_t *in, uint8_t inlen, uint8_t *out, uint8_t outlen) {
-    cx_ripemd160_t hash;
-    cx_ripemd160_init(&hash);
-    return cx_hash_no_throw(&hash.header, CX_LAST, in, inlen, out, outlen);
+static int ripemd160(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    address_hasher_ctx_t *ctx = user;
+    cx_err_t error;
+    CX_CHECK(cx_ripemd160_init_no_throw(&ctx->hash.ripemd160));
+    CX_CHECK(cx_hash_no_throw(&ctx->hash.ripemd160.header,
+                              CX_LAST,
+                              in,
+                              inLen,
+                              out,
+                              NEM_ADDRESS_RIPEMD160_LENGTH));
+end:
+    ctx->error = error;
+    return error;
+}
+
+int nem_public_keys_to_addresses(const uint8_t *inPublicKeys,
+                                 uint8_t count,
+                                 uint8_t inNetworkId,
+                                 unsigned int inAlgo,
+                                 char *outAddresses,
+                                 uint32_t outLen) {
+    address_hasher_ctx_t ctx = {.algo = inAlgo, .error = CX_OK};
+    const nem_address_hasher_t hasher = {sha3_256, ripemd160, &ctx};
+
+    switch (nem_hash_public_keys_to_addresses(&hasher,
+                                              inPublicKeys,
+                                              count,
+                                              inNetworkId,
+                                              outAddresses,
+                                              outLen)) {
+        case NEM_ADDRESS_OK:
+            return SWO_SUCCESS;
+        case NEM_ADDRESS_HASH_FAILURE:
+            return ctx.error;
+        default:
+            return SWO_DATA_MAY_BE_CORRUPTED;
+    }
 }
 
 int nem_public_key_and_address(cx_ecfp_public_key_t *inPublicKey,
@@ -80,33 +152,13 @@ int nem_public_key_and_address(cx_ecfp_public_key_t *inPublicKey,
                                uint8_t *outPublicKey,
                                char *outAddress,
                                uint32_t outLen) {
-    uint8_t buffer1[32];
-    uint8_t buffer2[20];
-    uint8_t rawAddress[32];
-    int error = SWO_PARAMETER_ERROR_NO_INFO;
-
     for (uint8_t i = 0; i < 32; i++) {
         outPublicKey[i] = inPublicKey->W[64 - i];
     }
     if ((inPublicKey->W[32] & 1) != 0) {
         outPublicKey[31] |= 0x80;
     }
-    CX_CHECK(sha_calculation(inAlgo, outPublicKey, 32, buffer1, sizeof(buffer1)));
-    CX_CHECK(ripemd(buffer1, 32, buffer2, sizeof(buffer2)));
-    // step1: add network prefix char
-    rawAddress[0] = inNetworkId;  // 152:,,,,,
-    // step2: add ripemd160 hash
-    memcpy(rawAddress + 1, buffer2, sizeof(buffer2));
-    CX_CHECK(sha_calculation(inAlgo, rawAddress, 21, buffer1, sizeof(buffer1)));
-    // step3: add checksum
-    memcpy(rawAddress + 21, buffer1, 4);
-    if (base32_encode((const uint8_t *) rawAddress, 25, (char *) outAddress, outLen) < 0) {
-        error = SWO_DATA_MAY_BE_CORRUPTED;
-        goto end;
-    }
-    error = SWO_SUCCESS;
-end:
-    return error;
+    return nem_public_keys_to_addresses(outPublicKey, 1, inNetworkId, inAlgo, outAddress, outLen);
 }
 
 int nem_get_remote_private_key(const uint8_t *privateKey,
@@ -136,6 +188,8 @@ int nem_get_remote_private_key(const uint8_t *privateKey,
     strncpy((char *) out, (const char *) value, outLen);
     AES_init_ctx_iv(&ctx, aes, iv);
 #else
+    // cx_aes_iv_no_throw() takes a size_t, which is not unsigned int on every target
+    size_t outLength = outLen;
     explicit_bzero(out, outLen);
     CX_CHECK(cx_aes_init_key_no_throw(aes, 32, &ctx));
 #endif
@@ -151,7 +205,7 @@ int nem_get_remote_private_key(const uint8_t *privateKey,
                                     value,
                                     valueLen,
                                     out,
-                                    &outLen));
+                                    &outLength));
 #endif
     } else {
 #if defined(IOCUSTOMCRYPT)
@@ -164,7 +218,7 @@ int nem_get_remote_private_key(const uint8_t *privateKey,
                                     value,
                                     valueLen,
                                     out,
-                                    &outLen));
+                                    &outLength));
 #endif
     }
     error = SWO_SUCCESS;
@@ -179,26 +233,6 @@ int nem_public_key_to_address(const uint8_t *inPublicKey,
                               unsigned int inAlgo,
                               char *outAddress,
                               uint32_t outLen) {
-    uint8_t buffer1[32];
-    uint8_t buffer2[20];
-    uint8_t rawAddress[32];
-    int error = SWO_PARAMETER_ERROR_NO_INFO;
-
-    CX_CHECK(sha_calculation(inAlgo, inPublicKey, 32, buffer1, sizeof(buffer1)));
-    CX_CHECK(ripemd(buffer1, 32, buffer2, sizeof(buffer2)));
-    // step1: add network prefix char
-    rawAddress[0] = inNetworkId;  // 152:,,,,,
-    // step2: add ripemd160 hash
-    memcpy(rawAddress + 1, buffer2, sizeof(buffer2));
-    CX_CHECK(sha_calculation(inAlgo, rawAddress, 21, buffer1, sizeof(buffer1)));
-    // step3: add checksum
-    memcpy(rawAddress + 21, buffer1, 4);
-    if (base32_encode((const uint8_t *) rawAddress, 25, (char *) outAddress, outLen) < 0) {
-        error = SWO_DATA_MAY_BE_CORRUPTED;
-        goto end;
-    }
-    error = SWO_SUCCESS;
-end:
-    return error;
+    return nem_public_keys_to_addresses(inPublicKey, 1, inNetworkId, inAlgo, outAddress, outLen);
 }
 #endif
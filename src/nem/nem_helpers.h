@@ -18,6 +18,8 @@
 #define LEDGER_APP_NEM_NEMHELPERS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #ifndef FUZZ
 #include "os.h"
 #include "cx.h"
@@ -36,12 +38,18 @@
 /* max amount is max int64 scaled down: "922337203685.4775807" */
 #define AMOUNT_MAX_SIZE             21
 #define NEM_ADDRESS_LENGTH          40
+#define NEM_RAW_ADDRESS_LENGTH      25
+#define NEM_ADDRESS_CHECKSUM_LENGTH 4
 #define NEM_PRETTY_ADDRESS_LENGTH   40
 #define NEM_PUBLIC_KEY_LENGTH       32
 #define NEM_PRIVATE_KEY_LENGTH      32
 #define NEM_RAW_PRIVATE_KEY_LENGTH  64
 #define NEM_TRANSACTION_HASH_LENGTH 32
 
+// Digests of the address derivation
+#define NEM_ADDRESS_HASH_LENGTH      32
+#define NEM_ADDRESS_RIPEMD160_LENGTH 20
+
 #define TESTNET       152  // 0x98
 #define MAINNET       104  // 0x68
 #define MIJIN_MAINNET 96   // 0x60
@@ -53,9 +61,53 @@
 #define ACC_KEY   "Export delegated harvesting key?"
 #define ACC_VALUE "0000000000000000000000000000000000000000000000000000000000000000"
 
+// Hash function of the address derivation: digest of inLen bytes of in to out, 0 on success
+typedef int (*nem_address_hash_fn_t)(const uint8_t *in, size_t inLen, uint8_t *out, void *user);
+
+typedef struct {
+    // 32 bytes digest: Keccak-256 on MAINNET and TESTNET, SHA3-256 otherwise
+    nem_address_hash_fn_t sha3;
+    // 20 bytes digest
+    nem_address_hash_fn_t ripemd160;
+    void *user;
+} nem_address_hasher_t;
+
+#define NEM_ADDRESS_OK               0
+#define NEM_ADDRESS_HASH_FAILURE     -1
+#define NEM_ADDRESS_ENCODING_FAILURE -2
+
 int get_network_type(const uint32_t bip32Path[], uint8_t *network_type);
 uint8_t get_algo(uint8_t network_type);
+/**
+ * Derives the addresses of public keys: sha3 of the key, RIPEMD-160 of the hash after the network
+ * byte, and the first bytes of the sha3 of both as checksum, encoded in base32.
+ *
+ * @param inPublicKeys count public keys of NEM_PUBLIC_KEY_LENGTH bytes, one after the other
+ * @param outAddresses count addresses of outLen bytes, one after the other
+ * @return NEM_ADDRESS_OK, or the failure of the first address not derived
+ */
+int nem_hash_public_keys_to_addresses(const nem_address_hasher_t *hasher,
+                                      const uint8_t *inPublicKeys,
+                                      uint8_t count,
+                                      uint8_t inNetworkId,
+                                      char *outAddresses,
+                                      uint32_t outLen);
 #ifndef FUZZ
+/**
+ * Derives the addresses of public keys with nem_hash_public_keys_to_addresses() and a single cx
+ * hash context, inAlgo being CX_KECCAK or CX_SHA3 as returned by get_algo().
+ *
+ * @param inPublicKeys count public keys of NEM_PUBLIC_KEY_LENGTH bytes, one after the other
+ * @param outAddresses count addresses of outLen bytes, one after the other
+ * @return SWO_SUCCESS, or the error of the first address not derived
+ */
+int nem_public_keys_to_addresses(const uint8_t *inPublicKeys,
+                                 uint8_t count,
+                                 uint8_t inNetworkId,
+                                 unsigned int inAlgo,
+                                 char *outAddresses,
+                                 uint32_t outLen);
+// Compressed public key of an Ed25519 point and its address
 int nem_public_key_and_address(cx_ecfp_public_key_t *inPublicKey,
                                uint8_t inNetworkId,
                                unsigned int inAlgo,
@@ -16,11 +16,15 @@
  ********************************************************************************/
 
 #include "nem_parse.h"
-#include "global.h"
+#include "tx_types.h"
+#include "heartbeat.h"
 #include "printers.h"
 #include "os_utils.h"
 #include "os_print.h"
 
+// Amount of a transfer of version 2 multiplying its mosaic quantities by one
+#define MULTIPLIER_UNIT 1000000
+
 #pragma pack(push, 1)
 
 typedef struct address_t {
@@ -117,9 +121,11 @@ typedef struct common_txn_header_t {
         if (x) return err;  \
     }
 
+#ifdef HAVE_NEM_TXN_WRAPPER
 int parse_multisig_transaction(parse_context_t *context,
                                common_txn_header_t *common_header,
                                uint8_t is_inner_tx);
+#endif
 
 // Security check
 static bool has_data(parse_context_t *context, uint32_t numBytes) {
@@ -164,6 +170,68 @@ static int add_new_field(parse_context_t *context,
     return set_field_data(context, context->result.numFields++, id, data_type, length, data);
 }
 
+static void add_to_total(uint64_t *total, uint64_t amount) {
+    *total = *total > UINT64_MAX - amount ? UINT64_MAX : *total + amount;
+}
+
+// Adds a fee field and its amount to the fees of the summary
+static int add_fee_field(parse_context_t *context, uint8_t id, const uint8_t *fee) {
+    add_to_total(&context->result.summary.fees, U8LE(fee, 0));
+    return add_new_field(context, id, STI_NEM, sizeof(uint64_t), fee);
+}
+
+#ifdef HAVE_NEM_TXN_TRANSFER
+// Adds a XEM amount field, read from the transaction, and its amount to the XEM moved
+static int add_xem_field(parse_context_t *context, uint8_t id, const uint8_t *amount) {
+    BAIL_IF(add_new_field(context, id, STI_NEM, sizeof(uint64_t), amount));
+    add_to_total(&context->result.summary.xemAmount, U8LE(amount, 0));
+    return E_SUCCESS;
+}
+
+// Micro XEM moved by a mosaic quantity of a transfer of version 2, whose amount multiplies the
+// quantities in millionths: quantity * multiplier / 1 000 000, UINT64_MAX when it overflows
+static uint64_t get_mosaic_transfer_quantity(uint64_t quantity, uint64_t multiplier) {
+    // quantity = high * 1 000 000 + low and multiplier = mHigh * 1 000 000 + mLow, with
+    // low * mHigh < UINT64_MAX and low * mLow < 10^12
+    const uint64_t high = quantity / MULTIPLIER_UNIT;
+    const uint64_t low = quantity % MULTIPLIER_UNIT;
+    if (high != 0 && multiplier > UINT64_MAX / high) {
+        return UINT64_MAX;
+    }
+    uint64_t total = high * multiplier;
+    add_to_total(&total, low * (multiplier / MULTIPLIER_UNIT));
+    add_to_total(&total, low * (multiplier % MULTIPLIER_UNIT) / MULTIPLIER_UNIT);
+    return total;
+}
+
+// Adds the XEM mosaic field of a transfer of version 2 and the XEM it moves to the XEM moved.
+// The field holds the quantity as it is: it is the amount moved when the multiplier is 1, the
+// quantity to multiply by the Multiplier field otherwise.
+static int add_xem_mosaic_field(parse_context_t *context,
+                                const uint8_t *quantity,
+                                const uint8_t *multiplier) {
+    uint8_t id =
+        U8LE(multiplier, 0) == MULTIPLIER_UNIT ? NEM_MOSAIC_AMOUNT : NEM_MOSAIC_XEM_QUANTITY;
+    BAIL_IF(add_new_field(context, id, STI_NEM, sizeof(uint64_t), quantity));
+    add_to_total(&context->result.summary.xemAmount,
+                 get_mosaic_transfer_quantity(U8LE(quantity, 0), U8LE(multiplier, 0)));
+    return E_SUCCESS;
+}
+
+// Whether a mosaic id, len namespace id || namespace id || len name || name, is not one of the
+// mosaics already shown
+static bool is_new_mosaic(parse_context_t *context, const uint8_t *mosaicId, uint32_t length) {
+    for (uint8_t i = 0; i < context->result.numFields; i++) {
+        const field_t *field = get_field(context, i);
+        if (field->id == NEM_STR_TRANSFER_MOSAIC && field->length == length &&
+            memcmp(field->data, mosaicId, length) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 // Read data and security check
 static const uint8_t *read_data(parse_context_t *context, uint32_t numBytes) {
     BAIL_IF_ERR(!has_data(context, numBytes), NULL);
@@ -177,6 +245,8 @@ static const uint8_t *read_data(parse_context_t *context, uint32_t numBytes) {
     return context->data + offset;
 }
 
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_WRAPPER) || \
+    defined(HAVE_NEM_TXN_NAMESPACE)
 // Read uint32 and security check
 static int _read_uint32(parse_context_t *context, uint32_t *result) {
     const uint8_t *p = read_data(context, sizeof(uint32_t));
@@ -184,7 +254,10 @@ static int _read_uint32(parse_context_t *context, uint32_t *result) {
     *result = U4LE(p, 0);
     return E_SUCCESS;
 }
+#endif
 
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION) || \
+    defined(HAVE_NEM_TXN_MOSAIC_DEFINITION)
 // Read uint32 and security check
 static int _read_uint32_ptr(parse_context_t *context, uint32_t *result, uint8_t **presult) {
     const uint8_t *p = read_data(context, sizeof(uint32_t));
@@ -193,12 +266,16 @@ static int _read_uint32_ptr(parse_context_t *context, uint32_t *result, uint8_t
     *presult = (uint8_t *) p;
     return E_SUCCESS;
 }
+#endif
 
+#if defined(HAVE_NEM_TXN_TRANSFER) || defined(HAVE_NEM_TXN_MOSAIC_DEFINITION)
 // Move position and security check
 static const uint8_t *move_pos(parse_context_t *context, uint32_t numBytes) {
     return read_data(context, numBytes);  // Read data and security check
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_TRANSFER
 static int parse_transfer_transaction(parse_context_t *context,
                                       common_txn_header_t *common_header) {
     char str[32];
@@ -208,7 +285,7 @@ static int parse_transfer_transaction(parse_context_t *context,
         context,
         sizeof(transfer_txn_header_t));  // Read data and security check
     BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(txn->recipient.length > NEM_ADDRESS_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(txn->recipient.length != NEM_ADDRESS_LENGTH, E_INVALID_DATA);
     // Show Recipient address
     BAIL_IF(add_new_field(context,
                           NEM_STR_RECIPIENT_ADDRESS,
@@ -217,11 +294,7 @@ static int parse_transfer_transaction(parse_context_t *context,
                           (const uint8_t *) &txn->recipient.address));
     if (common_header->version == 1) {  // NEM transfer tx version 1
         // Show xem amount
-        BAIL_IF(add_new_field(context,
-                              NEM_MOSAIC_AMOUNT,
-                              STI_NEM,
-                              sizeof(uint64_t),
-                              (const uint8_t *) &txn->amount));
+        BAIL_IF(add_xem_field(context, NEM_MOSAIC_AMOUNT, (const uint8_t *) &txn->amount));
     }
     if (txn->msgLen == 0) {
         // empty msg
@@ -234,6 +307,11 @@ static int parse_transfer_transaction(parse_context_t *context,
         uint32_t payloadType, payloadLength;
         BAIL_IF(_read_uint32_ptr(context, &payloadType, (uint8_t **) &ptr));
         BAIL_IF(_read_uint32_ptr(context, &payloadLength, (uint8_t **) &ptr));
+        // The message structure is its type and its length prefixed payload
+        BAIL_IF_ERR(txn->msgLen - 2 * sizeof(uint32_t) != payloadLength, E_INVALID_DATA);
+        // Longer messages cannot be sent to the application, and would need more review pairs
+        // than get_field_chunk_count() counts
+        BAIL_IF_ERR(payloadLength > MAX_RAW_TX, E_INVALID_DATA);
         if (payloadType == 1) {
             // Show Message
             BAIL_IF(
@@ -245,14 +323,12 @@ static int parse_transfer_transaction(parse_context_t *context,
         } else {                                                    // show <encrypted msg>
             BAIL_IF(
                 add_new_field(context, NEM_STR_ENC_MESSAGE, STI_MESSAGE, 0, (const uint8_t *) ptr));
+            // Skip the encrypted payload, mosaics or the next inner transaction follow it
+            BAIL_IF_ERR(move_pos(context, payloadLength) == NULL, E_NOT_ENOUGH_DATA);
         }
     }
     // Show fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     if (common_header->version == 2) {  // NEM transfer tx version 2
         // num of mosaic pointer
         const uint8_t *pnumMosaic;
@@ -260,12 +336,16 @@ static int parse_transfer_transaction(parse_context_t *context,
         BAIL_IF(_read_uint32_ptr(context, &numMosaic, (uint8_t **) &pnumMosaic));
         if (numMosaic == 0) {
             // Show xem amount
-            BAIL_IF(add_new_field(context,
-                                  NEM_UINT64_TXN_FEE,
-                                  STI_NEM,
-                                  sizeof(uint64_t),
-                                  (const uint8_t *) &txn->amount));
+            BAIL_IF(add_xem_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &txn->amount));
         } else {
+            if (U8LE((const uint8_t *) &txn->amount, 0) != MULTIPLIER_UNIT) {
+                // Show the multiplier of the mosaic quantities
+                BAIL_IF(add_new_field(context,
+                                      NEM_UINT64_MULTIPLIER,
+                                      STI_NEM,
+                                      sizeof(uint64_t),
+                                      (const uint8_t *) &txn->amount));
+            }
             if (numMosaic > 1) {
                 // Show sent other mosaic num
                 BAIL_IF(add_new_field(context,
@@ -275,6 +355,7 @@ static int parse_transfer_transaction(parse_context_t *context,
                                       (const uint8_t *) pnumMosaic));
             }
             for (uint32_t i = 0; i < numMosaic; i++) {
+                heartbeat_consume(HEARTBEAT_COST_ITEM);
                 // mosaic structure length pointer
                 uint32_t mosaicLen;
                 BAIL_IF(_read_uint32(context, &mosaicLen));
@@ -309,12 +390,10 @@ static int parse_transfer_transaction(parse_context_t *context,
                 snprintf_ascii(str, 0, 32, ptr, mosaicNameLen);
                 if (is_nem == 1 && strcmp(str, STR_XEM) == 0) {
                     // xem quantity
-                    BAIL_IF(add_new_field(
+                    BAIL_IF(add_xem_mosaic_field(
                         context,
-                        NEM_MOSAIC_AMOUNT,
-                        STI_NEM,
-                        sizeof(uint64_t),
-                        read_data(context, sizeof(uint64_t))));  // Read data and security check
+                        read_data(context, sizeof(uint64_t)),  // Read data and security check
+                        (const uint8_t *) &txn->amount));
                 } else {
                     if (numMosaic == 1) {
                         BAIL_IF(add_new_field(context,
@@ -329,6 +408,9 @@ static int parse_transfer_transaction(parse_context_t *context,
                                           STI_STR,
                                           0,
                                           (const uint8_t *) &is_nem));
+                    if (is_new_mosaic(context, startPtr, mosaicIdLen)) {
+                        context->result.summary.mosaicCount++;
+                    }
                     // Show mosaic information: namespace: mosaic name, data=len namespaceId,
                     // namespaceId, len mosaic name, mosaic name
                     BAIL_IF(add_new_field(context,
@@ -349,14 +431,16 @@ static int parse_transfer_transaction(parse_context_t *context,
     }
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
 static int parse_importance_transfer_transaction(parse_context_t *context,
                                                  common_txn_header_t *common_header) {
     importance_txn_header_t *txn = (importance_txn_header_t *) read_data(
         context,
         sizeof(importance_txn_header_t));  // Read data and security check
     BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(txn->iPublicKey.length > NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(txn->iPublicKey.length != NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
     //  Show importance transfer mode
     BAIL_IF(add_new_field(context,
                           NEM_UINT32_IT_MODE,
@@ -370,14 +454,12 @@ static int parse_importance_transfer_transaction(parse_context_t *context,
                           NEM_PUBLIC_KEY_LENGTH,
                           (const uint8_t *) &txn->iPublicKey.publicKey));
     // Show fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
 static int parse_aggregate_modification_transaction(parse_context_t *context,
                                                     common_txn_header_t *common_header) {
     const uint8_t *pcmNum;
@@ -390,11 +472,13 @@ static int parse_aggregate_modification_transaction(parse_context_t *context,
                           sizeof(uint32_t),
                           (const uint8_t *) pcmNum));
     for (uint32_t i = 0; i < cmNum; i++) {
+        heartbeat_consume(HEARTBEAT_COST_ITEM);
         aggregate_modication_header_t *txn = (aggregate_modication_header_t *) read_data(
             context,
             sizeof(aggregate_modication_header_t));  // Read data and security check
         BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
-        BAIL_IF_ERR(txn->amPublicKey.length > NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
+        BAIL_IF_ERR(txn->amPublicKey.length != NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
+        context->result.summary.cosignatoryChanges++;
         //  Show modification type
         BAIL_IF(add_new_field(context,
                               NEM_UINT32_AM_MODICATION_TYPE,
@@ -431,22 +515,20 @@ static int parse_aggregate_modification_transaction(parse_context_t *context,
         }
     }
     // Show fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
 static int parse_multisig_signature_transaction(parse_context_t *context,
                                                 common_txn_header_t *common_header) {
     multsig_signature_header_t *txn = (multsig_signature_header_t *) read_data(
         context,
         sizeof(multsig_signature_header_t));  // Read data and security check
     BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(txn->msAddress.length > NEM_ADDRESS_LENGTH, E_INVALID_DATA);
-    BAIL_IF_ERR(txn->hashLen > NEM_TRANSACTION_HASH_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(txn->msAddress.length != NEM_ADDRESS_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(txn->hashLen != NEM_TRANSACTION_HASH_LENGTH, E_INVALID_DATA);
     // Show sha3 hash
     BAIL_IF(add_new_field(context,
                           NEM_HASH256,
@@ -463,14 +545,16 @@ static int parse_multisig_signature_transaction(parse_context_t *context,
     BAIL_IF(parse_multisig_transaction(context, common_header, 0));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
 static int parse_provision_namespace_transaction(parse_context_t *context,
                                                  common_txn_header_t *common_header) {
     rental_header_t *txn =
         (rental_header_t *) read_data(context,
                                       sizeof(rental_header_t));  // Read data and security check
     BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(txn->rAddress.length > NEM_ADDRESS_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(txn->rAddress.length != NEM_ADDRESS_LENGTH, E_INVALID_DATA);
     uint32_t len;
     BAIL_IF(_read_uint32(context, &len));
     // New part string
@@ -502,20 +586,14 @@ static int parse_provision_namespace_transaction(parse_context_t *context,
                           txn->rAddress.length,
                           (const uint8_t *) &txn->rAddress.address));
     // Show rental fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_RENTAL_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &txn->rentalFee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_RENTAL_FEE, (const uint8_t *) &txn->rentalFee));
     // Show fee./
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
 static int parse_mosaic_definition_creation_transaction(parse_context_t *context,
                                                         common_txn_header_t *common_header) {
     const uint8_t *ptr;
@@ -524,7 +602,7 @@ static int parse_mosaic_definition_creation_transaction(parse_context_t *context
     BAIL_IF_ERR(!has_data(context, mdsLen), E_INVALID_DATA);
     publickey_t *mdcPublicKey = (publickey_t *) read_data(context, sizeof(publickey_t));
     BAIL_IF_ERR(mdcPublicKey == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(mdcPublicKey->length > NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(mdcPublicKey->length != NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
     // Length of mosaic id structure
     uint32_t midsLen;
     BAIL_IF(_read_uint32(context, &midsLen));
@@ -561,6 +639,7 @@ static int parse_mosaic_definition_creation_transaction(parse_context_t *context
     BAIL_IF(_read_uint32(context, &propertyNum));
     uint32_t propertyLen = 0;
     for (uint32_t i = 0; i < propertyNum; i++) {
+        heartbeat_consume(HEARTBEAT_COST_ITEM);
         // Length of the property structure
         uint32_t proStructLen;
         BAIL_IF(_read_uint32(context, &proStructLen));
@@ -591,7 +670,7 @@ static int parse_mosaic_definition_creation_transaction(parse_context_t *context
             sizeof(levy_structure_t));  // Read data and security check
         BAIL_IF_ERR(levy == NULL, E_NOT_ENOUGH_DATA);
         BAIL_IF_ERR(levy->feeType != 1 && levy->feeType != 2, E_INVALID_DATA);
-        BAIL_IF_ERR(levy->lsAddress.length > NEM_ADDRESS_LENGTH, E_INVALID_DATA);
+        BAIL_IF_ERR(levy->lsAddress.length != NEM_ADDRESS_LENGTH, E_INVALID_DATA);
         BAIL_IF_ERR(levy->msIdLen > mdsLen, E_INVALID_DATA);
         ptr = read_data(context, sizeof(uint32_t));  // Read data and security check
         BAIL_IF_ERR(ptr == NULL, E_NOT_ENOUGH_DATA);
@@ -644,7 +723,7 @@ static int parse_mosaic_definition_creation_transaction(parse_context_t *context
         context,
         sizeof(mosaic_definition_sink_t));  // Read data and security check
     BAIL_IF_ERR(sink == NULL, E_NOT_ENOUGH_DATA);
-    BAIL_IF_ERR(sink->mdAddress.length > NEM_ADDRESS_LENGTH, E_INVALID_DATA);
+    BAIL_IF_ERR(sink->mdAddress.length != NEM_ADDRESS_LENGTH, E_INVALID_DATA);
     // Show sink address
     BAIL_IF(add_new_field(context,
                           NEM_STR_SINK_ADDRESS,
@@ -652,20 +731,14 @@ static int parse_mosaic_definition_creation_transaction(parse_context_t *context
                           NEM_ADDRESS_LENGTH,
                           (const uint8_t *) &sink->mdAddress.address));
     // Show rentail fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_RENTAL_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &sink->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_RENTAL_FEE, (const uint8_t *) &sink->fee));
     // Show tx fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
 static int parse_mosaic_supply_change_transaction(parse_context_t *context,
                                                   common_txn_header_t *common_header) {
     // Length of mosaic id structure
@@ -712,14 +785,12 @@ static int parse_mosaic_supply_change_transaction(parse_context_t *context,
         return E_INVALID_DATA;
     }
     // Show fee
-    BAIL_IF(add_new_field(context,
-                          NEM_UINT64_TXN_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
-                          (const uint8_t *) &common_header->fee));
+    BAIL_IF(add_fee_field(context, NEM_UINT64_TXN_FEE, (const uint8_t *) &common_header->fee));
     return E_SUCCESS;
 }
+#endif
 
+#ifdef HAVE_NEM_TXN_WRAPPER
 int parse_multisig_transaction(parse_context_t *context,
                                common_txn_header_t *common_header,
                                uint8_t is_inner_tx) {
@@ -728,19 +799,20 @@ int parse_multisig_transaction(parse_context_t *context,
     uint32_t innerTxnLength;
     BAIL_IF(_read_uint32(context, &innerTxnLength));  // Read uint32 and security check
     BAIL_IF_ERR(!has_data(context, innerTxnLength), E_NOT_ENOUGH_DATA);
-    BAIL_IF(add_new_field(context,
+    BAIL_IF(add_fee_field(context,
                           NEM_UINT64_MULTISIG_FEE,
-                          STI_NEM,
-                          sizeof(uint64_t),
                           (const uint8_t *) &common_header->fee));
+    context->result.summary.wrapper = true;
     uint32_t innerOffset = 0;
     while (innerOffset < innerTxnLength) {
+        heartbeat_consume(HEARTBEAT_COST_ITEM);
         uint32_t previousOffset = context->offset;
         // get header first
         common_txn_header_t *inner_header = (common_txn_header_t *) read_data(
             context,
             sizeof(common_txn_header_t));  // Read data and security check
         BAIL_IF_ERR(inner_header == NULL, E_NOT_ENOUGH_DATA);
+        BAIL_IF_ERR(inner_header->publicKey.length != NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
         // Show inner transaction / detail transaction type
         BAIL_IF(add_new_field(
             context,
@@ -749,41 +821,59 @@ int parse_multisig_transaction(parse_context_t *context,
             sizeof(uint32_t),
             (const uint8_t *) &inner_header->transactionType));
         switch (inner_header->transactionType) {
+#ifdef HAVE_NEM_TXN_TRANSFER
             case NEM_TXN_TRANSFER:
                 BAIL_IF(parse_transfer_transaction(context, inner_header));
                 break;
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
             case NEM_TXN_IMPORTANCE_TRANSFER:
                 BAIL_IF(parse_importance_transfer_transaction(context, inner_header));
                 break;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
             case NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION:
                 BAIL_IF(parse_aggregate_modification_transaction(context, inner_header));
                 break;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
             case NEM_TXN_MULTISIG_SIGNATURE:
                 if (context->transactionType != NEM_TXN_MULTISIG_SIGNATURE) {
                     BAIL_IF(parse_multisig_signature_transaction(context, inner_header));
                     break;
                 } else
                     return E_INVALID_DATA;
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
             case NEM_TXN_PROVISION_NAMESPACE:
                 BAIL_IF(parse_provision_namespace_transaction(context, inner_header));
                 break;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
             case NEM_TXN_MOSAIC_DEFINITION:
                 BAIL_IF(parse_mosaic_definition_creation_transaction(context, inner_header));
                 break;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
             case NEM_TXN_MOSAIC_SUPPLY_CHANGE:
                 BAIL_IF(parse_mosaic_supply_change_transaction(context, inner_header));
                 break;
+#endif
             default:
                 return E_INVALID_DATA;
         }
         innerOffset = innerOffset + context->offset - previousOffset;
     }
+    // The last inner transaction ends with the wrapped data
+    BAIL_IF_ERR(innerOffset != innerTxnLength, E_INVALID_DATA);
     return E_SUCCESS;
 }
+#endif
 
 static int parse_txn_detail(parse_context_t *context, common_txn_header_t *common_header) {
     int ret;
     context->result.numFields = 0;
+    memset(&context->result.summary, 0, sizeof(context->result.summary));
     // Show Transaction type
     BAIL_IF(add_new_field(context,
                           NEM_UINT32_TRANSACTION_TYPE,
@@ -791,30 +881,46 @@ static int parse_txn_detail(parse_context_t *context, common_txn_header_t *commo
                           sizeof(uint32_t),
                           (const uint8_t *) &common_header->transactionType));
     switch (common_header->transactionType) {
+#ifdef HAVE_NEM_TXN_TRANSFER
         case NEM_TXN_TRANSFER:
             ret = parse_transfer_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_IMPORTANCE_TRANSFER
         case NEM_TXN_IMPORTANCE_TRANSFER:
             ret = parse_importance_transfer_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
         case NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION:
             ret = parse_aggregate_modification_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG_SIGNATURE
         case NEM_TXN_MULTISIG_SIGNATURE:
             ret = parse_multisig_signature_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_MULTISIG
         case NEM_TXN_MULTISIG:
             ret = parse_multisig_transaction(context, common_header, 1);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_PROVISION_NAMESPACE
         case NEM_TXN_PROVISION_NAMESPACE:
             ret = parse_provision_namespace_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_DEFINITION
         case NEM_TXN_MOSAIC_DEFINITION:
             ret = parse_mosaic_definition_creation_transaction(context, common_header);
             break;
+#endif
+#ifdef HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
         case NEM_TXN_MOSAIC_SUPPLY_CHANGE:
             ret = parse_mosaic_supply_change_transaction(context, common_header);
             break;
+#endif
         default:
             ret = E_INVALID_DATA;
             break;
@@ -825,11 +931,10 @@ static int parse_txn_detail(parse_context_t *context, common_txn_header_t *commo
 static void set_sign_data_length(parse_context_t *context) {
     if (context->transactionType == NEM_TXN_MULTISIG_SIGNATURE) {
         // Sign data from generation hash to transaction hash
-        transactionContext.rawTxLength =
-            sizeof(multsig_signature_header_t) + sizeof(common_txn_header_t);
+        context->signLength = sizeof(multsig_signature_header_t) + sizeof(common_txn_header_t);
     } else {
         // Sign all data in the transaction
-        transactionContext.rawTxLength = context->length;
+        context->signLength = context->length;
     }
 }
 
@@ -845,8 +950,13 @@ static common_txn_header_t *parse_common_header(parse_context_t *context) {
 }
 
 int parse_txn_context(parse_context_t *context) {
+    heartbeat_reset();
     common_txn_header_t *txn = parse_common_header(context);
     BAIL_IF_ERR(txn == NULL, E_NOT_ENOUGH_DATA);
+    BAIL_IF_ERR(txn->publicKey.length != NEM_PUBLIC_KEY_LENGTH, E_INVALID_DATA);
     set_sign_data_length(context);
-    return parse_txn_detail(context, txn);
+    BAIL_IF(parse_txn_detail(context, txn));
+    // Bytes after the transaction would be signed without being shown
+    BAIL_IF_ERR(context->offset != context->length, E_INVALID_DATA);
+    return E_SUCCESS;
 }
@@ -21,9 +21,25 @@
 #include "fields.h"
 #include "nem_helpers.h"
 
+// Totals of a transaction, accumulated while its fields are parsed. The amounts saturate at
+// UINT64_MAX.
+typedef struct summary_t {
+    // XEM moved by the transfers, in micro XEM, with the quantities of version 2 multiplied
+    uint64_t xemAmount;
+    // Fees and rental fees of the transaction and of the transactions it wraps, in micro XEM
+    uint64_t fees;
+    // Distinct mosaics other than XEM moved by the transfers
+    uint8_t mosaicCount;
+    // Cosignatories added or deleted
+    uint8_t cosignatoryChanges;
+    // The transaction wraps other transactions, with their own fees
+    bool wrapper;
+} summary_t;
+
 typedef struct result_t {
     uint8_t numFields;
     field_t fields[MAX_FIELD_COUNT];
+    summary_t summary;
 } result_t;
 
 typedef struct parse_context_t {
@@ -33,6 +49,8 @@ typedef struct parse_context_t {
     result_t result;
     uint32_t length;
     uint32_t offset;
+    // Length of the data to sign, starting from the beginning of the transaction
+    uint32_t signLength;
 } parse_context_t;
 
 int parse_txn_context(parse_context_t *parseContext);
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_TX_TYPES_H
+#define LEDGER_APP_NEM_TX_TYPES_H
+
+// Transaction types parsed and shown by the application. The Makefile selects them with
+// NEM_TX_TYPES and defines NEM_TX_TYPES_SELECTED and HAVE_NEM_TXN_<type> for each one: the
+// parsers, formatter branches and field names of the others are left out of the build. Builds
+// without selection, such as the host builds, support all of them.
+#ifndef NEM_TX_TYPES_SELECTED
+#define HAVE_NEM_TXN_TRANSFER
+#define HAVE_NEM_TXN_IMPORTANCE_TRANSFER
+#define HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION
+#define HAVE_NEM_TXN_MULTISIG_SIGNATURE
+#define HAVE_NEM_TXN_MULTISIG
+#define HAVE_NEM_TXN_PROVISION_NAMESPACE
+#define HAVE_NEM_TXN_MOSAIC_DEFINITION
+#define HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE
+#endif
+
+// The multisig transactions and signatures only wrap transactions of the other types
+#if !defined(HAVE_NEM_TXN_TRANSFER) && !defined(HAVE_NEM_TXN_IMPORTANCE_TRANSFER) &&         \
+    !defined(HAVE_NEM_TXN_MULTISIG_AGGREGATE_MODIFICATION) &&                                \
+    !defined(HAVE_NEM_TXN_PROVISION_NAMESPACE) && !defined(HAVE_NEM_TXN_MOSAIC_DEFINITION) && \
+    !defined(HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE)
+#error "NEM_TX_TYPES selects no transaction type other than the multisig ones"
+#endif
+
+// Transaction types wrapping an inner transaction, shown with its own type and fee
+#if defined(HAVE_NEM_TXN_MULTISIG) || defined(HAVE_NEM_TXN_MULTISIG_SIGNATURE)
+#define HAVE_NEM_TXN_WRAPPER
+#endif
+
+// Transaction types showing a namespace or a mosaic name
+#if defined(HAVE_NEM_TXN_PROVISION_NAMESPACE) || defined(HAVE_NEM_TXN_MOSAIC_DEFINITION) || \
+    defined(HAVE_NEM_TXN_MOSAIC_SUPPLY_CHANGE)
+#define HAVE_NEM_TXN_NAMESPACE
+#endif
+
+#endif  // LEDGER_APP_NEM_TX_TYPES_H
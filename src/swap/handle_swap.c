@@ -0,0 +1,167 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifdef HAVE_SWAP
+
+#include "os.h"
+#include "io.h"
+#include "swap.h"
+#include "handle_swap.h"
+#include "swap_check.h"
+#include "global.h"
+#include "nem_helpers.h"
+#include "printers.h"
+#include "sign_transaction.h"
+
+// Copied from the exchange application before the application is started
+static swap_validated_t swapValidated;
+
+// Address of the account of a serialized path: length (1) || path elements (4 each, big endian)
+static bool derive_address(const uint8_t *params,
+                           uint8_t paramsLength,
+                           char *address,
+                           uint32_t addressLength) {
+    uint32_t bip32Path[MAX_BIP32_PATH];
+    uint8_t privateKeyData[NEM_RAW_PRIVATE_KEY_LENGTH];
+    cx_ecfp_private_key_t privateKey;
+    cx_ecfp_public_key_t publicKey;
+    uint8_t publicKeyData[NEM_PUBLIC_KEY_LENGTH];
+    uint8_t networkType;
+    int error = SWO_PARAMETER_ERROR_NO_INFO;
+
+    if (paramsLength < 1) {
+        return false;
+    }
+    uint8_t pathLength = params[0];
+    if (pathLength < 1 || pathLength > MAX_BIP32_PATH || paramsLength != 1 + 4 * pathLength) {
+        return false;
+    }
+    for (uint8_t i = 0; i < pathLength; i++) {
+        bip32Path[i] = U4BE(params, 1 + 4 * i);
+    }
+    if (get_network_type(bip32Path, &networkType) != SWO_SUCCESS) {
+        return false;
+    }
+    uint8_t algo = get_algo(networkType);
+
+    CX_CHECK(os_derive_bip32_with_seed_no_throw(HDW_ED25519_SLIP10,
+                                                CX_CURVE_Ed25519,
+                                                bip32Path,
+                                                pathLength,
+                                                privateKeyData,
+                                                NULL,
+                                                (unsigned char *) "ed25519-keccak seed",
+                                                19));
+    CX_CHECK(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519,
+                                               privateKeyData,
+                                               NEM_PRIVATE_KEY_LENGTH,
+                                               &privateKey));
+    CX_CHECK(
+        cx_ecfp_generate_pair2_no_throw(CX_CURVE_Ed25519, &publicKey, &privateKey, 1, algo));
+    error = nem_public_key_and_address(&publicKey,
+                                       networkType,
+                                       algo,
+                                       publicKeyData,
+                                       address,
+                                       addressLength);
+end:
+    explicit_bzero(privateKeyData, sizeof(privateKeyData));
+    explicit_bzero(&privateKey, sizeof(privateKey));
+    return error == SWO_SUCCESS;
+}
+
+void swap_handle_check_address(check_address_parameters_t *params) {
+    char address[NEM_PRETTY_ADDRESS_LENGTH + 1];
+
+    params->result = 0;
+    if (params->address_parameters == NULL || params->address_to_check == NULL) {
+        return;
+    }
+    explicit_bzero(address, sizeof(address));
+    if (!derive_address(params->address_parameters,
+                        params->address_parameters_length,
+                        address,
+                        sizeof(address))) {
+        return;
+    }
+    if (strncmp(address, params->address_to_check, sizeof(address)) == 0) {
+        params->result = 1;
+    }
+}
+
+void swap_handle_get_printable_amount(get_printable_amount_parameters_t *params) {
+    uint64_t amount;
+
+    // Amounts and fees are in micro XEM, the configuration of the coin is not used
+    explicit_bzero(params->printable_amount, sizeof(params->printable_amount));
+    if (!swap_read_amount(params->amount, params->amount_length, &amount)) {
+        return;
+    }
+    if (snprintf_token(params->printable_amount,
+                       sizeof(params->printable_amount),
+                       amount,
+                       6,
+                       (char *) "XEM") < 0) {
+        explicit_bzero(params->printable_amount, sizeof(params->printable_amount));
+    }
+}
+
+bool swap_copy_transaction_parameters(create_transaction_parameters_t *params) {
+    // The parameters may overlap the globals of the application, which are zeroed before use:
+    // they are read on the stack first
+    swap_validated_t validated;
+
+    explicit_bzero(&validated, sizeof(validated));
+    if (params->destination_address == NULL ||
+        strnlen(params->destination_address, NEM_ADDRESS_LENGTH + 1) != NEM_ADDRESS_LENGTH) {
+        return false;
+    }
+    memcpy(validated.destination, params->destination_address, NEM_ADDRESS_LENGTH);
+    if (params->destination_address_extra_id != NULL) {
+        size_t extraIdLength =
+            strnlen(params->destination_address_extra_id, SWAP_MAX_EXTRA_ID_LEN + 1);
+        if (extraIdLength > SWAP_MAX_EXTRA_ID_LEN) {
+            return false;
+        }
+        memcpy(validated.extraId, params->destination_address_extra_id, extraIdLength);
+    }
+    if (!swap_read_amount(params->amount, params->amount_length, &validated.amount) ||
+        !swap_read_amount(params->fee_amount, params->fee_amount_length, &validated.fee)) {
+        return false;
+    }
+    validated.initialized = true;
+
+    os_explicit_zero_BSS_segment();
+    memcpy(&swapValidated, &validated, sizeof(validated));
+    return true;
+}
+
+int handle_swap_sign_transaction(void) {
+    bool valid = swap_check_transaction(&parseContext, &swapValidated);
+    // A single transaction is signed per swap, the exchange application is resumed with the
+    // response
+    swapValidated.initialized = false;
+    G_swap_response_ready = true;
+    if (!valid) {
+        PRINTF("Swap transaction does not match the validated one\n");
+        reset_transaction_context();
+        return io_send_sw(SWO_INCORRECT_DATA);
+    }
+    sign_transaction();
+    return 0;
+}
+
+#endif  // HAVE_SWAP
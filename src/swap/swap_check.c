@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifdef HAVE_SWAP
+
+#include <string.h>
+#include "swap_check.h"
+#include "fields.h"
+
+bool swap_read_amount(const uint8_t *amount, uint8_t length, uint64_t *value) {
+    *value = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        if (*value >> 56 != 0) {
+            return false;
+        }
+        *value = *value << 8 | amount[i];
+    }
+    return true;
+}
+
+static const field_t *find_field(const result_t *result, uint8_t id) {
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        if (result->fields[i].id == id) {
+            return &result->fields[i];
+        }
+    }
+    return NULL;
+}
+
+static bool check_message(const result_t *result, const char *extraId) {
+    const field_t *message = find_field(result, NEM_STR_TXN_MESSAGE);
+    size_t length = strlen(extraId);
+    if (message == NULL) {
+        // Encrypted message
+        return false;
+    }
+    // Hex messages start with 0xFE, a plain message is the memo as it is
+    return message->length == length && (length == 0 || message->data[0] != 0xFE) &&
+           memcmp(message->data, extraId, length) == 0;
+}
+
+bool swap_check_transaction(const parse_context_t *context, const swap_validated_t *validated) {
+    const result_t *result = &context->result;
+    if (!validated->initialized || context->transactionType != NEM_TXN_TRANSFER) {
+        return false;
+    }
+    // The summary totals the XEM moved and the fees of the transfer
+    if (result->summary.wrapper || result->summary.mosaicCount != 0) {
+        return false;
+    }
+    // Mosaic quantities of version 2 transfers are multiplied by the amount of the transaction:
+    // only the transfers without mosaic move the amount as it is
+    if (context->version != 1 && (find_field(result, NEM_MOSAIC_AMOUNT) != NULL ||
+                                  find_field(result, NEM_MOSAIC_XEM_QUANTITY) != NULL)) {
+        return false;
+    }
+    if (result->summary.xemAmount != validated->amount || result->summary.fees != validated->fee) {
+        return false;
+    }
+    const field_t *recipient = find_field(result, NEM_STR_RECIPIENT_ADDRESS);
+    if (recipient == NULL || strlen(validated->destination) != NEM_ADDRESS_LENGTH ||
+        memcmp(recipient->data, validated->destination, NEM_ADDRESS_LENGTH) != 0) {
+        return false;
+    }
+    return check_message(result, validated->extraId);
+}
+
+#endif  // HAVE_SWAP
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_SWAP_CHECK_H
+#define LEDGER_APP_NEM_SWAP_CHECK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nem_parse.h"
+#include "nem_helpers.h"
+
+// Longest memo of a swap, sent as the plain message of the transfer
+#define SWAP_MAX_EXTRA_ID_LEN 64
+
+// Transfer validated by the user in the exchange application
+typedef struct swap_validated_t {
+    bool initialized;
+    // Amounts in micro XEM
+    uint64_t amount;
+    uint64_t fee;
+    char destination[NEM_ADDRESS_LENGTH + 1];
+    // Empty when the exchange does not send a memo
+    char extraId[SWAP_MAX_EXTRA_ID_LEN + 1];
+} swap_validated_t;
+
+/**
+ * Reads an amount sent by the exchange application.
+ *
+ * @param amount big endian amount, in micro XEM
+ * @param length length of the amount, up to 16 bytes
+ * @param value set to the amount
+ * @return false when the amount does not fit in 64 bits
+ */
+bool swap_read_amount(const uint8_t *amount, uint8_t length, uint64_t *value);
+
+/**
+ * Checks that a parsed transaction is exactly the transfer validated in the exchange application:
+ * a XEM transfer, not wrapped in a multisig transaction, to the destination, of the amount and
+ * with the fee validated, and with the memo as plain message.
+ *
+ * @param context parsed transaction
+ * @param validated transfer validated in the exchange application
+ * @return whether the transaction can be signed without review
+ */
+bool swap_check_transaction(const parse_context_t *context, const swap_validated_t *validated);
+
+#endif  // LEDGER_APP_NEM_SWAP_CHECK_H
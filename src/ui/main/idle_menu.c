@@ -21,6 +21,7 @@
 #include "nbgl_use_case.h"
 #include "main_std_app.h"
 #include "display.h"
+#include "remote_key_cache.h"
 
 // 'About' menu
 #define SETTING_INFO_NB 3
@@ -33,6 +34,13 @@ static const nbgl_contentInfoList_t infoList = {
     .infoContents = INFO_CONTENTS,
 };
 
+static void quit_app(void) {
+#ifdef HAVE_REMOTE_KEY_CACHE
+    remote_key_cache_wipe();
+#endif
+    app_exit();
+}
+
 void display_idle_menu(void) {
     nbgl_useCaseHomeAndSettings(APPNAME,
                                 &ICON_APP_HOME,
@@ -41,5 +49,5 @@ void display_idle_menu(void) {
                                 NULL,
                                 &infoList,
                                 NULL,
-                                app_exit);
+                                quit_app);
 }
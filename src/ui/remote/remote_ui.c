@@ -15,6 +15,7 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  ********************************************************************************/
+#include <stdio.h>
 #include "remote_ui.h"
 #include "os_io_seproxyhal.h"
 #include "ux.h"
@@ -22,11 +23,25 @@
 #include "idle_menu.h"
 #include "nem_helpers.h"
 #include "nbgl_use_case.h"
+#include "bip32.h"
 #include "display.h"
 
+// Accounts shown on a review page: a page starts every ACCOUNTS_PER_PAGE pairs, so that the names
+// and paths of a displayed page never share a buffer
+#define ACCOUNTS_PER_PAGE 4
+#define ACCOUNT_NAME_LEN  sizeof("Account 255")
+// Hardened indexes of 10 digits and their separators
+#define ACCOUNT_PATH_LEN (MAX_BIP32_PATH * sizeof("4294967295'/"))
+
 extern action_t approval_action;
 extern action_t rejection_action;
 
+static const account_path_t *reviewedAccounts;
+static char accountNames[ACCOUNTS_PER_PAGE][ACCOUNT_NAME_LEN];
+static char accountPaths[ACCOUNTS_PER_PAGE][ACCOUNT_PATH_LEN];
+static nbgl_contentTagValue_t accountPair = {0};
+static nbgl_contentTagValueList_t accountList = {0};
+
 // called when long press button on 3rd page is long-touched or when reject footer is touched
 static void review_choice(bool confirm) {
     if (confirm) {
@@ -48,6 +63,44 @@ void display_remote_account_confirmation_ui(action_t onApprove, action_t onRejec
                        review_choice);
 }
 
+// function called by NBGL to get the pair indexed by "index"
+static nbgl_contentTagValue_t *get_account_pair(uint8_t index) {
+    uint8_t slot = index % ACCOUNTS_PER_PAGE;
+    const account_path_t *account = &reviewedAccounts[index];
+
+    snprintf(accountNames[slot], ACCOUNT_NAME_LEN, "Account %d", index + 1);
+    if (!bip32_path_format(account->path, account->length, accountPaths[slot], ACCOUNT_PATH_LEN)) {
+        explicit_bzero(accountPaths[slot], ACCOUNT_PATH_LEN);
+    }
+
+    explicit_bzero(&accountPair, sizeof(nbgl_contentTagValue_t));
+    accountPair.item = accountNames[slot];
+    accountPair.value = accountPaths[slot];
+    accountPair.forcePageStart = slot == 0;
+    return &accountPair;
+}
+
+void display_remote_accounts_confirmation_ui(const account_path_t *accounts,
+                                             uint8_t count,
+                                             action_t onApprove,
+                                             action_t onReject) {
+    approval_action = onApprove;
+    rejection_action = onReject;
+    reviewedAccounts = accounts;
+
+    explicit_bzero(&accountList, sizeof(nbgl_contentTagValueList_t));
+    accountList.nbPairs = count;
+    accountList.callback = get_account_pair;
+
+    nbgl_useCaseReview(TYPE_OPERATION,
+                       &accountList,
+                       &ICON_APP_HOME,
+                       "Export delegated\nharvesting keys?",
+                       NULL,
+                       "Export keys",
+                       review_choice);
+}
+
 void display_remote_account_done(bool validated) {
     if (validated) {
         nbgl_useCaseStatus("KEY\nEXPORTED", true, display_idle_menu);
@@ -19,8 +19,19 @@
 #define LEDGER_APP_NEM_REMOTEUI_H
 
 #include "common.h"
+#include "limitations.h"
+
+typedef struct {
+    uint8_t length;
+    uint32_t path[MAX_BIP32_PATH];
+} account_path_t;
 
 void display_remote_account_confirmation_ui(action_t onApprove, action_t onReject);
+// Lists the paths of the accounts whose keys are exported, kept until the end of the review
+void display_remote_accounts_confirmation_ui(const account_path_t *accounts,
+                                             uint8_t count,
+                                             action_t onApprove,
+                                             action_t onReject);
 void display_remote_account_done(bool validated);
 
 #endif  // LEDGER_APP_NEM_REMOTEUI_H
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "review_arena.h"
+
+static char arena[REVIEW_ARENA_SIZE];
+// Pairs are formatted here, then copied to the arena with their actual length
+static char scratch[MAX_FIELD_LEN];
+
+static const result_t *reviewed;
+static uint8_t summaryPairs;
+static uint8_t pairCount;
+// Offset of each pair in the arena, known for the first laidOut pairs. Only the first pair of a
+// segment is at offset 0.
+static uint16_t offsets[REVIEW_MAX_PAIRS];
+static uint8_t laidOut;
+static uint16_t nextOffset;
+// Pairs [storedFirst, storedEnd[ of a same segment are in the arena
+static uint8_t storedFirst;
+static uint8_t storedEnd;
+
+uint8_t review_arena_init(const result_t *transaction) {
+    reviewed = transaction;
+    summaryPairs = get_summary_pair_count(&transaction->summary);
+    pairCount = get_review_pair_count(transaction);
+    laidOut = 0;
+    nextOffset = 0;
+    storedFirst = 0;
+    storedEnd = 0;
+    return pairCount;
+}
+
+// Formats a pair into the scratch buffer: its value, then the name of the parts of a message.
+// Returns the size of both with their terminators.
+static uint16_t format_pair(uint8_t index) {
+    review_pair_t pair;
+    if (!find_review_pair(reviewed, index, &pair)) {
+        memcpy(scratch, " ", 2);
+        return 2;
+    }
+    format_review_pair_value(reviewed, &pair, scratch);
+    uint16_t size = strnlen(scratch, MAX_FIELD_LEN - 1);
+    scratch[size++] = '\0';
+    if (pair.count > 1) {
+        // A part of a message is at most MESSAGE_CHUNK_LEN characters, its name fits after it
+        size += format_review_pair_name(&pair, scratch + size, MAX_FIELD_LEN - size) + 1;
+    }
+    return size;
+}
+
+// Places the next pair after the previous one, or at the beginning of the arena
+static uint16_t lay_out_next(void) {
+    uint16_t size = format_pair(laidOut);
+    if (nextOffset + size > REVIEW_ARENA_SIZE) {
+        nextOffset = 0;
+    }
+    offsets[laidOut++] = nextOffset;
+    nextOffset += size;
+    return size;
+}
+
+static bool starts_segment(uint8_t index) {
+    return offsets[index] == 0;
+}
+
+static void store(uint8_t index, uint16_t size) {
+    memcpy(arena + offsets[index], scratch, size);
+    // The pairs of a segment do not overlap: the stored range grows while it stays in it
+    if (storedFirst < storedEnd && index == storedEnd && !starts_segment(index)) {
+        storedEnd++;
+    } else if (storedFirst < storedEnd && index + 1 == storedFirst &&
+               !starts_segment(storedFirst)) {
+        storedFirst--;
+    } else {
+        storedFirst = index;
+        storedEnd = index + 1;
+    }
+}
+
+const char *review_arena_get_value(uint8_t index, const char **name, bool *pageStart) {
+    uint16_t size = 0;
+    // The layout is computed in order: the pairs before this one are only measured
+    while (laidOut <= index) {
+        size = lay_out_next();
+    }
+    if (size == 0 && (index < storedFirst || index >= storedEnd)) {
+        size = format_pair(index);
+    }
+    if (size != 0) {
+        store(index, size);
+    }
+
+    const char *value = arena + offsets[index];
+    review_pair_t pair;
+    if (!find_review_pair(reviewed, index, &pair)) {
+        *name = "";
+    } else if (pair.count > 1) {
+        *name = value + strlen(value) + 1;
+    } else if (pair.field != NULL) {
+        *name = get_fieldname(pair.field);
+    } else {
+        *name = get_summary_name(pair.index);
+    }
+    *pageStart = index > 0 && (starts_segment(index) || index == summaryPairs);
+    return value;
+}
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_REVIEW_ARENA_H
+#define LEDGER_APP_NEM_REVIEW_ARENA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nem_parse.h"
+#include "app_format.h"
+
+// Size of the arena holding the values of the displayed review pairs: a value of any length fits
+#define REVIEW_ARENA_SIZE MAX_FIELD_LEN
+
+/**
+ * Starts the review of a transaction, the values are formatted when they are requested.
+ *
+ * @param transaction parsed transaction, kept until the end of the review
+ * @return number of review pairs: the summary page when the transaction has one, then the
+ * fields, the long messages being split into several pairs
+ */
+uint8_t review_arena_init(const result_t *transaction);
+
+/**
+ * Formats a review pair into the arena.
+ *
+ * The values are packed one after the other in the arena. A value not fitting after the previous
+ * one starts a new segment at the beginning of the arena, and its pair must start a review page,
+ * so that the values of a displayed page are never overwritten. The segments only depend on the
+ * lengths of the values, the pages are the same each time NBGL computes them.
+ *
+ * @param index index of the pair, below the count returned by review_arena_init
+ * @param name set to the name of the pair: the field name, numbered for the parts of a message
+ * @param pageStart set to whether the pair must start a review page, the fields starting a page
+ * after the summary
+ * @return value of the pair, valid with its name as long as only pairs of its segment are
+ * requested
+ */
+const char *review_arena_get_value(uint8_t index, const char **name, bool *pageStart);
+
+#endif  // LEDGER_APP_NEM_REVIEW_ARENA_H
@@ -22,7 +22,7 @@
 #include "common.h"
 #include "os.h"
 #include "fields.h"
-#include "app_format.h"
+#include "review_arena.h"
 #include "idle_menu.h"
 #include "nbgl_use_case.h"
 #include "display.h"
@@ -33,21 +33,6 @@ result_action_t approval_menu_callback;
 static nbgl_contentTagValue_t pair = {0};
 static nbgl_contentTagValueList_t pairList = {0};
 
-// Stax geometry (TAG_VALUE_AREA_HEIGHT=548px, margins=12px, fonts=68px/pair)
-// fits up to 6 pairs per page, exceeding NB_MAX_DISPLAYED_PAIRS_IN_REVIEW=4.
-#ifdef TARGET_STAX
-#define MAX_TAG_VALUE_PAIRS_DISPLAYED 7
-#else
-#define MAX_TAG_VALUE_PAIRS_DISPLAYED NB_MAX_DISPLAYED_PAIRS_IN_REVIEW
-#endif
-
-typedef struct review_argument_t {
-    char name[MAX_FIELDNAME_LEN];
-    char value[MAX_FIELD_LEN];
-} review_argument_t;
-
-static review_argument_t bkp_args[MAX_TAG_VALUE_PAIRS_DISPLAYED];
-
 // called when long press button on 3rd page is long-touched or when reject footer is touched
 static void review_choice(bool confirm) {
     approval_menu_callback(confirm ? OPTION_SIGN : OPTION_REJECT);
@@ -55,19 +40,17 @@ static void review_choice(bool confirm) {
 
 // function called by NBGL to get the pair indexed by "index"
 static nbgl_contentTagValue_t *get_review_pair(uint8_t index) {
-    const field_t *field = &transaction->fields[index];
-
-    // Backup review argument as MAX_TAG_VALUE_PAIRS_DISPLAYED can be displayed
-    // simultaneously and their content must be store on app side buffer as
-    // only the buffer pointer is copied by the SDK and not the buffer content.
-    uint8_t bkp_index = index % MAX_TAG_VALUE_PAIRS_DISPLAYED;
-
-    resolve_fieldname(field, bkp_args[bkp_index].name);
-    format_field(field, bkp_args[bkp_index].value);
+    // Only the value pointer is copied by the SDK: the values of the displayed page are kept in
+    // the arena, which forces a new page when they do not fit together.
+    // Long messages are split into several pairs, named after their part.
+    const char *name;
+    bool pageStart;
+    const char *value = review_arena_get_value(index, &name, &pageStart);
 
     explicit_bzero(&pair, sizeof(nbgl_contentTagValue_t));
-    pair.item = bkp_args[bkp_index].name;
-    pair.value = bkp_args[bkp_index].value;
+    pair.item = name;
+    pair.value = value;
+    pair.forcePageStart = pageStart;
 
     PRINTF("\nPair %d - Title: %s - Value: %s\n", index, pair.item, pair.value);
 
@@ -79,7 +62,7 @@ void display_review_menu(result_t *transactionParam, result_action_t callback) {
     approval_menu_callback = callback;
 
     explicit_bzero(&pairList, sizeof(nbgl_contentTagValueList_t));
-    pairList.nbPairs = transaction->numFields;
+    pairList.nbPairs = review_arena_init(transaction);
     pairList.callback = get_review_pair;
 
     nbgl_useCaseReview(TYPE_TRANSACTION,
@@ -98,3 +81,9 @@ void display_review_done(bool validated) {
         nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_REJECTED, display_idle_menu);
     }
 }
+
+#ifdef HAVE_SWAP
+void display_swap_signing(void) {
+    nbgl_useCaseSpinner("Signing transaction");
+}
+#endif
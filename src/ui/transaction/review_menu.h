@@ -25,5 +25,9 @@
 
 void display_review_menu(result_t *transactionParam, result_action_t callback);
 void display_review_done(bool validated);
+#ifdef HAVE_SWAP
+// Shown while a swap transaction, reviewed in the exchange application, is received and signed
+void display_swap_signing(void);
+#endif
 
 #endif  // LEDGER_APP_NEM_REVIEWMENU_H
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""RAM and flash footprint of the application, by subsystem, with a regression gate.
+
+Reads the symbols of the linked application and attributes each one to the object file defining
+it, then to a subsystem through the source path prefixes of footprint.json (application sources
+not matched, SDK and libc objects go to the default subsystem). Prints the size of each subsystem
+per section class (text, rodata, data, bss, nvm) and its largest symbols.
+
+The section totals are compared with baseline_<device>.json: the report fails when a class grows
+by more than its tolerance. Without baseline the footprint is reported and never fails.
+"""
+
+import argparse
+import json
+import re
+import shutil
+import subprocess
+import sys
+import tomllib
+from collections import defaultdict
+from pathlib import Path
+
+ROOT_DIR = Path(__file__).resolve().parent.parent.parent
+BASELINE_DIR = Path(__file__).resolve().parent
+# Build directory of each device of ledger_app.toml, as named by the SDK
+BUILD_TARGETS = {"nanox": "nanox", "nanos+": "nanos2", "stax": "stax", "flex": "flex", "apex_p": "apex_p"}
+CLASSES = ("text", "rodata", "data", "bss", "nvm")
+# Flash holds the code, the constants, the initial values of the data and the NVM storage
+FLASH_CLASSES = ("text", "rodata", "data", "nvm")
+RAM_CLASSES = ("data", "bss")
+
+READELF = shutil.which("llvm-readelf") or "readelf"
+# "  [15] .text  PROGBITS  0000000000005320 005320 01499b 00  AX  0   0 16"
+SECTION_RE = re.compile(r"^\s*\[\s*(\d+)\]\s+(\S+)\s+(\S+)\s+[0-9a-f]+\s+[0-9a-f]+\s+([0-9a-f]+)\s+[0-9a-f]+\s+(\S*)\s+\d+")
+
+
+def readelf(*args):
+    return subprocess.run([READELF, *args], capture_output=True, text=True, check=True).stdout
+
+
+def section_class(name, section_type, flags):
+    """Class of an allocated section, None for the others."""
+    if "A" not in flags:
+        return None
+    if "nvm" in name:
+        return "nvm"
+    if name == ".stack":
+        return None
+    if section_type == "NOBITS":
+        return "bss"
+    if "X" in flags:
+        return "text"
+    return "data" if "W" in flags else "rodata"
+
+
+def parse_sections(elf):
+    """Class and size of each allocated section, by section index."""
+    sections = {}
+    for line in readelf("-SW", str(elf)).splitlines():
+        match = SECTION_RE.match(line)
+        if match is None:
+            continue
+        index, name, section_type, size, flags = match.groups()
+        cls = section_class(name, section_type, flags)
+        if cls is not None:
+            sections[index] = (name, cls, int(size, 16))
+    return sections
+
+
+def parse_symbols(path):
+    """(name, size, section index) of the sized object and function symbols of an ELF file."""
+    symbols = []
+    for line in readelf("-sW", str(path)).splitlines():
+        fields = line.split()
+        # Num: Value Size Type Bind Vis Ndx Name
+        if len(fields) < 8 or fields[3] not in ("FUNC", "OBJECT") or fields[6] == "UND":
+            continue
+        size = int(fields[2], 0)
+        if size:
+            symbols.append((fields[7], size, fields[6]))
+    return symbols
+
+
+def source_path(obj, obj_dir, sources):
+    """Application source compiled into the object file, None for the others."""
+    relative = obj.relative_to(obj_dir).as_posix()
+    # obj/app/src/ui/foo.o, CMakeFiles/x.dir/__/__/src/ui/foo.c.o
+    stem = obj.name.removesuffix(".o").removesuffix(".c")
+    candidates = [source for source in sources if source.stem == stem]
+    if any(part.startswith(("lib_", "sdk")) for part in relative.split("/")[:-1]):
+        return None
+    for source in candidates:
+        if relative.endswith(source.with_suffix("").as_posix() + ".o") or relative.endswith(source.as_posix() + ".o"):
+            return source
+    # Objects named after the source file only
+    return candidates[0] if len(candidates) == 1 and "/" not in relative.removeprefix("app/") else None
+
+
+def subsystem(source, config):
+    if source is None:
+        return config["default"]
+    prefixes = [prefix for prefix in config["subsystems"] if source.as_posix().startswith(prefix)]
+    return config["subsystems"][max(prefixes, key=len)] if prefixes else config["default"]
+
+
+def symbol_subsystems(obj_dir, config):
+    """Subsystems of the symbols defined by the object files, keyed by (name, size)."""
+    sources = [path.relative_to(ROOT_DIR) for path in (ROOT_DIR / "src").rglob("*.c")]
+    owners = defaultdict(set)
+    for obj in Path(obj_dir).rglob("*.o"):
+        name = subsystem(source_path(obj, obj_dir, sources), config)
+        for symbol, size, _ in parse_symbols(obj):
+            owners[(symbol, size)].add(name)
+    return owners
+
+
+def footprint(elf, obj_dir, config):
+    sections = parse_sections(elf)
+    owners = symbol_subsystems(obj_dir, config)
+    totals = dict.fromkeys(CLASSES, 0)
+    for _, cls, size in sections.values():
+        totals[cls] += size
+    subsystems = defaultdict(lambda: {"sizes": dict.fromkeys(CLASSES, 0), "symbols": []})
+    for name, size, index in parse_symbols(elf):
+        if index not in sections:
+            continue
+        cls = sections[index][1]
+        # A static name defined in several subsystems stays unattributed
+        candidates = owners.get((name, size), set())
+        owner = next(iter(candidates)) if len(candidates) == 1 else config["default"]
+        subsystems[owner]["sizes"][cls] += size
+        subsystems[owner]["symbols"].append({"name": name, "class": cls, "size": size})
+    for entry in subsystems.values():
+        entry["symbols"].sort(key=lambda symbol: -symbol["size"])
+    return {
+        "totals": totals,
+        "flash": sum(totals[cls] for cls in FLASH_CLASSES),
+        "ram": sum(totals[cls] for cls in RAM_CLASSES),
+        "subsystems": dict(sorted(subsystems.items())),
+    }
+
+
+def print_report(device, report, top):
+    print(f"== {device}: flash {report['flash']} B, ram {report['ram']} B (without stack)")
+    print(f"{'subsystem':<16}" + "".join(f"{cls:>9}" for cls in CLASSES))
+    for name, entry in report["subsystems"].items():
+        print(f"{name:<16}" + "".join(f"{entry['sizes'][cls]:>9}" for cls in CLASSES))
+    print(f"{'sections':<16}" + "".join(f"{report['totals'][cls]:>9}" for cls in CLASSES))
+    for name, entry in report["subsystems"].items():
+        if top and entry["symbols"]:
+            largest = ", ".join(f"{s['name']} {s['size']} ({s['class']})" for s in entry["symbols"][:top])
+            print(f"  {name}: {largest}")
+
+
+def check_baseline(device, report, config, baseline_path):
+    """Number of section classes grown beyond their tolerance."""
+    if not baseline_path.exists():
+        print(f"no baseline {baseline_path.name}, not checked")
+        return 0
+    with open(baseline_path, encoding="utf-8") as f:
+        baseline = json.load(f)
+    failures = 0
+    for cls, tolerance in config["tolerance"].items():
+        growth = report["totals"][cls] - baseline[cls]
+        over = growth > tolerance
+        failures += over
+        status = "FAIL" if over else "ok"
+        print(f"{device} {cls}: {baseline[cls]} -> {report['totals'][cls]} ({growth:+} B, tolerance {tolerance}) {status}")
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--elf", type=Path, help="Linked application, with --obj-dir and --device")
+    parser.add_argument("--obj-dir", type=Path, help="Directory searched for the object files of the application")
+    parser.add_argument("--device", help="Device of the build, selects the baseline")
+    parser.add_argument("--build-dir", type=Path, default=ROOT_DIR / "build",
+                        help="Report every device of ledger_app.toml built there")
+    parser.add_argument("--config", type=Path, default=Path(__file__).parent / "footprint.json", help="Subsystems and tolerances")
+    parser.add_argument("--top", type=int, default=5, help="Largest symbols printed per subsystem")
+    parser.add_argument("--update-baseline", action="store_true", help="Write the section totals as the new baselines")
+    parser.add_argument("--json", type=Path, help="Also write the report to this JSON file")
+    args = parser.parse_args()
+
+    with open(args.config, encoding="utf-8") as f:
+        config = json.load(f)
+
+    if args.elf is not None:
+        if args.obj_dir is None or args.device is None:
+            parser.error("--elf needs --obj-dir and --device")
+        builds = {args.device: (args.elf, args.obj_dir)}
+    else:
+        with open(ROOT_DIR / "ledger_app.toml", "rb") as f:
+            devices = tomllib.load(f)["app"]["devices"]
+        builds = {}
+        for device in devices:
+            target_dir = args.build_dir / BUILD_TARGETS[device]
+            if (target_dir / "bin" / "app.elf").exists():
+                builds[BUILD_TARGETS[device]] = (target_dir / "bin" / "app.elf", target_dir / "obj")
+            else:
+                print(f"{device}: no build in {target_dir}, skipped")
+        if not builds:
+            sys.exit(f"No build in {args.build_dir}")
+
+    reports = {}
+    failures = 0
+    for device, (elf, obj_dir) in builds.items():
+        report = footprint(elf, obj_dir, config)
+        reports[device] = report
+        print_report(device, report, args.top)
+        baseline_path = BASELINE_DIR / f"baseline_{device}.json"
+        if args.update_baseline:
+            with open(baseline_path, "w", encoding="utf-8") as f:
+                json.dump(report["totals"], f, indent=2)
+                f.write("\n")
+            print(f"baseline written to {baseline_path.name}")
+        else:
+            failures += check_baseline(device, report, config, baseline_path)
+
+    if args.json is not None:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(reports, f, indent=2)
+            f.write("\n")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,8 +1,9 @@
 from base64 import b32encode
 from collections.abc import Generator
 from contextlib import contextmanager
+from dataclasses import dataclass
 from enum import IntEnum
-from struct import pack
+from struct import pack, unpack
 
 from bip_utils.utils.crypto.ripemd import Ripemd160  # type: ignore
 from bip_utils.utils.crypto.sha3 import Kekkak256  # type: ignore
@@ -21,6 +22,8 @@ class INS(IntEnum):
     INS_SIGN = 0x04
     INS_GET_REMOTE_ACCOUNT = 0x05
     INS_GET_APP_CONFIGURATION = 0x06
+    INS_PARSE_TRANSACTION = 0x07
+    INS_GET_REMOTE_ACCOUNTS = 0x08
 
 
 CLA = 0xE0
@@ -33,10 +36,28 @@ P1_MASK_ORDER = 0x01
 P1_MASK_MORE = 0x80
 P2_SECP256K1 = 0x40
 P2_ED25519 = 0x80
+P1_APP_VERSION = 0x00
+P1_APP_CAPABILITIES = 0x01
+P1_MORE_FIELDS = 0x02
+P1_MORE_KEYS = 0x02
 
 STATUS_OK = 0x9000
 
 MAX_CHUNK_SIZE = 255
+MAX_REMOTE_ACCOUNTS = 64
+
+# Optional features reported by GET_APP_CONFIGURATION (bitmask)
+FEATURE_REMOTE_KEY_CACHE = 0x00000001
+# Transaction types signed by the build, reported by GET_APP_CONFIGURATION (bitmask)
+TX_TYPE_MASK_TRANSFER = 0x0001
+TX_TYPE_MASK_ALL = 0x00FF
+
+TAG_FIELD_ID = 0x01
+TAG_FIELD_TYPE = 0x02
+TAG_FIELD_NAME = 0x03
+TAG_FIELD_VALUE = 0x04
+# Field id of the summary pairs in the PARSE_TRANSACTION field list
+SUMMARY_FIELD_ID = 0x00
 
 
 class ErrorType:
@@ -48,6 +69,26 @@ class ErrorType:
     SW_CLA_NOT_SUPPORTED = 0x6E00
 
 
+@dataclass
+class AppCapabilities:
+    version: tuple[int, int, int]
+    protocol_version: int
+    max_raw_tx: int
+    max_field_count: int
+    chunk_size: int
+    features: int
+    supported_ins: list[int]
+    tx_types: int
+
+
+@dataclass
+class ParsedField:
+    id: int
+    type: int
+    name: str
+    value: str
+
+
 class NemClient:
     def __init__(self, backend: BackendInterface):
         self._backend = backend
@@ -66,6 +107,33 @@ class NemClient:
         patch = int(response[3])
         return (major, minor, patch)
 
+    def send_get_app_capabilities(self) -> AppCapabilities:
+        rapdu: RAPDU = self._backend.exchange(CLA, INS.INS_GET_APP_CONFIGURATION, P1_APP_CAPABILITIES, 0, b"")
+        response = rapdu.data
+        # response = 0x00 (1) ||
+        #            MAJOR_VERSION (1) || MINOR_VERSION (1) || PATCH_VERSION (1) ||
+        #            PROTOCOL_VERSION (1) ||
+        #            MAX_RAW_TX (2, big endian) ||
+        #            MAX_FIELD_COUNT (1) ||
+        #            CHUNK_SIZE (1) ||
+        #            FEATURES (4, big endian) ||
+        #            INS_COUNT (1) || INS (INS_COUNT) ||
+        #            TX_TYPES (2, big endian)
+        assert len(response) >= 15
+        assert int(response[0]) == 0
+        ins_count = response[14]
+        assert len(response) == 15 + ins_count + 2
+        return AppCapabilities(
+            version=(response[1], response[2], response[3]),
+            protocol_version=response[4],
+            max_raw_tx=unpack(">H", response[5:7])[0],
+            max_field_count=response[7],
+            chunk_size=response[8],
+            features=unpack(">I", response[9:13])[0],
+            supported_ins=list(response[15 : 15 + ins_count]),
+            tx_types=unpack(">H", response[15 + ins_count :])[0],
+        )
+
     def compute_adress_from_public_key(self, public_key: bytes, network_type: int = MAINNET) -> str:
         assert network_type in [TESTNET, MAINNET]
         buffer1 = Kekkak256.QuickDigest(public_key)
@@ -125,6 +193,38 @@ class NemClient:
         with self._backend.exchange_async(CLA, INS.INS_GET_REMOTE_ACCOUNT, p1, p2, payload):
             yield
 
+    def _remote_accounts_p1(self, first: bool, last: bool) -> int:
+        p1 = 0
+        if not first:
+            p1 |= P1_MASK_ORDER
+        if not last:
+            p1 |= P1_MASK_MORE
+        return p1
+
+    @contextmanager
+    def send_async_get_remote_accounts(self, derivation_paths: list[str]) -> Generator[None, None, None]:
+        # Each block holds whole paths: path length (1) || path (4 per level)
+        messages = [b""]
+        for derivation_path in derivation_paths:
+            path = pack_derivation_path(derivation_path)
+            if len(messages[-1]) + len(path) > MAX_CHUNK_SIZE:
+                messages.append(b"")
+            messages[-1] += path
+
+        for i, m in enumerate(messages[:-1]):
+            self._backend.exchange(CLA, INS.INS_GET_REMOTE_ACCOUNTS, self._remote_accounts_p1(i == 0, False), 0, m)
+        p1 = self._remote_accounts_p1(len(messages) == 1, True)
+        with self._backend.exchange_async(CLA, INS.INS_GET_REMOTE_ACCOUNTS, p1, 0, messages[-1]):
+            yield
+
+    def get_remote_accounts_keys(self, response: bytes) -> list[bytes]:
+        # Each response = more flag (1) || (delegated_harvesting_key_len (1) || delegated_harvesting_key (32))...
+        stream = response[1:]
+        while response[0] == 0x01:
+            response = self._backend.exchange(CLA, INS.INS_GET_REMOTE_ACCOUNTS, P1_MORE_KEYS, 0, b"").data
+            stream += response[1:]
+        return [self.parse_get_remote_account_response(stream[i : i + 1 + 32]) for i in range(0, len(stream), 1 + 32)]
+
     def _send_sign_message(self, message: bytes, first: bool, last: bool) -> RAPDU:
         p1 = 0
         if not first:
@@ -159,3 +259,48 @@ class NemClient:
 
     def get_async_response(self) -> RAPDU | None:
         return self._backend.last_async_response
+
+    def _send_parse_message(self, message: bytes, first: bool, last: bool) -> RAPDU:
+        p1 = 0
+        if not first:
+            p1 |= P1_MASK_ORDER
+        if not last:
+            p1 |= P1_MASK_MORE
+        return self._backend.exchange(CLA, INS.INS_PARSE_TRANSACTION, p1, 0, message)
+
+    def send_parse_transaction(self, derivation_path: str, message: bytes) -> list[ParsedField]:
+        messages = split_message(pack_derivation_path(derivation_path) + message, MAX_CHUNK_SIZE)
+        for i, m in enumerate(messages):
+            rapdu = self._send_parse_message(m, i == 0, i == len(messages) - 1)
+
+        # Each response = more flag (1) || slice of the field stream
+        stream = rapdu.data[1:]
+        while rapdu.data[0] == 0x01:
+            rapdu = self._backend.exchange(CLA, INS.INS_PARSE_TRANSACTION, P1_MORE_FIELDS, 0, b"")
+            stream += rapdu.data[1:]
+        return self.parse_fields_stream(stream)
+
+    def parse_fields_stream(self, stream: bytes) -> list[ParsedField]:
+        # stream = number of review pairs (1) ||
+        #          for each pair: TLV(id) || TLV(type) || TLV(name) || TLV(value)
+        # with TLV = tag (1) || length (2, big endian) || value
+        num_fields = stream[0]
+        offset = 1
+        fields = []
+        for _ in range(num_fields):
+            record = {}
+            for tag in (TAG_FIELD_ID, TAG_FIELD_TYPE, TAG_FIELD_NAME, TAG_FIELD_VALUE):
+                assert stream[offset] == tag
+                length = unpack(">H", stream[offset + 1 : offset + 3])[0]
+                record[tag] = stream[offset + 3 : offset + 3 + length]
+                offset += 3 + length
+            fields.append(
+                ParsedField(
+                    id=record[TAG_FIELD_ID][0],
+                    type=record[TAG_FIELD_TYPE][0],
+                    name=record[TAG_FIELD_NAME].decode("utf-8"),
+                    value=record[TAG_FIELD_VALUE].decode("utf-8"),
+                )
+            )
+        assert offset == len(stream)
+        return fields
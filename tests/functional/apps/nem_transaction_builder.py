@@ -8,7 +8,7 @@
 # Examples can be found in the tests/corpus directory.
 # Maybe its readability could by improved by introducing more enums for network values, payload types, etc..
 
-from struct import pack
+from struct import Struct
 
 UINT32_MAX = 0xFFFFFFFF
 
@@ -23,214 +23,236 @@ TRANSACTION_TYPES = {
     "MOSAIC_SUPPLY_CHANGE": 0x4002,
 }
 
+ADDRESS_LENGTH = 40
+PUBLIC_KEY_LENGTH = 32
+
+# Precompiled layouts of the packed structures of src/nem/parse/nem_parse.c.
+# An address is prefixed with its length (always 40), a public key with its length (always 32).
+UINT8 = Struct("<B")
+UINT16 = Struct("<H")
+UINT32 = Struct("<I")
+UINT64 = Struct("<Q")
+# common_txn_header_t: type, version, reserved, network, timestamp, public key, fee, deadline
+COMMON_TXN_HEADER = Struct("<IBHBII32sQI")
+# transfer_txn_header_t: recipient, amount, message length
+TRANSFER_TXN_HEADER = Struct("<I40sQI")
+# importance_txn_header_t: mode, remote public key
+IMPORTANCE_TXN_HEADER = Struct("<II32s")
+# aggregate_modication_header_t: structure length, modification type, cosignatory public key
+AGGREGATE_MODIFICATION_HEADER = Struct("<III32s")
+# multsig_signature_header_t: hash object length, hash, multisig account address
+MULTISIG_SIGNATURE_HEADER = Struct("<II32sI40s")
+# rental_header_t: sink address, rental fee
+RENTAL_HEADER = Struct("<I40sQ")
+# levy_structure_t: fee type, sink address, mosaic id structure length
+LEVY_STRUCTURE = Struct("<II40sI")
+# mosaic_definition_sink_t: sink address, creation fee
+MOSAIC_DEFINITION_SINK = Struct("<I40sQ")
+
 
 def write_uint8_t(value):
-    return pack("<B", value)
+    return UINT8.pack(value)
 
 
 def write_uint16_t(value):
-    return pack("<H", value)
+    return UINT16.pack(value)
 
 
 def write_uint32_t(value):
-    return pack("<I", value)
+    return UINT32.pack(value)
 
 
 def write_uint64_t(value):
-    return pack("<Q", value)
+    return UINT64.pack(value)
 
 
 def write_len_prefixed_string(string):
-    data = write_uint32_t(len(string))
-    data += string.encode("utf-8")
+    data = string.encode("utf-8")
+    return UINT32.pack(len(data)) + data
+
+
+def address_bytes(address):
+    data = address.encode("utf-8")
+    assert len(data) == ADDRESS_LENGTH, f"invalid address {address}"
     return data
 
 
-def write_address(address):
-    data = write_uint32_t(40)
-    data += address.encode("utf-8")
+def public_key_bytes(public_key):
+    data = bytes.fromhex(public_key)
+    assert len(data) == PUBLIC_KEY_LENGTH, f"invalid public key {public_key}"
     return data
 
 
+def write_address(address):
+    return UINT32.pack(ADDRESS_LENGTH) + address_bytes(address)
+
+
 def write_public_key(public_key):
-    data = write_uint32_t(32)
-    data += bytes.fromhex(public_key)
-    return data
+    return UINT32.pack(PUBLIC_KEY_LENGTH) + public_key_bytes(public_key)
+
+
+def write_mosaic_id(namespace, mosaic_name):
+    mosaicId_data = write_len_prefixed_string(namespace) + write_len_prefixed_string(mosaic_name)
+    return UINT32.pack(len(mosaicId_data)) + mosaicId_data
 
 
 def encode_common_txn_header(header):
-    data = write_uint32_t(TRANSACTION_TYPES[header["transactionType"]])
-    data += write_uint8_t(header["version"])
-    data += write_uint16_t(0)  # reserved
-    data += write_uint8_t(header["networkType"])
-    data += write_uint32_t(header["timestamp"])
-    data += write_public_key(header["public_key"])
-    data += write_uint64_t(header["fee"])
-    data += write_uint32_t(header["deadline"])
+    data = COMMON_TXN_HEADER.pack(
+        TRANSACTION_TYPES[header["transactionType"]],
+        header["version"],
+        0,  # reserved
+        header["networkType"],
+        header["timestamp"],
+        PUBLIC_KEY_LENGTH,
+        public_key_bytes(header["public_key"]),
+        header["fee"],
+        header["deadline"],
+    )
     return data, header["transactionType"], header["version"]
 
 
 def encode_transfer_transaction(fields, version):
-    data = write_address(fields["recipient"])
-    data += write_uint64_t(fields["amount"])
-
     payload = fields.get("payload", None)
     if not payload:
         payload_data = b""
     else:
         payload = bytes.fromhex(payload)
-        payload_data = write_uint32_t(fields["payloadType"])
-        payload_data += write_uint32_t(len(payload))
-        payload_data += payload
-    data += write_uint32_t(len(payload_data))
-    data += payload_data
+        payload_data = UINT32.pack(fields["payloadType"]) + UINT32.pack(len(payload)) + payload
+    parts = [
+        TRANSFER_TXN_HEADER.pack(ADDRESS_LENGTH, address_bytes(fields["recipient"]), fields["amount"], len(payload_data)),
+        payload_data,
+    ]
 
     if version == 2:
         mosaic_list = fields.get("mosaicList", [])
-        data += write_uint32_t(len(mosaic_list))
+        parts.append(UINT32.pack(len(mosaic_list)))
         for mosaic in mosaic_list:
-            mosaicId_data = write_len_prefixed_string(mosaic["namespace"])
-            mosaicId_data += write_len_prefixed_string(mosaic["mosaicName"])
-
-            mosaic_data = write_uint32_t(len(mosaicId_data))
-            mosaic_data += mosaicId_data
-            mosaic_data += write_uint64_t(mosaic["quantity"])
-
-            data += write_uint32_t(len(mosaic_data))
-            data += mosaic_data
-    return data
+            mosaic_data = write_mosaic_id(mosaic["namespace"], mosaic["mosaicName"]) + UINT64.pack(mosaic["quantity"])
+            parts.append(UINT32.pack(len(mosaic_data)))
+            parts.append(mosaic_data)
+    return b"".join(parts)
 
 
 def encode_importance_transfer_transaction(fields):
-    data = write_uint32_t(fields["iMode"])
-    data += write_public_key(fields["iPublicKey"])
-    return data
+    return IMPORTANCE_TXN_HEADER.pack(fields["iMode"], PUBLIC_KEY_LENGTH, public_key_bytes(fields["iPublicKey"]))
 
 
 def encode_aggregate_modification_transaction(fields, version):
     cm_list = fields["cmList"]
-    data = write_uint32_t(len(cm_list))
+    parts = [UINT32.pack(len(cm_list))]
     for cm in cm_list:
-        data += write_uint32_t(cm["cmsLen"])  # not used?
-        data += write_uint32_t(cm["amType"])
-        data += write_public_key(cm["amPublicKey"])
+        # cmsLen: not used?
+        parts.append(
+            AGGREGATE_MODIFICATION_HEADER.pack(cm["cmsLen"], cm["amType"], PUBLIC_KEY_LENGTH, public_key_bytes(cm["amPublicKey"]))
+        )
 
     if version == 2:
-        data += write_uint32_t(fields["cmLen"])  # only 0 or != 0 used
+        parts.append(UINT32.pack(fields["cmLen"]))  # only 0 or != 0 used
         if fields["cmLen"] > 0:
-            data += write_uint32_t(fields["minCm"])
-    return data
+            parts.append(UINT32.pack(fields["minCm"]))
+    return b"".join(parts)
 
 
 def encode_multisig_signature_transaction(fields):
-    data = write_uint32_t(fields["hashObjLen"])  # not used?
     hashdata = bytes.fromhex(fields["hash"])
-    data += write_uint32_t(len(hashdata))
-    data += hashdata
-    data += write_address(fields["msAddress"])
-
-    data += encode_multisig_transaction(fields)
-    return data
+    if len(hashdata) == 32:
+        data = MULTISIG_SIGNATURE_HEADER.pack(
+            fields["hashObjLen"], len(hashdata), hashdata, ADDRESS_LENGTH, address_bytes(fields["msAddress"])
+        )
+    else:
+        # Not the fixed size layout of the application
+        data = UINT32.pack(fields["hashObjLen"]) + UINT32.pack(len(hashdata)) + hashdata + write_address(fields["msAddress"])
+    return data + encode_multisig_transaction(fields)
 
 
 def encode_provision_namespace_transaction(fields):
-    data = write_address(fields["rAddress"])
-    data += write_uint64_t(fields["rentalFee"])
-
-    data += write_len_prefixed_string(fields["namespace"])
+    parts = [
+        RENTAL_HEADER.pack(ADDRESS_LENGTH, address_bytes(fields["rAddress"]), fields["rentalFee"]),
+        write_len_prefixed_string(fields["namespace"]),
+    ]
     if "parentNamespace" in fields:
-        data += write_len_prefixed_string(fields["parentNamespace"])
+        parts.append(write_len_prefixed_string(fields["parentNamespace"]))
     else:
-        data += write_uint32_t(UINT32_MAX)
-    return data
+        parts.append(UINT32.pack(UINT32_MAX))
+    return b"".join(parts)
 
 
 def encode_mosaic_definition_creation_transaction(fields):
-    mds_data = write_public_key(fields["mdcPublicKey"])
-
-    mosaicId_data = write_len_prefixed_string(fields["namespace"])
-    mosaicId_data += write_len_prefixed_string(fields["mosaicName"])
-    mds_data += write_uint32_t(len(mosaicId_data))
-    mds_data += mosaicId_data
-
-    mds_data += write_len_prefixed_string(fields["description"])
+    mds_parts = [
+        write_public_key(fields["mdcPublicKey"]),
+        write_mosaic_id(fields["namespace"], fields["mosaicName"]),
+        write_len_prefixed_string(fields["description"]),
+    ]
 
     properties = fields.get("properties", [])
-    mds_data += write_uint32_t(len(properties))
+    mds_parts.append(UINT32.pack(len(properties)))
     for pro in properties:
-        pro_data = write_len_prefixed_string(pro["propertyName"])
-        pro_data += write_len_prefixed_string(pro["propertyVal"])
-
-        mds_data += write_uint32_t(len(pro_data))
-        mds_data += pro_data
+        pro_data = write_len_prefixed_string(pro["propertyName"]) + write_len_prefixed_string(pro["propertyVal"])
+        mds_parts.append(UINT32.pack(len(pro_data)))
+        mds_parts.append(pro_data)
 
     levy = fields.get("levy", {})
     if levy:
-        levy_data = write_uint32_t(levy["feeType"])
-        levy_data += write_address(levy["lsAddress"])
-
-        mosaicId_data = write_len_prefixed_string(levy["namespace"])
-        mosaicId_data += write_len_prefixed_string(levy["mosaicName"])
-        levy_data += write_uint32_t(len(mosaicId_data))
-        levy_data += mosaicId_data
-
-        levy_data += write_uint64_t(levy["fee"])
-
-        mds_data += write_uint32_t(len(levy_data))
-        mds_data += levy_data
+        mosaicId_data = write_mosaic_id(levy["namespace"], levy["mosaicName"])
+        levy_data = (
+            LEVY_STRUCTURE.pack(levy["feeType"], ADDRESS_LENGTH, address_bytes(levy["lsAddress"]), len(mosaicId_data) - 4)
+            + mosaicId_data[4:]
+            + UINT64.pack(levy["fee"])
+        )
+        mds_parts.append(UINT32.pack(len(levy_data)))
+        mds_parts.append(levy_data)
     else:
-        mds_data += write_uint32_t(0)
-
-    data = write_uint32_t(len(mds_data))
-    data += mds_data
+        mds_parts.append(UINT32.pack(0))
 
-    data += write_address(fields["mdAddress"])
-    data += write_uint64_t(fields["mdfee"])
-    return data
+    mds_data = b"".join(mds_parts)
+    return b"".join(
+        [
+            UINT32.pack(len(mds_data)),
+            mds_data,
+            MOSAIC_DEFINITION_SINK.pack(ADDRESS_LENGTH, address_bytes(fields["mdAddress"]), fields["mdfee"]),
+        ]
+    )
 
 
 def encode_mosaic_supply_change_transaction(fields):
-    mosaicId_data = write_len_prefixed_string(fields["namespace"])
-    mosaicId_data += write_len_prefixed_string(fields["mosaicName"])
-    data = write_uint32_t(len(mosaicId_data))
-    data += mosaicId_data
-
-    data += write_uint32_t(fields["supplyType"])
-    data += write_uint64_t(fields["supplyDelta"])
-    return data
+    return b"".join(
+        [
+            write_mosaic_id(fields["namespace"], fields["mosaicName"]),
+            UINT32.pack(fields["supplyType"]),
+            UINT64.pack(fields["supplyDelta"]),
+        ]
+    )
 
 
 def encode_multisig_transaction(fields):
-    subdata = b""
-    for transaction in fields["transactions"]:
-        subdata += encode_txn_context(transaction)
-
-    data = write_uint32_t(len(subdata))
-    data += subdata
-    return data
+    subdata = b"".join(encode_txn_context(transaction) for transaction in fields["transactions"])
+    return UINT32.pack(len(subdata)) + subdata
+
+
+ENCODERS = {
+    "TRANSFER": encode_transfer_transaction,
+    "IMPORTANCE_TRANSFER": lambda fields, _: encode_importance_transfer_transaction(fields),
+    "MULTISIG_AGGREGATE_MODIFICATION": encode_aggregate_modification_transaction,
+    "MULTISIG_SIGNATURE": lambda fields, _: encode_multisig_signature_transaction(fields),
+    "MULTISIG": lambda fields, _: encode_multisig_transaction(fields),
+    "PROVISION_NAMESPACE": lambda fields, _: encode_provision_namespace_transaction(fields),
+    "MOSAIC_DEFINITION": lambda fields, _: encode_mosaic_definition_creation_transaction(fields),
+    "MOSAIC_SUPPLY_CHANGE": lambda fields, _: encode_mosaic_supply_change_transaction(fields),
+}
 
 
 def encode_txn_detail(fields, transaction_type, version):
-    if transaction_type == "TRANSFER":
-        return encode_transfer_transaction(fields, version)
-    if transaction_type == "IMPORTANCE_TRANSFER":
-        return encode_importance_transfer_transaction(fields)
-    if transaction_type == "MULTISIG_AGGREGATE_MODIFICATION":
-        return encode_aggregate_modification_transaction(fields, version)
-    if transaction_type == "MULTISIG_SIGNATURE":
-        return encode_multisig_signature_transaction(fields)
-    if transaction_type == "MULTISIG":
-        return encode_multisig_transaction(fields)
-    if transaction_type == "PROVISION_NAMESPACE":
-        return encode_provision_namespace_transaction(fields)
-    if transaction_type == "MOSAIC_DEFINITION":
-        return encode_mosaic_definition_creation_transaction(fields)
-    if transaction_type == "MOSAIC_SUPPLY_CHANGE":
-        return encode_mosaic_supply_change_transaction(fields)
-    raise AssertionError(f"Unsupported transaction type: {transaction_type}")
+    encoder = ENCODERS.get(transaction_type)
+    if encoder is None:
+        raise AssertionError(f"Unsupported transaction type: {transaction_type}")
+    return encoder(fields, version)
 
 
 def encode_txn_context(transaction):
     data, transaction_type, version = encode_common_txn_header(transaction["common_txn_header"])
-    data += encode_txn_detail(transaction["fields"], transaction_type, version)
-    return data
+    return data + encode_txn_detail(transaction["fields"], transaction_type, version)
+
+
+def encode_txn_contexts(transactions):
+    """Batch version of encode_txn_context."""
+    return [encode_txn_context(transaction) for transaction in transactions]
@@ -0,0 +1,342 @@
+# Seeded random transaction generator for Ledger Nem application
+# Produces transactions in the JSON format of nem_transaction_builder.py (see tests/corpus), of
+# every supported type and up to the application limits of src/limitations.h:
+# - valid transactions are accepted by the application parser (src/nem/parse/nem_parse.c),
+#   their field count is computed the way the parser adds fields,
+# - mutations of valid transactions are near-valid inputs for the negative paths of the parsers.
+#
+# Usage: python3 nem_transaction_generator.py --seed 1 --count 100 --output-dir /tmp/corpus
+
+import argparse
+import json
+import random
+import re
+from pathlib import Path
+from struct import pack
+
+try:
+    from .nem_transaction_builder import UINT32_MAX, encode_txn_context
+except ImportError:  # run as a script or with this directory in sys.path
+    from nem_transaction_builder import UINT32_MAX, encode_txn_context
+
+LIMITATIONS_H = Path(__file__).parent.parent.parent.parent / "src" / "limitations.h"
+
+
+def read_limits(path=LIMITATIONS_H):
+    limits = {}
+    with open(path, encoding="utf-8") as f:
+        for name, value in re.findall(r"#define\s+(\w+)\s+(\d+)\s*$", f.read(), re.MULTILINE):
+            limits[name] = int(value)
+    return limits
+
+
+LIMITS = read_limits()
+MAX_RAW_TX = LIMITS["MAX_RAW_TX"]
+MAX_FIELD_COUNT = LIMITS["MAX_FIELD_COUNT"]
+
+MAINNET = 104
+TESTNET = 152
+MIJIN = 96
+NETWORK_PREFIXES = {MAINNET: "N", TESTNET: "T", MIJIN: "M"}
+BASE32_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"
+NAME_ALPHABET = "abcdefghijklmnopqrstuvwxyz0123456789_-"
+TEXT_ALPHABET = "".join(chr(c) for c in range(0x20, 0x7F))
+
+# Transaction types allowed inside a multisig transaction by the application parser
+INNER_TRANSACTION_TYPES = (
+    "TRANSFER",
+    "IMPORTANCE_TRANSFER",
+    "MULTISIG_AGGREGATE_MODIFICATION",
+    "MULTISIG_SIGNATURE",
+    "PROVISION_NAMESPACE",
+    "MOSAIC_DEFINITION",
+    "MOSAIC_SUPPLY_CHANGE",
+)
+TRANSACTION_TYPES = (*INNER_TRANSACTION_TYPES, "MULTISIG")
+MOSAIC_PROPERTIES = ("divisibility", "initialSupply", "supplyMutable", "transferable")
+# Amount of a version 2 transfer multiplying the mosaic quantities by 1
+MULTIPLIER_UNIT = 1000000
+
+# Number of fields added by the parser whatever the content, type field included
+FIXED_FIELD_COUNT = {
+    "TRANSFER": 5,
+    "IMPORTANCE_TRANSFER": 4,
+    "MULTISIG_AGGREGATE_MODIFICATION": 3,
+    "MULTISIG_SIGNATURE": 4,
+    "MULTISIG": 2,
+    "PROVISION_NAMESPACE": 6,
+    "MOSAIC_DEFINITION": 7,
+    "MOSAIC_SUPPLY_CHANGE": 5,
+}
+
+
+def count_fields(transaction, top_level=True):
+    """Number of fields the application parser adds for this transaction."""
+    transaction_type = transaction["common_txn_header"]["transactionType"]
+    version = transaction["common_txn_header"]["version"]
+    fields = transaction["fields"]
+    # The type field of an inner transaction is counted by its multisig transaction
+    count = FIXED_FIELD_COUNT[transaction_type] - (0 if top_level else 1)
+    if transaction_type == "TRANSFER" and version != 1:
+        # The amount field is only added in version 1
+        count -= 1
+    if transaction_type == "TRANSFER" and version == 2:
+        mosaics = fields.get("mosaicList", [])
+        # Amount or mosaic count field, unless there is a single mosaic
+        count += 1 if len(mosaics) != 1 else 0
+        # Multiplier field, unless the quantities are multiplied by 1
+        count += 1 if mosaics and fields["amount"] != MULTIPLIER_UNIT else 0
+        for mosaic in mosaics:
+            if mosaic["namespace"] == "nem" and mosaic["mosaicName"] == "xem":
+                count += 1
+            else:
+                count += 3 + (1 if len(mosaics) == 1 else 0)
+    elif transaction_type == "MULTISIG_AGGREGATE_MODIFICATION":
+        count += 2 * len(fields["cmList"]) + (1 if version == 2 else 0)
+    elif transaction_type == "MOSAIC_DEFINITION":
+        count += len(fields.get("properties", [])) + (4 if fields.get("levy") else 0)
+    if transaction_type in ("MULTISIG", "MULTISIG_SIGNATURE"):
+        count += sum(1 + count_fields(inner, top_level=False) for inner in fields["transactions"])
+    return count
+
+
+class TransactionGenerator:
+    """Random transactions of a given size profile.
+
+    scale, between 0 and 1, sets how close to the limits the variable parts go: number of mosaics,
+    modifications, properties and inner transactions, and length of messages and strings.
+    max_depth is the number of multisig signature levels that may be nested in a multisig.
+    """
+
+    def __init__(self, seed=0, scale=0.5, max_size=MAX_RAW_TX, max_fields=MAX_FIELD_COUNT, max_depth=2):
+        self.rng = random.Random(seed)
+        self.scale = scale
+        self.max_size = max_size
+        self.max_fields = max_fields
+        self.max_depth = max_depth
+
+    # Primitive values
+
+    def _count(self, maximum):
+        return self.rng.randint(0, max(0, int(maximum * self.scale)))
+
+    def _string(self, alphabet, maximum, minimum=1):
+        length = self.rng.randint(minimum, max(minimum, int(maximum * self.scale)))
+        return "".join(self.rng.choice(alphabet) for _ in range(length))
+
+    def _name(self, maximum=64):
+        return self._string(NAME_ALPHABET, maximum)
+
+    def _public_key(self):
+        return self.rng.randbytes(32).hex()
+
+    def _address(self, network):
+        return NETWORK_PREFIXES[network] + "".join(self.rng.choice(BASE32_ALPHABET) for _ in range(39))
+
+    def _uint64(self):
+        return self.rng.choice([0, 1, self.rng.getrandbits(32), self.rng.getrandbits(64), 2**64 - 1])
+
+    # Transactions
+
+    def _header(self, transaction_type, version, network):
+        timestamp = self.rng.getrandbits(32)
+        return {
+            "transactionType": transaction_type,
+            "version": version,
+            "networkType": network,
+            "timestamp": timestamp,
+            "public_key": self._public_key(),
+            "fee": self._uint64(),
+            "deadline": (timestamp + self.rng.randint(0, 86400)) & UINT32_MAX,
+        }
+
+    def _transfer(self, version, network, budget):
+        fields = {"recipient": self._address(network), "amount": self._uint64()}
+        if self.rng.random() < 0.8:
+            payload_type = self.rng.choice([1, 1, 2])
+            # Leave room for the rest of the transaction in the raw buffer
+            message = self._string(TEXT_ALPHABET, self.max_size - 512)
+            fields["payloadType"] = payload_type
+            fields["payload"] = message.encode("ascii").hex() if payload_type == 1 else self.rng.randbytes(len(message)).hex()
+        if version == 2:
+            mosaics = []
+            # Up to 4 fields per mosaic with the mosaic count
+            for _ in range(self._count(max(0, budget - 4) // 3)):
+                if self.rng.random() < 0.2:
+                    mosaics.append({"namespace": "nem", "mosaicName": "xem", "quantity": self._uint64()})
+                else:
+                    mosaics.append({"namespace": self._name(), "mosaicName": self._name(), "quantity": self._uint64()})
+            fields["mosaicList"] = mosaics
+        return fields
+
+    def _importance_transfer(self):
+        return {"iMode": self.rng.choice([1, 2]), "iPublicKey": self._public_key()}
+
+    def _aggregate_modification(self, version, budget):
+        fields = {
+            "cmList": [
+                {"cmsLen": 40, "amType": self.rng.choice([1, 2]), "amPublicKey": self._public_key()}
+                for _ in range(self._count(max(0, budget - 4) // 2))
+            ]
+        }
+        if version == 2:
+            fields["cmLen"] = self.rng.choice([0, 4])
+            if fields["cmLen"]:
+                fields["minCm"] = self.rng.randint(0, 32)
+        return fields
+
+    def _provision_namespace(self, network):
+        fields = {
+            "rAddress": self._address(network),
+            "rentalFee": self.rng.choice([100000000, 10000000]),
+            "namespace": self._name(),
+        }
+        if self.rng.random() < 0.5:
+            fields["parentNamespace"] = self._name()
+        return fields
+
+    def _mosaic_definition(self, network, budget):
+        properties = [
+            {"propertyName": self.rng.choice(MOSAIC_PROPERTIES), "propertyVal": self._string(TEXT_ALPHABET, 32)}
+            for _ in range(self._count(max(0, budget - 4)))
+        ]
+        fields = {
+            "mdcPublicKey": self._public_key(),
+            "namespace": self._name(),
+            "mosaicName": self._name(),
+            "description": self._string(TEXT_ALPHABET, 512, minimum=0),
+            "mdAddress": self._address(network),
+            "mdfee": self._uint64(),
+        }
+        if properties:
+            fields["properties"] = properties
+        if budget - len(properties) >= 4 and self.rng.random() < 0.5:
+            fields["levy"] = {
+                "feeType": self.rng.choice([1, 2]),
+                "lsAddress": self._address(network),
+                "namespace": self._name(),
+                "mosaicName": self._name(),
+                "fee": self._uint64(),
+            }
+        return fields
+
+    def _mosaic_supply_change(self):
+        return {
+            "namespace": self._name(),
+            "mosaicName": self._name(),
+            "supplyType": self.rng.choice([1, 2]),
+            "supplyDelta": self._uint64(),
+        }
+
+    def _multisig_signature(self, network, depth, budget, top_level_type):
+        fields = {"hashObjLen": 36, "hash": self.rng.randbytes(32).hex(), "msAddress": self._address(network)}
+        fields.update(self._multisig(network, depth, budget, top_level_type))
+        return fields
+
+    def _multisig(self, network, depth, budget, top_level_type):
+        # The parser rejects a multisig signature inside a multisig signature transaction
+        nested_signature = depth > 0 and top_level_type != "MULTISIG_SIGNATURE"
+        transactions = []
+        for _ in range(1 + self._count(2)):
+            # The fixed field count of a transaction includes the type field of an inner one
+            allowed = [
+                t
+                for t in INNER_TRANSACTION_TYPES
+                if FIXED_FIELD_COUNT[t] <= budget and (t != "MULTISIG_SIGNATURE" or nested_signature)
+            ]
+            if not allowed:
+                break
+            inner = self._transaction(self.rng.choice(allowed), network, depth - 1, budget, top_level_type)
+            budget -= 1 + count_fields(inner, top_level=False)
+            transactions.append(inner)
+        return {"transactions": transactions}
+
+    def _transaction(self, transaction_type, network, depth, budget, top_level_type):
+        version = 2 if transaction_type in ("TRANSFER", "MULTISIG_AGGREGATE_MODIFICATION") and self.rng.random() < 0.6 else 1
+        header = self._header(transaction_type, version, network)
+        # Fields left for the variable part of the transaction
+        budget -= FIXED_FIELD_COUNT[transaction_type]
+        if transaction_type == "TRANSFER":
+            fields = self._transfer(version, network, budget)
+        elif transaction_type == "IMPORTANCE_TRANSFER":
+            fields = self._importance_transfer()
+        elif transaction_type == "MULTISIG_AGGREGATE_MODIFICATION":
+            fields = self._aggregate_modification(version, budget)
+        elif transaction_type == "MULTISIG_SIGNATURE":
+            fields = self._multisig_signature(network, depth, budget, top_level_type)
+        elif transaction_type == "MULTISIG":
+            fields = self._multisig(network, depth, budget, top_level_type)
+        elif transaction_type == "PROVISION_NAMESPACE":
+            fields = self._provision_namespace(network)
+        elif transaction_type == "MOSAIC_DEFINITION":
+            fields = self._mosaic_definition(network, budget)
+        else:
+            fields = self._mosaic_supply_change()
+        return {"common_txn_header": header, "fields": fields}
+
+    def generate(self, transaction_type=None, network=None):
+        """A transaction within the size and field limits, of a random type if none is given."""
+        transaction_type = transaction_type or self.rng.choice(TRANSACTION_TYPES)
+        network = network or self.rng.choice(list(NETWORK_PREFIXES))
+        while True:
+            transaction = self._transaction(transaction_type, network, self.max_depth, self.max_fields, transaction_type)
+            if count_fields(transaction) <= self.max_fields and len(encode_txn_context(transaction)) <= self.max_size:
+                return transaction
+
+    # Mutations
+
+    def mutate(self, data):
+        """A near-valid variant of an encoded transaction: most parsers should reject it cleanly."""
+        data = bytearray(data)
+        mutation = self.rng.randrange(6)
+        if mutation == 0:
+            # Truncated
+            del data[self.rng.randrange(len(data)) :]
+        elif mutation == 1:
+            # Trailing bytes
+            data += self.rng.randbytes(self.rng.randint(1, 16))
+        elif mutation == 2:
+            # Length or count field set to a boundary value
+            offset = self.rng.randrange(max(1, len(data) - 3))
+            value = self.rng.choice([0, 1, len(data) - offset, len(data), 0x7FFFFFFF, UINT32_MAX])
+            data[offset : offset + 4] = pack("<I", value & UINT32_MAX)
+        elif mutation == 3:
+            # Off by one length or count field
+            offset = self.rng.randrange(max(1, len(data) - 3))
+            value = int.from_bytes(data[offset : offset + 4], "little") + self.rng.choice([-1, 1])
+            data[offset : offset + 4] = pack("<I", value & UINT32_MAX)
+        elif mutation == 4:
+            # Unknown transaction type or version
+            offset = self.rng.choice([0, 4])
+            data[offset] = self.rng.getrandbits(8)
+        else:
+            # Random byte flip
+            data[self.rng.randrange(len(data))] ^= 1 << self.rng.randrange(8)
+        return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate random NEM transactions")
+    parser.add_argument("--seed", type=int, default=0, help="Seed of the generator")
+    parser.add_argument("--count", type=int, default=100, help="Number of valid transactions")
+    parser.add_argument("--mutations", type=int, default=0, help="Number of mutations of each valid transaction")
+    parser.add_argument("--scale", type=float, default=0.5, help="Size profile, from 0 (smallest) to 1 (up to the limits)")
+    parser.add_argument("--type", choices=TRANSACTION_TYPES, help="Only generate this transaction type")
+    parser.add_argument("--max-depth", type=int, default=2, help="Maximum nesting of multisig signatures")
+    parser.add_argument("--output-dir", type=Path, required=True, help="Directory of the generated files")
+    args = parser.parse_args()
+
+    generator = TransactionGenerator(args.seed, args.scale, max_depth=args.max_depth)
+    args.output_dir.mkdir(parents=True, exist_ok=True)
+    for i in range(args.count):
+        transaction = generator.generate(args.type)
+        with open(args.output_dir / f"generated_{args.seed}_{i}.json", "w", encoding="utf-8") as f:
+            json.dump(transaction, f, indent=4)
+            f.write("\n")
+        data = encode_txn_context(transaction)
+        for j in range(args.mutations):
+            (args.output_dir / f"mutated_{args.seed}_{i}_{j}.raw").write_bytes(generator.mutate(data))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,4 +1,4 @@
-from struct import unpack
+from struct import Struct
 
 UINT32_MAX = 0xFFFFFFFF
 
@@ -13,165 +13,198 @@ TRANSACTION_TYPES = {
     0x4002: "MOSAIC_SUPPLY_CHANGE",
 }
 
+ADDRESS_LENGTH = 40
+PUBLIC_KEY_LENGTH = 32
+TRANSACTION_HASH_LENGTH = 32
 
-def read_uint8_t(buffer):
-    return buffer[1:], unpack("<B", buffer[:1])[0]
+# Precompiled layouts of the packed structures of src/nem/parse/nem_parse.c, see
+# nem_transaction_builder.py. Every read_* function takes the buffer and the offset to read at,
+# and returns the offset that follows the value, and the value.
+UINT8 = Struct("<B")
+UINT16 = Struct("<H")
+UINT32 = Struct("<I")
+UINT64 = Struct("<Q")
+COMMON_TXN_HEADER = Struct("<IBHBII32sQI")
+TRANSFER_TXN_HEADER = Struct("<I40sQI")
+IMPORTANCE_TXN_HEADER = Struct("<II32s")
+AGGREGATE_MODIFICATION_HEADER = Struct("<III32s")
+RENTAL_HEADER = Struct("<I40sQ")
+LEVY_STRUCTURE = Struct("<II40sI")
+MOSAIC_DEFINITION_SINK = Struct("<I40sQ")
 
 
-def read_uint16_t(buffer):
-    return buffer[2:], unpack("<H", buffer[:2])[0]
+def read_struct(layout, buffer, offset):
+    return offset + layout.size, layout.unpack_from(buffer, offset)
 
 
-def read_uint32_t(buffer):
-    return buffer[4:], unpack("<I", buffer[:4])[0]
+def read_uint8_t(buffer, offset):
+    return offset + 1, UINT8.unpack_from(buffer, offset)[0]
 
 
-def read_uint64_t(buffer):
-    return buffer[8:], unpack("<Q", buffer[:8])[0]
+def read_uint16_t(buffer, offset):
+    return offset + 2, UINT16.unpack_from(buffer, offset)[0]
 
 
-def read_len_prefixed_data(buffer):
-    buffer, length = read_uint32_t(buffer)
-    return buffer[length:], buffer[:length]
+def read_uint32_t(buffer, offset):
+    return offset + 4, UINT32.unpack_from(buffer, offset)[0]
 
 
-def read_len_prefixed_string(buffer):
-    buffer, data = read_len_prefixed_data(buffer)
-    return buffer, data.decode("utf-8")
+def read_uint64_t(buffer, offset):
+    return offset + 8, UINT64.unpack_from(buffer, offset)[0]
 
 
-def read_address(buffer):
-    buffer, string = read_len_prefixed_string(buffer)
-    assert len(string) == 40
-    return buffer, string
+def read_data(buffer, offset, length):
+    assert offset + length <= len(buffer), "not enough data"
+    return offset + length, buffer[offset : offset + length]
 
 
-def read_public_key(buffer):
-    buffer, public_key = read_len_prefixed_data(buffer)
-    assert len(public_key) == 32
-    return buffer, public_key.hex()
+def read_len_prefixed_data(buffer, offset):
+    offset, length = read_uint32_t(buffer, offset)
+    return read_data(buffer, offset, length)
 
 
-def decode_common_txn_header(buffer):
-    buffer, value = read_uint32_t(buffer)
-    transactionType = TRANSACTION_TYPES[value]
-    buffer, version = read_uint8_t(buffer)
-    buffer, _ = read_uint16_t(buffer)
-    buffer, networkType = read_uint8_t(buffer)
-    buffer, timestamp = read_uint32_t(buffer)
-    buffer, public_key = read_public_key(buffer)
-    buffer, fee = read_uint64_t(buffer)
-    buffer, deadline = read_uint32_t(buffer)
+def read_len_prefixed_string(buffer, offset):
+    offset, data = read_len_prefixed_data(buffer, offset)
+    return offset, str(data, "utf-8")
+
+
+def check_address(length, address):
+    assert length == ADDRESS_LENGTH
+    return str(address, "utf-8")
+
+
+def check_public_key(length, public_key):
+    assert length == PUBLIC_KEY_LENGTH
+    return public_key.hex()
+
+
+def read_address(buffer, offset):
+    offset, string = read_len_prefixed_string(buffer, offset)
+    assert len(string) == ADDRESS_LENGTH
+    return offset, string
+
+
+def read_public_key(buffer, offset):
+    offset, public_key = read_len_prefixed_data(buffer, offset)
+    assert len(public_key) == PUBLIC_KEY_LENGTH
+    return offset, public_key.hex()
+
+
+def read_mosaic_id(buffer, offset):
+    """Length prefixed mosaic id: namespace and mosaic name."""
+    offset, mosaicIdLen = read_uint32_t(buffer, offset)
+    start = offset
+    offset, namespace = read_len_prefixed_string(buffer, offset)
+    offset, mosaicName = read_len_prefixed_string(buffer, offset)
+    assert offset - start == mosaicIdLen
+    return offset, namespace, mosaicName
+
+
+def decode_common_txn_header(buffer, offset):
+    offset, header = read_struct(COMMON_TXN_HEADER, buffer, offset)
+    value, version, _, networkType, timestamp, public_key_length, public_key, fee, deadline = header
 
     data = {
-        "transactionType": transactionType,
+        "transactionType": TRANSACTION_TYPES[value],
         "version": version,
         "networkType": networkType,
         "timestamp": timestamp,
-        "public_key": public_key,
+        "public_key": check_public_key(public_key_length, public_key),
         "fee": fee,
         "deadline": deadline,
     }
-    return buffer, data
+    return offset, data
 
 
-def decode_transfer_transaction(buffer, version):
-    buffer, recipient = read_address(buffer)
-    buffer, amount = read_uint64_t(buffer)
+def decode_transfer_transaction(buffer, offset, version):
+    offset, (recipient_length, recipient, amount, payload_len) = read_struct(TRANSFER_TXN_HEADER, buffer, offset)
 
-    data = {"recipient": recipient, "amount": amount}
+    data = {"recipient": check_address(recipient_length, recipient), "amount": amount}
 
-    buffer, payload_len = read_uint32_t(buffer)
     if payload_len:
-        payload_data = buffer[:payload_len]
-        buffer = buffer[payload_len:]
-        payload_data, payloadType = read_uint32_t(payload_data)
-        payload_data, payload = read_len_prefixed_data(payload_data)
+        offset, payload_data = read_data(buffer, offset, payload_len)
+        payload_offset, payloadType = read_uint32_t(payload_data, 0)
+        payload_offset, payload = read_len_prefixed_data(payload_data, payload_offset)
+        assert payload_offset == len(payload_data)
 
         data["payloadType"] = payloadType
         data["payload"] = payload.hex()
 
     if version == 2:
-        buffer, mosaicListLen = read_uint32_t(buffer)
+        offset, mosaicListLen = read_uint32_t(buffer, offset)
         mosaicList = []
         for _ in range(mosaicListLen):
-            buffer, _ = read_uint32_t(buffer)  # length not check for now
-            buffer, _ = read_uint32_t(buffer)  # length not check for now
-            buffer, namespace = read_len_prefixed_string(buffer)
-            buffer, mosaicName = read_len_prefixed_string(buffer)
-            buffer, quantity = read_uint64_t(buffer)
+            offset, mosaicLen = read_uint32_t(buffer, offset)
+            start = offset
+            offset, namespace, mosaicName = read_mosaic_id(buffer, offset)
+            offset, quantity = read_uint64_t(buffer, offset)
+            assert offset - start == mosaicLen
             mosaicList.append({"namespace": namespace, "mosaicName": mosaicName, "quantity": quantity})
 
         data["mosaicList"] = mosaicList
 
-    return buffer, data
+    return offset, data
 
 
-def decode_importance_transfer_transaction(buffer):
-    buffer, iMode = read_uint32_t(buffer)
-    buffer, iPublicKey = read_public_key(buffer)
-    data = {"iMode": iMode, "iPublicKey": iPublicKey}
-    return buffer, data
+def decode_importance_transfer_transaction(buffer, offset):
+    offset, (iMode, public_key_length, iPublicKey) = read_struct(IMPORTANCE_TXN_HEADER, buffer, offset)
+    data = {"iMode": iMode, "iPublicKey": check_public_key(public_key_length, iPublicKey)}
+    return offset, data
 
 
-def decode_aggregate_modification_transaction(buffer, version):
-    buffer, cmListLen = read_uint32_t(buffer)
+def decode_aggregate_modification_transaction(buffer, offset, version):
+    offset, cmListLen = read_uint32_t(buffer, offset)
     cmList = []
     for _ in range(cmListLen):
-        buffer, cmsLen = read_uint32_t(buffer)  # not used?
-        buffer, amType = read_uint32_t(buffer)
-        buffer, amPublicKey = read_public_key(buffer)
-        cmList.append({"cmsLen": cmsLen, "amType": amType, "amPublicKey": amPublicKey})
+        # cmsLen: not used?
+        offset, (cmsLen, amType, public_key_length, amPublicKey) = read_struct(AGGREGATE_MODIFICATION_HEADER, buffer, offset)
+        cmList.append({"cmsLen": cmsLen, "amType": amType, "amPublicKey": check_public_key(public_key_length, amPublicKey)})
     data = {"cmList": cmList}
 
     if version == 2:
-        buffer, cmLen = read_uint32_t(buffer)  # only 0 or != 0 used
+        offset, cmLen = read_uint32_t(buffer, offset)  # only 0 or != 0 used
         data["cmLen"] = cmLen
         if cmLen > 0:
-            buffer, minCm = read_uint32_t(buffer)
+            offset, minCm = read_uint32_t(buffer, offset)
             data["minCm"] = minCm
-    return buffer, data
+    return offset, data
 
 
-def decode_multisig_signature_transaction(buffer):
-    buffer, hashObjLen = read_uint32_t(buffer)  # not used?
-    buffer, hashdata = read_len_prefixed_data(buffer)
-    buffer, msAddress = read_address(buffer)
+def decode_multisig_signature_transaction(buffer, offset):
+    offset, hashObjLen = read_uint32_t(buffer, offset)  # not used?
+    offset, hashdata = read_len_prefixed_data(buffer, offset)
+    assert len(hashdata) == TRANSACTION_HASH_LENGTH
+    offset, msAddress = read_address(buffer, offset)
 
-    buffer, transactions = decode_multisig_transaction(buffer)
+    offset, transactions = decode_multisig_transaction(buffer, offset)
     data = {"hashObjLen": hashObjLen, "hash": hashdata.hex(), "msAddress": msAddress}
     data.update(transactions)
-    return buffer, data
+    return offset, data
 
 
-def decode_provision_namespace_transaction(buffer):
-    buffer, rAddress = read_address(buffer)
-    buffer, rentalFee = read_uint64_t(buffer)
-    buffer, namespace = read_len_prefixed_string(buffer)
+def decode_provision_namespace_transaction(buffer, offset):
+    offset, (address_length, rAddress, rentalFee) = read_struct(RENTAL_HEADER, buffer, offset)
+    offset, namespace = read_len_prefixed_string(buffer, offset)
 
-    data = {"rAddress": rAddress, "rentalFee": rentalFee, "namespace": namespace}
+    data = {"rAddress": check_address(address_length, rAddress), "rentalFee": rentalFee, "namespace": namespace}
 
-    _, length = read_uint32_t(buffer)
+    _, length = read_uint32_t(buffer, offset)
     if length == UINT32_MAX:
-        # drop the 4read bytes
-        buffer, _ = read_uint32_t(buffer)
+        # drop the read 4 bytes
+        offset += 4
     else:
-        buffer, parentNamespace = read_len_prefixed_string(buffer)
+        offset, parentNamespace = read_len_prefixed_string(buffer, offset)
         data["parentNamespace"] = parentNamespace
 
-    return buffer, data
+    return offset, data
 
 
-def decode_mosaic_definition_creation_transaction(buffer):
-    buffer, mds_data_len = read_uint32_t(buffer)
-    mds_data = buffer[:mds_data_len]
-    buffer = buffer[mds_data_len:]
+def decode_mosaic_definition_creation_transaction(buffer, offset):
+    offset, mds_data = read_len_prefixed_data(buffer, offset)
 
-    mds_data, mdcPublicKey = read_public_key(mds_data)
-    mds_data, _ = read_uint32_t(mds_data)  # length not check for now
-    mds_data, namespace = read_len_prefixed_string(mds_data)
-    mds_data, mosaicName = read_len_prefixed_string(mds_data)
-    mds_data, description = read_len_prefixed_string(mds_data)
+    mds_offset, mdcPublicKey = read_public_key(mds_data, 0)
+    mds_offset, namespace, mosaicName = read_mosaic_id(mds_data, mds_offset)
+    mds_offset, description = read_len_prefixed_string(mds_data, mds_offset)
 
     data = {
         "mdcPublicKey": mdcPublicKey,
@@ -181,51 +214,53 @@ def decode_mosaic_definition_creation_transaction(buffer):
     }
 
     properties = []
-    mds_data, propertiesLen = read_uint32_t(mds_data)
+    mds_offset, propertiesLen = read_uint32_t(mds_data, mds_offset)
     for _ in range(propertiesLen):
-        mds_data, _ = read_uint32_t(mds_data)  # length not check for now
-        mds_data, propertyName = read_len_prefixed_string(mds_data)
-        mds_data, propertyVal = read_len_prefixed_string(mds_data)
+        mds_offset, propertyLen = read_uint32_t(mds_data, mds_offset)
+        start = mds_offset
+        mds_offset, propertyName = read_len_prefixed_string(mds_data, mds_offset)
+        mds_offset, propertyVal = read_len_prefixed_string(mds_data, mds_offset)
+        assert mds_offset - start == propertyLen
 
         properties.append({"propertyName": propertyName, "propertyVal": propertyVal})
 
     if properties:
         data["properties"] = properties
 
-    mds_data, levyLen = read_uint32_t(mds_data)
+    mds_offset, levyLen = read_uint32_t(mds_data, mds_offset)
     if levyLen:
-        mds_data, feeType = read_uint32_t(mds_data)
-        mds_data, lsAddress = read_address(mds_data)
-
-        mds_data, _ = read_uint32_t(mds_data)  # length not check for now
-        mds_data, namespace = read_len_prefixed_string(mds_data)
-        mds_data, mosaicName = read_len_prefixed_string(mds_data)
-
-        mds_data, fee = read_uint64_t(mds_data)
+        start = mds_offset
+        mds_offset, (feeType, address_length, lsAddress, mosaicIdLen) = read_struct(LEVY_STRUCTURE, mds_data, mds_offset)
+        assert feeType in (1, 2)
+        mosaic_id_start = mds_offset
+        mds_offset, namespace = read_len_prefixed_string(mds_data, mds_offset)
+        mds_offset, mosaicName = read_len_prefixed_string(mds_data, mds_offset)
+        assert mds_offset - mosaic_id_start == mosaicIdLen
+
+        mds_offset, fee = read_uint64_t(mds_data, mds_offset)
+        assert mds_offset - start == levyLen
         data["levy"] = {
             "feeType": feeType,
-            "lsAddress": lsAddress,
+            "lsAddress": check_address(address_length, lsAddress),
             "namespace": namespace,
             "mosaicName": mosaicName,
             "fee": fee,
         }
 
-    assert not mds_data
+    assert mds_offset == len(mds_data)
 
-    buffer, mdAddress = read_address(buffer)
-    data["mdAddress"] = mdAddress
-    buffer, mdfee = read_uint64_t(buffer)
+    offset, (address_length, mdAddress, mdfee) = read_struct(MOSAIC_DEFINITION_SINK, buffer, offset)
+    data["mdAddress"] = check_address(address_length, mdAddress)
     data["mdfee"] = mdfee
 
-    return buffer, data
+    return offset, data
 
 
-def decode_mosaic_supply_change_transaction(buffer):
-    buffer, _ = read_uint32_t(buffer)  # length not check for now
-    buffer, namespace = read_len_prefixed_string(buffer)
-    buffer, mosaicName = read_len_prefixed_string(buffer)
-    buffer, supplyType = read_uint32_t(buffer)
-    buffer, supplyDelta = read_uint64_t(buffer)
+def decode_mosaic_supply_change_transaction(buffer, offset):
+    offset, namespace, mosaicName = read_mosaic_id(buffer, offset)
+    offset, supplyType = read_uint32_t(buffer, offset)
+    assert supplyType in (1, 2)
+    offset, supplyDelta = read_uint64_t(buffer, offset)
 
     data = {
         "namespace": namespace,
@@ -234,50 +269,67 @@ def decode_mosaic_supply_change_transaction(buffer):
         "supplyDelta": supplyDelta,
     }
 
-    return buffer, data
+    return offset, data
 
 
-def decode_multisig_transaction(buffer):
-    buffer, subdataLen = read_uint32_t(buffer)
-    subbuffer = buffer[:subdataLen]
-    buffer = buffer[subdataLen:]
+def decode_multisig_transaction(buffer, offset):
+    offset, subbuffer = read_len_prefixed_data(buffer, offset)
 
     subdataList = []
 
-    while subbuffer:
-        subbuffer, subdata = _decode_txn_context(subbuffer)
+    suboffset = 0
+    while suboffset < len(subbuffer):
+        suboffset, subdata = _decode_txn_context(subbuffer, suboffset)
         subdataList.append(subdata)
 
-    return buffer, {"transactions": subdataList}
+    return offset, {"transactions": subdataList}
 
 
-def decode_txn_detail(buffer, transaction_type, version):
+def decode_txn_detail(buffer, offset, transaction_type, version):
     if transaction_type == "TRANSFER":
-        return decode_transfer_transaction(buffer, version)
+        return decode_transfer_transaction(buffer, offset, version)
     if transaction_type == "IMPORTANCE_TRANSFER":
-        return decode_importance_transfer_transaction(buffer)
+        return decode_importance_transfer_transaction(buffer, offset)
     if transaction_type == "MULTISIG_AGGREGATE_MODIFICATION":
-        return decode_aggregate_modification_transaction(buffer, version)
+        return decode_aggregate_modification_transaction(buffer, offset, version)
     if transaction_type == "MULTISIG_SIGNATURE":
-        return decode_multisig_signature_transaction(buffer)
+        return decode_multisig_signature_transaction(buffer, offset)
     if transaction_type == "MULTISIG":
-        return decode_multisig_transaction(buffer)
+        return decode_multisig_transaction(buffer, offset)
     if transaction_type == "PROVISION_NAMESPACE":
-        return decode_provision_namespace_transaction(buffer)
+        return decode_provision_namespace_transaction(buffer, offset)
     if transaction_type == "MOSAIC_DEFINITION":
-        return decode_mosaic_definition_creation_transaction(buffer)
+        return decode_mosaic_definition_creation_transaction(buffer, offset)
     if transaction_type == "MOSAIC_SUPPLY_CHANGE":
-        return decode_mosaic_supply_change_transaction(buffer)
+        return decode_mosaic_supply_change_transaction(buffer, offset)
     raise AssertionError(f"Unsupported transaction type: {transaction_type}")
 
 
-def _decode_txn_context(buffer):
-    buffer, header = decode_common_txn_header(buffer)
-    buffer, fields = decode_txn_detail(buffer, header["transactionType"], header["version"])
-    return buffer, {"common_txn_header": header, "fields": fields}
+def _decode_txn_context(buffer, offset):
+    offset, header = decode_common_txn_header(buffer, offset)
+    offset, fields = decode_txn_detail(buffer, offset, header["transactionType"], header["version"])
+    return offset, {"common_txn_header": header, "fields": fields}
+
+
+def check_inner_types(data, root_type):
+    """Inner transactions the application accepts: no multisig, and no multisig signature in a
+    multisig signature."""
+    for inner in data["fields"].get("transactions", []):
+        transaction_type = inner["common_txn_header"]["transactionType"]
+        assert transaction_type != "MULTISIG"
+        assert not (root_type == "MULTISIG_SIGNATURE" and transaction_type == "MULTISIG_SIGNATURE")
+        check_inner_types(inner, root_type)
 
 
 def decode_txn_context(buffer):
-    buffer, data = _decode_txn_context(buffer)
-    assert len(buffer) == 0
+    # Sub-structures are zero-copy views of the transaction
+    buffer = memoryview(buffer)
+    offset, data = _decode_txn_context(buffer, 0)
+    assert offset == len(buffer)
+    check_inner_types(data, data["common_txn_header"]["transactionType"])
     return data
+
+
+def decode_txn_contexts(buffers):
+    """Batch version of decode_txn_context."""
+    return [decode_txn_context(buffer) for buffer in buffers]
@@ -0,0 +1,93 @@
+"""Latency benchmark results, and their comparison against a checked-in baseline.
+
+Each benchmark is recorded as a list of wall time samples, in milliseconds. The results of a run
+are written as JSON, keyed by benchmark name, and a benchmark fails when its median exceeds the
+baseline median by more than the tolerance.
+"""
+
+import json
+import platform
+import statistics
+import time
+from collections.abc import Callable
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any
+
+BASELINE_DIR = Path(__file__).parent / "benchmarks"
+RESULTS_FORMAT_VERSION = 1
+
+
+def baseline_path(device: str) -> Path:
+    return BASELINE_DIR / f"baseline_{device}.json"
+
+
+@dataclass
+class BenchmarkResult:
+    samples_ms: list[float]
+
+    @property
+    def median_ms(self) -> float:
+        return statistics.median(self.samples_ms)
+
+    def to_json(self) -> dict[str, Any]:
+        return {
+            "samples": len(self.samples_ms),
+            "median_ms": round(self.median_ms, 3),
+            "min_ms": round(min(self.samples_ms), 3),
+            "max_ms": round(max(self.samples_ms), 3),
+        }
+
+
+@dataclass
+class BenchmarkSession:
+    device: str
+    rounds: int
+    tolerance: float
+    baseline: dict[str, Any] = field(default_factory=dict)
+    results: dict[str, BenchmarkResult] = field(default_factory=dict)
+
+    @classmethod
+    def load(cls, device: str, rounds: int, tolerance: float, baseline_file: Path | None) -> "BenchmarkSession":
+        baseline = {}
+        if baseline_file is not None and baseline_file.exists():
+            with open(baseline_file, encoding="utf-8") as f:
+                baseline = json.load(f)["results"]
+        return cls(device=device, rounds=rounds, tolerance=tolerance, baseline=baseline)
+
+    def measure(self, name: str, command: Callable[[], Any]) -> BenchmarkResult:
+        """Runs the command `rounds` times and records the wall time of each run."""
+        samples = []
+        for _ in range(self.rounds):
+            start = time.perf_counter()
+            command()
+            samples.append((time.perf_counter() - start) * 1000)
+        result = BenchmarkResult(samples)
+        self.results[name] = result
+        return result
+
+    def check(self, name: str) -> None:
+        """Fails if the benchmark is slower than its baseline, when there is one."""
+        reference = self.baseline.get(name)
+        if reference is None:
+            return
+        limit = reference["median_ms"] * (1 + self.tolerance)
+        median = self.results[name].median_ms
+        assert median <= limit, (
+            f"{name}: median {median:.1f} ms exceeds baseline {reference['median_ms']:.1f} ms by more than {self.tolerance:.0%}"
+        )
+
+    def to_json(self) -> dict[str, Any]:
+        return {
+            "version": RESULTS_FORMAT_VERSION,
+            "device": self.device,
+            "host": platform.node(),
+            "rounds": self.rounds,
+            "results": {name: self.results[name].to_json() for name in sorted(self.results)},
+        }
+
+    def save(self, path: Path) -> None:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        with open(path, "w", encoding="utf-8") as f:
+            json.dump(self.to_json(), f, indent=2)
+            f.write("\n")
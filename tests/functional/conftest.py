@@ -1,3 +1,11 @@
+import os
+from pathlib import Path
+
+import pytest
+from benchmark import BenchmarkSession, baseline_path
+from ragger.backend import SpeculosBackend
+from ragger.conftest import base_conftest
+
 ###########################
 ### CONFIGURATION START ###
 ###########################
@@ -11,3 +19,94 @@
 
 # Pull all features from the base ragger conftest using the overridden configuration
 pytest_plugins = ("ragger.conftest.base_conftest",)
+
+########################
+### PARALLEL WORKERS ###
+########################
+
+# Ports of the emulator of the first worker, the next workers use the following ones
+SPECULOS_API_PORT = 5000
+SPECULOS_APDU_PORT = 9999
+
+
+def xdist_worker_index() -> int | None:
+    worker = os.environ.get("PYTEST_XDIST_WORKER")
+    return int(worker.removeprefix("gw")) if worker else None
+
+
+class WorkerSpeculosBackend(SpeculosBackend):
+    """Speculos backend listening on the ports of the current pytest-xdist worker."""
+
+    def __init__(self, *args, **kwargs):
+        index = xdist_worker_index() or 0
+        kwargs.setdefault("port", SPECULOS_API_PORT + index)
+        kwargs["args"] = [*kwargs.get("args", []), "--apdu-port", str(SPECULOS_APDU_PORT + index)]
+        super().__init__(*args, **kwargs)
+
+
+if xdist_worker_index() is not None:
+    # The base conftest creates its emulator through this name
+    base_conftest.SpeculosBackend = WorkerSpeculosBackend
+
+
+def xdist_group(item: pytest.Item) -> str:
+    """Tests of one module on one device run on the same worker, in file order, as in a serial run."""
+    params = getattr(item, "callspec", None)
+    firmware = params.params.get("firmware") if params else None
+    device = str(getattr(firmware, "name", firmware)).lower()
+    return f"{device}::{item.module.__name__}"
+
+
+#################
+### BENCHMARK ###
+#################
+
+
+def pytest_addoption(parser):
+    parser.addoption("--benchmark", action="store_true", default=False, help="Run the latency benchmarks")
+    parser.addoption("--benchmark_rounds", type=int, default=5, help="Number of runs of each benchmarked command")
+    parser.addoption(
+        "--benchmark_tolerance", type=float, default=0.25, help="Allowed slowdown relative to the baseline median"
+    )
+    parser.addoption("--benchmark_output", type=Path, default=None, help="Write the benchmark results to this JSON file")
+    parser.addoption("--benchmark_baseline", type=Path, default=None, help="Compare against this baseline JSON file")
+    parser.addoption(
+        "--benchmark_update_baseline", action="store_true", default=False, help="Save the results as the device baseline"
+    )
+
+
+def pytest_configure(config):
+    config.addinivalue_line("markers", "benchmark: latency benchmark, only run with --benchmark")
+
+
+def pytest_collection_modifyitems(config, items):
+    skip = pytest.mark.skip(reason="latency benchmarks only run with --benchmark")
+    parallel = config.pluginmanager.hasplugin("xdist")
+    for item in items:
+        if parallel:
+            item.add_marker(pytest.mark.xdist_group(xdist_group(item)))
+        if "benchmark" in item.keywords:
+            if not config.getoption("benchmark"):
+                item.add_marker(skip)
+        elif config.getoption("benchmark"):
+            item.add_marker(pytest.mark.skip(reason="only latency benchmarks run with --benchmark"))
+
+
+@pytest.fixture(scope="session")
+def benchmark(pytestconfig):
+    device = pytestconfig.getoption("device")
+    update = pytestconfig.getoption("benchmark_update_baseline")
+    session = BenchmarkSession.load(
+        device,
+        pytestconfig.getoption("benchmark_rounds"),
+        pytestconfig.getoption("benchmark_tolerance"),
+        None if update else pytestconfig.getoption("benchmark_baseline") or baseline_path(device),
+    )
+    yield session
+    if not session.results:
+        return
+    output = pytestconfig.getoption("benchmark_output")
+    if output is not None:
+        session.save(output)
+    if update:
+        session.save(baseline_path(device))
@@ -0,0 +1,56 @@
+"""Per-command latency of the application on Speculos.
+
+Only run with --benchmark, see usage.md. Every review is approved without screen comparison,
+so the measured time covers the APDU exchanges and the navigation through the review.
+"""
+
+from json import load
+
+import pytest
+from apps.nem import MAINNET, NemClient
+from apps.nem_transaction_builder import encode_txn_context
+from benchmark import BenchmarkSession
+from ragger.backend import BackendInterface
+from ragger.navigator.navigation_scenario import NavigateWithScenario
+from utils import CORPUS_DIR, CORPUS_FILES
+
+# Proposed NEM derivation paths for tests ###
+NEM_PATH = "m/44'/43'/0'/0'/0'"
+
+pytestmark = pytest.mark.benchmark
+
+
+def load_transaction_from_file(transaction_filename: str) -> bytes:
+    with open(CORPUS_DIR / transaction_filename, encoding="utf-8") as f:
+        transaction = load(f)
+    return encode_txn_context(transaction)
+
+
+def test_benchmark_get_public_key(backend: BackendInterface, benchmark: BenchmarkSession):
+    client = NemClient(backend)
+    benchmark.measure("get_public_key", lambda: client.send_get_public_key_non_confirm(NEM_PATH, MAINNET))
+    benchmark.check("get_public_key")
+
+
+def test_benchmark_get_remote_account(backend: BackendInterface, benchmark: BenchmarkSession):
+    client = NemClient(backend)
+    benchmark.measure("get_remote_account", lambda: client.send_get_remote_account_non_confirm(NEM_PATH))
+    benchmark.check("get_remote_account")
+
+
+@pytest.mark.parametrize("transaction_filename", CORPUS_FILES)
+def test_benchmark_sign_tx(
+    transaction_filename: str, scenario_navigator: NavigateWithScenario, benchmark: BenchmarkSession
+):
+    transaction = load_transaction_from_file(transaction_filename)
+    client = NemClient(scenario_navigator.backend)
+
+    def sign() -> None:
+        with client.send_async_sign_message(NEM_PATH, transaction):
+            scenario_navigator.review_approve(do_comparison=False)
+        response = client.get_async_response()
+        assert response is not None and len(response.data) == 64
+
+    name = "sign/" + transaction_filename.replace(".json", "")
+    benchmark.measure(name, sign)
+    benchmark.check(name)
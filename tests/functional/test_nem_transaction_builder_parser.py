@@ -1,6 +1,7 @@
 from json import load
 
 from apps.nem_transaction_builder import encode_txn_context
+from apps.nem_transaction_generator import MAX_FIELD_COUNT, MAX_RAW_TX, TransactionGenerator, count_fields
 from apps.nem_transaction_parser import decode_txn_context
 from utils import CORPUS_DIR, CORPUS_FILES
 
@@ -13,3 +14,14 @@ def test_nem_builder_parser():
         transaction_bytes = encode_txn_context(transaction)
         transaction_decoded = decode_txn_context(transaction_bytes)
         assert transaction == transaction_decoded
+
+
+def test_nem_builder_parser_generated():
+    for seed, scale in enumerate([0.1, 0.5, 1.0]):
+        generator = TransactionGenerator(seed, scale)
+        for _ in range(100):
+            transaction = generator.generate()
+            transaction_bytes = encode_txn_context(transaction)
+            assert len(transaction_bytes) <= MAX_RAW_TX
+            assert count_fields(transaction) <= MAX_FIELD_COUNT
+            assert transaction == decode_txn_context(transaction_bytes)
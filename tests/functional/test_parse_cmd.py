@@ -0,0 +1,48 @@
+from json import load
+
+import pytest
+from apps.nem import CLA, INS, P1_MORE_FIELDS, SUMMARY_FIELD_ID, ErrorType, NemClient
+from apps.nem_transaction_builder import encode_txn_context
+from ragger.backend import BackendInterface
+from ragger.error import ExceptionRAPDU
+from utils import CORPUS_DIR, CORPUS_FILES
+
+# Proposed NEM derivation paths for tests ###
+NEM_PATH = "m/44'/43'/0'/0'/0'"
+
+
+def load_transaction_from_file(transaction_filename: str) -> bytes:
+    with open(CORPUS_DIR / transaction_filename, encoding="utf-8") as f:
+        transaction = load(f)
+    return encode_txn_context(transaction)
+
+
+@pytest.mark.parametrize("transaction_filename", CORPUS_FILES)
+def test_parse_tx(transaction_filename: str, backend: BackendInterface):
+    transaction = load_transaction_from_file(transaction_filename)
+    client = NemClient(backend)
+    fields = client.send_parse_transaction(NEM_PATH, transaction)
+    # The summary pairs, when the review has a summary page, come before the fields
+    fields = [field for field in fields if field.id != SUMMARY_FIELD_ID]
+    assert len(fields) > 1
+    assert fields[0].name == "Transaction Type"
+    assert all(field.value for field in fields)
+
+
+def test_parse_tx_fields(backend: BackendInterface):
+    transaction = load_transaction_from_file("transfer_tx.json")
+    client = NemClient(backend)
+    fields = client.send_parse_transaction(NEM_PATH, transaction)
+    assert [(field.name, field.value) for field in fields] == [
+        ("Transaction Type", "Transfer TX"),
+        ("Recipient", "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O"),
+        ("Amount", "5 XEM"),
+        ("Message", "ttest"),
+        ("Fee", "0.1 XEM"),
+    ]
+
+
+def test_parse_tx_more_fields_without_transaction(backend: BackendInterface):
+    with pytest.raises(ExceptionRAPDU) as e:
+        backend.exchange(CLA, INS.INS_PARSE_TRANSACTION, P1_MORE_FIELDS, 0, b"")
+    assert e.value.status == ErrorType.SW_INVALID_DATA
@@ -1,11 +1,14 @@
-from apps.nem import ErrorType, NemClient
+from apps.nem import MAX_REMOTE_ACCOUNTS, ErrorType, NemClient
 from ragger.backend import BackendInterface, SpeculosBackend
 from ragger.backend.interface import RaisePolicy
 from ragger.navigator import Navigator, NavInsID
+from ragger.navigator.navigation_scenario import NavigateWithScenario
 from utils import ROOT_SCREENSHOT_PATH
 
 # Proposed NEM derivation paths for tests ###
 NEM_PATH = "m/44'/43'/0'/0'/0'"
+# Accounts of harvesting nodes exported together, more than the keys of one response
+NEM_NODE_PATHS = [f"m/44'/43'/{account}'/0'/0'" for account in range(10)]
 
 SPECULOS_EXPECTED_DELEGATED_HARVESTING_KEY = "328a20f8900fd5e2fc0f9f02d949feb66a8a448f8822c914b22aba9bcddaa46f"
 
@@ -67,3 +70,30 @@ def test_get_remote_account_confirm_refused(backend: BackendInterface, navigator
     rapdu = client.get_async_response()
     assert rapdu and rapdu.status == ErrorType.SW_USER_REJECTED
     assert len(rapdu.data) == 0
+
+
+def test_get_remote_accounts_accepted(scenario_navigator: NavigateWithScenario):
+    client = NemClient(scenario_navigator.backend)
+    with client.send_async_get_remote_accounts(NEM_NODE_PATHS):
+        scenario_navigator.review_approve(custom_screen_text="Export keys", do_comparison=False)
+    response = client.get_async_response()
+    assert response is not None
+    keys = client.get_remote_accounts_keys(response.data)
+
+    # Same keys as the ones exported one by one
+    assert len(keys) == len(NEM_NODE_PATHS)
+    check_get_remote_account_resp(scenario_navigator.backend, keys[0])
+    for path, key in zip(NEM_NODE_PATHS, keys, strict=True):
+        response = client.send_get_remote_account_non_confirm(path).data
+        assert client.parse_get_remote_account_response(response) == key
+
+
+def test_get_remote_accounts_too_many(backend: BackendInterface):
+    client = NemClient(backend)
+    paths = [f"m/44'/43'/{account}'/0'/0'" for account in range(MAX_REMOTE_ACCOUNTS + 1)]
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+    # Rejected before any review
+    with client.send_async_get_remote_accounts(paths):
+        pass
+    rapdu = client.get_async_response()
+    assert rapdu and rapdu.status == ErrorType.SW_WRONG_LENGTH
@@ -1,8 +1,10 @@
 import re
 from pathlib import Path
 
-from apps.nem import NemClient
+import pytest
+from apps.nem import CLA, INS, TX_TYPE_MASK_ALL, TX_TYPE_MASK_TRANSFER, ErrorType, NemClient
 from ragger.backend import BackendInterface
+from ragger.error import ExceptionRAPDU
 
 
 def verify_version(version: str) -> None:
@@ -45,3 +47,27 @@ def test_version(backend: BackendInterface):
     # Send the GET_VERSION instruction
     (MAJOR, MINOR, PATCH) = client.send_get_version()
     verify_version(f"{MAJOR}.{MINOR}.{PATCH}")
+
+
+# In this test we check the capability descriptor appended to the app version
+def test_app_capabilities(backend: BackendInterface):
+    client = NemClient(backend)
+    capabilities = client.send_get_app_capabilities()
+    (MAJOR, MINOR, PATCH) = capabilities.version
+    verify_version(f"{MAJOR}.{MINOR}.{PATCH}")
+    assert capabilities.protocol_version >= 1
+    assert capabilities.max_raw_tx > 0
+    assert capabilities.max_field_count > 0
+    assert capabilities.chunk_size == 255
+    for ins in INS:
+        assert ins in capabilities.supported_ins
+    # Every build signs transfers, and no bit is set outside of the known types
+    assert capabilities.tx_types & TX_TYPE_MASK_TRANSFER
+    assert capabilities.tx_types & ~TX_TYPE_MASK_ALL == 0
+
+
+# P1 other than the version and the capabilities is rejected since version 0.0.13
+def test_app_configuration_invalid_p1(backend: BackendInterface):
+    with pytest.raises(ExceptionRAPDU) as e:
+        backend.exchange(CLA, INS.INS_GET_APP_CONFIGURATION, 0x02, 0, b"")
+    assert e.value.status == ErrorType.SW_INVALID_P1P2
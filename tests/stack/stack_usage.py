@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Worst-case stack depth of the APDU handlers and UI callbacks.
+
+Combines the frame sizes of the -fstack-usage output (.su files) with the call graph of the
+linked application, extracted from its disassembly, and reports for each root function the
+deepest call chain. Fails when a depth exceeds the budget: the stack size of the application
+(_estack - _stack in the ELF) minus a reserve for the frames below the handlers (main loop, I/O,
+NBGL event dispatch), or an explicit per-device budget.
+
+The call graph only has direct calls: functions calling through a pointer are reported, and the
+roots list the callbacks reached that way. Functions without frame size (SDK libraries built
+without -fstack-usage, assembly) count as 0 bytes and are reported.
+"""
+
+import argparse
+import json
+import re
+import shutil
+import subprocess
+import sys
+from collections import defaultdict
+from pathlib import Path
+
+# Function start in the disassembly: "0000c0de <name>:"
+FUNCTION_RE = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+# Direct call or tail call to a symbol: ARM bl/blx/b.w, x86 call/jmp
+CALL_RE = re.compile(r"\s(bl|blx|b|b\.w|call|callq|jmp|jmpq)\s+(?:0x)?[0-9a-f]+ <([^>+]+)(\+0x[0-9a-f]+)?>")
+# Call through a register
+INDIRECT_CALL_RE = re.compile(r"\s(blx\s+r\d+|blx\s+(ip|lr)|call\s+\*|callq\s+\*)")
+
+
+def parse_stack_usage(su_dir):
+    """Frame size and qualifier of each function, the largest one for duplicated static names."""
+    frames = {}
+    for path in Path(su_dir).rglob("*.su"):
+        with open(path, encoding="utf-8") as f:
+            for line in f:
+                location, size, qualifier = line.rstrip("\n").split("\t")
+                name = location.rsplit(":", 1)[1]
+                # C++ and clang may print a signature
+                name = name.split("(")[0].strip()
+                size = int(size)
+                if name not in frames or frames[name][0] < size:
+                    frames[name] = (size, qualifier)
+    return frames
+
+
+def parse_call_graph(objdump, elf):
+    """Direct callees, and whether there are indirect calls, of each function of the ELF."""
+    output = subprocess.run(
+        [objdump, "-d", "--no-show-raw-insn", str(elf)], capture_output=True, text=True, check=True
+    ).stdout
+    callees = defaultdict(set)
+    indirect = set()
+    current = None
+    for line in output.splitlines():
+        match = FUNCTION_RE.match(line)
+        if match:
+            current = match.group(2)
+            callees[current]
+            continue
+        if current is None:
+            continue
+        match = CALL_RE.search(line)
+        if match:
+            callee = match.group(2).split("@")[0]
+            # Branches inside the function are not calls
+            if callee != current or match.group(1).startswith(("bl", "call")):
+                callees[current].add(callee)
+        elif INDIRECT_CALL_RE.search(line):
+            indirect.add(current)
+    return callees, indirect
+
+
+def elf_stack_size(elf):
+    """_estack - _stack of the application, None if the symbols are not defined."""
+    readelf = shutil.which("llvm-readelf") or "readelf"
+    output = subprocess.run([readelf, "-sW", str(elf)], capture_output=True, text=True, check=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 8 and fields[7] in ("_stack", "_estack"):
+            symbols[fields[7]] = int(fields[1], 16)
+    if "_stack" in symbols and "_estack" in symbols:
+        return symbols["_estack"] - symbols["_stack"]
+    return None
+
+
+class StackAnalysis:
+    def __init__(self, frames, callees, indirect):
+        self.frames = frames
+        self.callees = callees
+        self.indirect = indirect
+        self.unknown = set()
+        self.recursive = set()
+        self.memo = {}
+
+    def frame(self, function):
+        if function not in self.frames:
+            self.unknown.add(function)
+            return 0
+        return self.frames[function][0]
+
+    def reachable(self, roots):
+        reached = set()
+        pending = list(roots)
+        while pending:
+            function = pending.pop()
+            if function not in reached:
+                reached.add(function)
+                pending.extend(self.callees.get(function, ()))
+        return reached
+
+    def worst_path(self, function, stack=()):
+        """Deepest (depth, call chain) from the function, recursion counted once."""
+        if function in self.memo:
+            return self.memo[function]
+        if function in stack:
+            self.recursive.add(function)
+            return 0, []
+        best = (0, [])
+        for callee in sorted(self.callees.get(function, ())):
+            depth, path = self.worst_path(callee, (*stack, function))
+            if depth > best[0]:
+                best = (depth, path)
+        result = (self.frame(function) + best[0], [function, *best[1]])
+        self.memo[function] = result
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--elf", type=Path, required=True, help="Linked application")
+    parser.add_argument("--su-dir", type=Path, required=True, help="Directory searched for .su files")
+    parser.add_argument("--config", type=Path, default=Path(__file__).parent / "stack_usage.json", help="Roots and budgets")
+    parser.add_argument("--device", help="Device of the build, selects the budget of the configuration")
+    parser.add_argument("--budget", type=int, help="Budget in bytes, overrides the configuration and the ELF stack size")
+    parser.add_argument("--objdump", default=shutil.which("llvm-objdump") or "objdump", help="Disassembler to use")
+    parser.add_argument("--json", type=Path, help="Also write the report to this JSON file")
+    parser.add_argument("--verbose", action="store_true", help="Print the deepest call chain of each root")
+    args = parser.parse_args()
+
+    with open(args.config, encoding="utf-8") as f:
+        config = json.load(f)
+
+    frames = parse_stack_usage(args.su_dir)
+    if not frames:
+        sys.exit(f"No .su file in {args.su_dir}: build with -fstack-usage (make STACK_USAGE=1)")
+    callees, indirect = parse_call_graph(args.objdump, args.elf)
+
+    budget = args.budget
+    if budget is None:
+        budget = config.get("budgets", {}).get(args.device)
+    if budget is None:
+        stack_size = elf_stack_size(args.elf)
+        if stack_size is None:
+            sys.exit("No budget: the ELF does not define _stack and _estack, use --budget")
+        budget = stack_size - config["reserve"]
+
+    analysis = StackAnalysis(frames, callees, indirect)
+    report = {"device": args.device, "budget": budget, "roots": {}}
+    status = 0
+    print(f"{'root':<32}{'depth':>8}{'budget':>8}  {'':<4}chain")
+    for root, description in config["roots"].items():
+        if root not in callees:
+            print(f"{root:<32}{'-':>8}{budget:>8}  not in the ELF")
+            continue
+        depth, path = analysis.worst_path(root)
+        over = depth > budget
+        status |= over
+        report["roots"][root] = {"description": description, "depth": depth, "path": path}
+        chain = " > ".join(path) if args.verbose else f"{description}, {len(path)} frames"
+        print(f"{root:<32}{depth:>8}{budget:>8}  {'FAIL' if over else 'ok':<4}{chain}")
+
+    reached = analysis.reachable(report["roots"])
+    dynamic = sorted(f for f in reached if f in frames and frames[f][1] != "static")
+    notes = {
+        "dynamic stack size": dynamic,
+        "indirect calls": sorted(reached & indirect),
+        "recursion": sorted(analysis.recursive),
+        "no frame size": sorted(f for f in reached if f not in frames),
+    }
+    for note, functions in notes.items():
+        if functions:
+            print(f"{note}: {', '.join(functions)}")
+    report.update(notes)
+
+    if args.json is not None:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -13,6 +13,7 @@ from nem import TESTNET, NemClient  # noqa: E402
 parser = argparse.ArgumentParser()
 parser.add_argument("--path", help="BIP 32 path to use")
 parser.add_argument("--confirm", help="Request confirmation", action="store_true")
+parser.add_argument("--trace", help="Record the APDU exchanges to this file (see tests/unit/apdu_replay)")
 args = parser.parse_args()
 
 if args.path is None:
@@ -20,7 +21,9 @@ if args.path is None:
     args.path = "m/44'/1'/0'/0'/0'"
 
 
-with LedgerCommBackend(None, interface="hid") as backend:
+trace_file = Path(args.trace) if args.trace else None
+
+with LedgerCommBackend(None, interface="hid", log_apdu_file=trace_file) as backend:
     nem = NemClient(backend)
 
     if args.confirm:
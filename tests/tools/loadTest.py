@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Sustained signing load on parallel Speculos instances.
+
+Each worker starts its own emulator (API and APDU ports offset by the worker index), then signs
+corpus transactions drawn from the requested mix until the duration elapses, approving every
+review through the emulator automation. Reports signatures per second and latency percentiles
+per transaction type.
+"""
+
+import argparse
+import json
+import random
+import statistics
+import sys
+import threading
+import time
+from collections import defaultdict
+from pathlib import Path
+
+from ragger.backend import SpeculosBackend
+from ragger.firmware import Firmware
+from ragger.navigator import NanoNavigator, NavInsID, TouchNavigator
+
+NEM_LIB_DIRECTORY = (Path(__file__).parent / "../functional/apps").resolve().as_posix()
+sys.path.append(NEM_LIB_DIRECTORY)
+from nem_transaction_builder import encode_txn_context  # noqa: E402
+
+from nem import NemClient  # noqa: E402
+
+CORPUS_DIR = Path(__file__).parent.parent / "corpus"
+BUILD_DIR = Path(__file__).parent.parent.parent / "build"
+# Build directory of each model, as named by the SDK
+BUILD_TARGETS = {"nanosp": "nanos2", "nanox": "nanox", "stax": "stax", "flex": "flex", "apex_p": "apex_p"}
+TX_TYPES = ("transfer", "mosaic", "multisig", "namespace", "importance")
+
+
+def transaction_type(filename: str) -> str:
+    # Multisig first: the inner transaction of a multisig is not what drives its cost.
+    # Importance before transfer, as in importance_transfer_tx.json
+    for tx_type in ("multisig", "importance", "mosaic", "namespace", "transfer"):
+        if tx_type in filename:
+            return tx_type
+    raise ValueError(f"unknown transaction type for {filename}")
+
+
+def load_corpus() -> dict[str, list[bytes]]:
+    corpus = defaultdict(list)
+    for path in sorted(CORPUS_DIR.glob("*.json")):
+        with open(path, encoding="utf-8") as f:
+            corpus[transaction_type(path.name)].append(encode_txn_context(json.load(f)))
+    return corpus
+
+
+def parse_mix(mix: str) -> dict[str, float]:
+    weights = {}
+    for item in mix.split(","):
+        tx_type, _, weight = item.partition("=")
+        if tx_type not in TX_TYPES:
+            raise argparse.ArgumentTypeError(f"unknown transaction type '{tx_type}', expected one of {TX_TYPES}")
+        weights[tx_type] = float(weight or 1)
+    return weights
+
+
+def percentile(samples: list[float], p: float) -> float:
+    ordered = sorted(samples)
+    return ordered[min(len(ordered) - 1, int(p / 100 * len(ordered)))]
+
+
+class Worker(threading.Thread):
+    def __init__(self, index: int, args: argparse.Namespace, corpus: dict[str, list[bytes]]):
+        super().__init__(name=f"speculos-{index}")
+        self.index = index
+        self.args = args
+        self.corpus = corpus
+        self.loop_time = 0.0
+        self.rng = random.Random(args.seed + index)
+        self.latencies: dict[str, list[float]] = defaultdict(list)
+        self.failures = 0
+        self.error: Exception | None = None
+
+    def approve(self, navigator, firmware: Firmware) -> None:
+        if firmware.is_nano:
+            navigator.navigate_until_text(NavInsID.RIGHT_CLICK, [NavInsID.BOTH_CLICK], "Sign transaction")
+        else:
+            navigator.navigate_until_text(NavInsID.SWIPE_CENTER_TO_LEFT, [NavInsID.USE_CASE_REVIEW_CONFIRM], "Hold to sign")
+
+    def run(self) -> None:
+        firmware = Firmware[self.args.model.upper()]
+        speculos_args = ["--apdu-port", str(self.args.apdu_port + self.index)]
+        try:
+            with SpeculosBackend(self.args.app, firmware, port=self.args.api_port + self.index, args=speculos_args) as backend:
+                nem = NemClient(backend)
+                navigator_class = NanoNavigator if firmware.is_nano else TouchNavigator
+                navigator = navigator_class(backend, firmware, golden_run=False)
+                types = list(self.args.mix)
+                weights = [self.args.mix[t] for t in types]
+                # The emulator boot is not part of the measured window
+                loop_start = time.perf_counter()
+                while time.perf_counter() - loop_start < self.args.duration:
+                    tx_type = self.rng.choices(types, weights)[0]
+                    message = self.rng.choice(self.corpus[tx_type])
+                    start = time.perf_counter()
+                    with nem.send_async_sign_message(self.args.path, message):
+                        self.approve(navigator, firmware)
+                    rapdu = nem.get_async_response()
+                    if rapdu is None or rapdu.status != 0x9000:
+                        self.failures += 1
+                        continue
+                    self.latencies[tx_type].append((time.perf_counter() - start) * 1000)
+                self.loop_time = time.perf_counter() - loop_start
+        except Exception as e:  # reported by the main thread
+            self.error = e
+
+
+def report(workers: list[Worker]) -> dict:
+    latencies = defaultdict(list)
+    for worker in workers:
+        for tx_type, samples in worker.latencies.items():
+            latencies[tx_type].extend(samples)
+    total = sum(len(samples) for samples in latencies.values())
+    # Mean measured window of the instances that ran
+    elapsed = statistics.fmean([worker.loop_time for worker in workers if worker.loop_time] or [float("inf")])
+    result = {
+        "instances": len(workers),
+        "window_s": round(elapsed, 1),
+        "signatures": total,
+        "failures": sum(worker.failures for worker in workers),
+        "signatures_per_s": round(total / elapsed, 3),
+        "types": {},
+    }
+    print(f"{'type':<12}{'count':>8}{'sig/s':>9}{'p50 ms':>10}{'p95 ms':>10}{'p99 ms':>10}{'mean ms':>10}")
+    for tx_type in sorted(latencies):
+        samples = latencies[tx_type]
+        stats = {
+            "count": len(samples),
+            "signatures_per_s": round(len(samples) / elapsed, 3),
+            "p50_ms": round(percentile(samples, 50), 1),
+            "p95_ms": round(percentile(samples, 95), 1),
+            "p99_ms": round(percentile(samples, 99), 1),
+            "mean_ms": round(statistics.fmean(samples), 1),
+        }
+        result["types"][tx_type] = stats
+        print(
+            f"{tx_type:<12}{stats['count']:>8}{stats['signatures_per_s']:>9.2f}"
+            f"{stats['p50_ms']:>10.1f}{stats['p95_ms']:>10.1f}{stats['p99_ms']:>10.1f}{stats['mean_ms']:>10.1f}"
+        )
+    print(f"total: {total} signatures in {elapsed:.1f} s on {len(workers)} instances, {result['signatures_per_s']:.2f} sig/s")
+    if result["failures"]:
+        print(f"failures: {result['failures']}")
+    return result
+
+
+parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+parser.add_argument("--model", choices=BUILD_TARGETS, default="nanox", help="Device model to emulate")
+parser.add_argument("--app", type=Path, help="Application ELF (default: build/<target>/bin/app.elf)")
+parser.add_argument("--instances", type=int, default=4, help="Number of parallel Speculos instances")
+parser.add_argument("--duration", type=float, default=60, help="Duration of the load in seconds")
+parser.add_argument(
+    "--mix",
+    type=parse_mix,
+    default="transfer=4,mosaic=2,multisig=2,namespace=1",
+    help="Weighted transaction types, e.g. transfer=4,mosaic=2,multisig=2,namespace=1",
+)
+parser.add_argument("--path", default="m/44'/43'/0'/0'/0'", help="BIP 32 path to use")
+parser.add_argument("--api-port", type=int, default=5000, help="Speculos API port of the first instance")
+parser.add_argument("--apdu-port", type=int, default=9999, help="Speculos APDU port of the first instance")
+parser.add_argument("--seed", type=int, default=0, help="Seed of the transaction draw")
+parser.add_argument("--json", type=Path, help="Also write the report to this JSON file")
+args = parser.parse_args()
+
+if args.app is None:
+    args.app = BUILD_DIR / BUILD_TARGETS[args.model] / "bin" / "app.elf"
+
+corpus = load_corpus()
+for tx_type in args.mix:
+    if not corpus[tx_type]:
+        parser.error(f"no {tx_type} transaction in {CORPUS_DIR}")
+
+workers = [Worker(i, args, corpus) for i in range(args.instances)]
+for worker in workers:
+    worker.start()
+for worker in workers:
+    worker.join()
+
+for worker in workers:
+    if worker.error is not None:
+        print(f"{worker.name}: {worker.error!r}", file=sys.stderr)
+
+result = report(workers)
+if args.json is not None:
+    with open(args.json, "w", encoding="utf-8") as f:
+        json.dump(result, f, indent=2)
+        f.write("\n")
+
+sys.exit(1 if result["failures"] or any(worker.error for worker in workers) else 0)
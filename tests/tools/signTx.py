@@ -16,6 +16,7 @@ from nem import NemClient  # noqa: E402
 parser = argparse.ArgumentParser()
 parser.add_argument("--path", help="BIP 32 path to use")
 parser.add_argument("--file", help="Transaction in JSON format")
+parser.add_argument("--trace", help="Record the APDU exchanges to this file (see tests/unit/apdu_replay)")
 args = parser.parse_args()
 
 if args.path is None:
@@ -29,7 +30,9 @@ with open(args.file, encoding="utf-8") as f:
     obj = json.load(f)
 message = encode_txn_context(obj)
 
-with LedgerCommBackend(None, interface="hid") as backend:
+trace_file = Path(args.trace) if args.trace else None
+
+with LedgerCommBackend(None, interface="hid", log_apdu_file=trace_file) as backend:
     nem = NemClient(backend)
 
     with nem.send_async_sign_message(args.path, message):
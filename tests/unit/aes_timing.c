@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aes.h"
+
+// Times the AES-128 CBC of src/aes.c, as built: the key setup and the encryption of a delegated
+// harvesting key done by GET_REMOTE_ACCOUNT, then the encryption and decryption of a larger
+// buffer. Prints the fastest of the timed iterations of each operation in nanoseconds.
+//
+// Usage: aes_timing [iterations]
+
+#define DEFAULT_ITERATIONS  1000
+#define NANOSECONDS_PER_SEC 1000000000LL
+// Delegated harvesting key encrypted by nem_get_remote_private_key()
+#define REMOTE_KEY_LENGTH 32
+#define BULK_LENGTH       4096
+
+typedef enum {
+    KEY_SETUP,
+    REMOTE_KEY,
+    BULK_ENCRYPT,
+    BULK_DECRYPT,
+} operation_e;
+
+static const char *const OPERATION_NAMES[] = {
+    "key setup",
+    "remote key (32 B)",
+    "encrypt (4096 B)",
+    "decrypt (4096 B)",
+};
+
+static uint8_t key[AES_KEYLEN];
+static uint8_t iv[AES_BLOCKLEN];
+static uint8_t buf[BULK_LENGTH];
+static struct AES_ctx ctx;
+
+static void run_operation(operation_e operation) {
+    switch (operation) {
+        case KEY_SETUP:
+            AES_init_ctx_iv(&ctx, key, iv);
+            break;
+        case REMOTE_KEY:
+            AES_init_ctx_iv(&ctx, key, iv);
+            AES_CBC_encrypt_buffer(&ctx, buf, REMOTE_KEY_LENGTH);
+            break;
+        case BULK_ENCRYPT:
+            AES_CBC_encrypt_buffer(&ctx, buf, BULK_LENGTH);
+            break;
+        case BULK_DECRYPT:
+            AES_CBC_decrypt_buffer(&ctx, buf, BULK_LENGTH);
+            break;
+    }
+}
+
+static long long elapsed_ns(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * NANOSECONDS_PER_SEC + (end->tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t) i;
+    }
+    AES_init_ctx_iv(&ctx, key, iv);
+
+    printf("AES_TTABLE=%d\n", AES_TTABLE);
+    for (operation_e operation = KEY_SETUP; operation <= BULK_DECRYPT; operation++) {
+        long long fastest = -1;
+        for (int i = 0; i < iterations; i++) {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            run_operation(operation);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            long long duration = elapsed_ns(&start, &end);
+            if (fastest < 0 || duration < fastest) {
+                fastest = duration;
+            }
+        }
+        printf("%-20s %9lld ns\n", OPERATION_NAMES[operation], fastest);
+    }
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+#include "entry.h"
+#include "global.h"
+
+/*
+ * Replays recorded APDU exchanges against the host build of the application dispatcher.
+ *
+ * A trace is a text file where "=>" lines hold a command and the following "<=" line, if any,
+ * the expected response (data followed by the status word), both in hexadecimal. Any text
+ * before the arrow is ignored, so logs prefixed with a transport name ("HID =>") can be
+ * replayed as is. Lines starting with '#' are comments.
+ *
+ * Confirmations are approved (or rejected with --reject) right after the command handler has
+ * returned; the reported CPU time covers the handler and the review formatting.
+ */
+
+#define MAX_EXCHANGES 4096
+#define MAX_LINE_LEN  4096
+
+typedef struct {
+    uint8_t command[IO_APDU_BUFFER_SIZE];
+    size_t commandLength;
+    uint8_t expected[IO_APDU_BUFFER_SIZE];
+    size_t expectedLength;
+    bool hasExpected;
+    unsigned int line;
+    // Smallest CPU time over the repetitions, in nanoseconds
+    uint64_t cpuTime;
+} exchange_t;
+
+typedef struct {
+    unsigned int count;
+    uint64_t total;
+    uint64_t max;
+} ins_stats_t;
+
+static exchange_t exchanges[MAX_EXCHANGES];
+static ins_stats_t insStats[256];
+
+static int parse_hex(const char *text, uint8_t *out, size_t outSize, size_t *outLen) {
+    size_t length = 0;
+    int high = -1;
+    for (; *text != '\0'; text++) {
+        if (isspace((unsigned char) *text)) {
+            continue;
+        }
+        if (!isxdigit((unsigned char) *text) || length == outSize) {
+            return -1;
+        }
+        int nibble = isdigit((unsigned char) *text) ? *text - '0'
+                                                    : tolower((unsigned char) *text) - 'a' + 10;
+        if (high < 0) {
+            high = nibble;
+        } else {
+            out[length++] = (uint8_t) (high << 4 | nibble);
+            high = -1;
+        }
+    }
+    if (high >= 0) {
+        return -1;
+    }
+    *outLen = length;
+    return 0;
+}
+
+static int load_trace(const char *filename, size_t *count) {
+    char line[MAX_LINE_LEN];
+    unsigned int lineNumber = 0;
+    FILE *f = fopen(filename, "r");
+    if (f == NULL) {
+        fprintf(stderr, "File opening failed %s\n", filename);
+        return -1;
+    }
+
+    *count = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineNumber++;
+        const char *command = strstr(line, "=>");
+        const char *response = strstr(line, "<=");
+        if (line[0] == '#' || (command == NULL && response == NULL)) {
+            continue;
+        }
+        if (command != NULL) {
+            if (*count == MAX_EXCHANGES) {
+                fprintf(stderr, "%s: too many commands\n", filename);
+                break;
+            }
+            exchange_t *exchange = &exchanges[(*count)++];
+            memset(exchange, 0, sizeof(exchange_t));
+            exchange->line = lineNumber;
+            if (parse_hex(command + 2,
+                          exchange->command,
+                          sizeof(exchange->command),
+                          &exchange->commandLength) != 0) {
+                fprintf(stderr, "%s:%u: invalid command\n", filename, lineNumber);
+                fclose(f);
+                return -1;
+            }
+        } else {
+            exchange_t *exchange = *count > 0 ? &exchanges[*count - 1] : NULL;
+            if (exchange == NULL || exchange->hasExpected ||
+                parse_hex(response + 2,
+                          exchange->expected,
+                          sizeof(exchange->expected),
+                          &exchange->expectedLength) != 0 ||
+                exchange->expectedLength < 2) {
+                fprintf(stderr, "%s:%u: invalid response\n", filename, lineNumber);
+                fclose(f);
+                return -1;
+            }
+            exchange->hasExpected = true;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static uint64_t cpu_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+// Same steps as app_main() for one command, followed by the user answer
+static void run_command(exchange_t *exchange) {
+    command_t cmd;
+
+    host_io_reset();
+    memcpy(G_io_apdu_buffer, exchange->command, exchange->commandLength);
+    uint64_t start = cpu_time_ns();
+    if (!apdu_parser(&cmd, G_io_apdu_buffer, exchange->commandLength)) {
+        io_send_sw(SWO_WRONG_DATA_LENGTH);
+    } else if (handle_apdu(&cmd) >= 0) {
+        host_ui_resolve();
+    }
+    uint64_t elapsed = cpu_time_ns() - start;
+    if (exchange->cpuTime == 0 || elapsed < exchange->cpuTime) {
+        exchange->cpuTime = elapsed;
+    }
+}
+
+static void print_bytes(const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        printf("%02x", data[i]);
+    }
+}
+
+// Returns true when the response matches the expected one, or when none was recorded
+static bool check_response(const char *filename, const exchange_t *exchange, bool quiet) {
+    uint8_t received[IO_APDU_BUFFER_SIZE];
+    size_t receivedLength = 0;
+    bool match = true;
+
+    if (hostResponse.count > 0) {
+        memcpy(received, hostResponse.data, hostResponse.length);
+        received[hostResponse.length] = (uint8_t) (hostResponse.sw >> 8);
+        received[hostResponse.length + 1] = (uint8_t) hostResponse.sw;
+        receivedLength = hostResponse.length + 2;
+    }
+    if (exchange->hasExpected) {
+        match = hostResponse.count == 1 && !hostResponse.overflow &&
+                receivedLength == exchange->expectedLength &&
+                memcmp(received, exchange->expected, receivedLength) == 0;
+    }
+
+    if (!quiet || !match) {
+        printf("%s:%u INS=%02x ", filename, exchange->line, exchange->command[1]);
+        if (hostResponse.count == 0) {
+            printf("SW=----");
+        } else {
+            printf("SW=%04x", hostResponse.sw);
+        }
+        printf(" cpu=%.1fus %s\n",
+               exchange->cpuTime / 1000.0,
+               !exchange->hasExpected ? "-" : (match ? "OK" : "MISMATCH"));
+    }
+    if (!match) {
+        printf("    expected ");
+        print_bytes(exchange->expected, exchange->expectedLength);
+        printf("\n    received ");
+        if (hostResponse.count == 0) {
+            printf("no response");
+        } else if (hostResponse.count > 1) {
+            printf("%u responses, last ", hostResponse.count);
+        }
+        print_bytes(received, receivedLength);
+        printf("\n");
+    }
+    return match;
+}
+
+static int replay_trace(const char *filename, unsigned int repeat, bool quiet) {
+    size_t count;
+    int mismatches = 0;
+
+    if (load_trace(filename, &count) != 0) {
+        return -1;
+    }
+    for (unsigned int r = 0; r < repeat; r++) {
+        // Each trace starts from a freshly started application
+        reset_transaction_context();
+        for (size_t i = 0; i < count; i++) {
+            run_command(&exchanges[i]);
+            // Responses are only checked on the last repetition, timings on all of them
+            if (r + 1 == repeat) {
+                if (!check_response(filename, &exchanges[i], quiet)) {
+                    mismatches++;
+                }
+                ins_stats_t *stats = &insStats[exchanges[i].command[1]];
+                stats->count++;
+                stats->total += exchanges[i].cpuTime;
+                if (exchanges[i].cpuTime > stats->max) {
+                    stats->max = exchanges[i].cpuTime;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [--reject] [--repeat N] [--quiet] <trace>...\n", name);
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int repeat = 1;
+    bool quiet = false;
+    int mismatches = 0;
+    int first = 1;
+
+    for (; first < argc && strncmp(argv[first], "--", 2) == 0; first++) {
+        if (strcmp(argv[first], "--reject") == 0) {
+            host_ui_set_policy(HOST_UI_REJECT);
+        } else if (strcmp(argv[first], "--quiet") == 0) {
+            quiet = true;
+        } else if (strcmp(argv[first], "--repeat") == 0 && first + 1 < argc) {
+            repeat = (unsigned int) strtoul(argv[++first], NULL, 10);
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (first == argc || repeat == 0) {
+        usage(argv[0]);
+    }
+
+    for (int i = first; i < argc; i++) {
+        int res = replay_trace(argv[i], repeat, quiet);
+        if (res < 0) {
+            return 1;
+        }
+        mismatches += res;
+    }
+
+    printf("\n INS  count   avg cpu (us)   max cpu (us)\n");
+    for (int ins = 0; ins < 256; ins++) {
+        const ins_stats_t *stats = &insStats[ins];
+        if (stats->count > 0) {
+            printf("  %02x  %5u  %13.1f  %13.1f\n",
+                   ins,
+                   stats->count,
+                   stats->total / 1000.0 / stats->count,
+                   stats->max / 1000.0);
+        }
+    }
+    printf("\n%d mismatch(es)\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_HOST_H
+#define LEDGER_APP_NEM_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "io.h"
+
+// Maximum response data, without the status word
+#define HOST_RESPONSE_MAX_LEN (IO_APDU_BUFFER_SIZE - 2)
+
+typedef struct {
+    // Number of io_send_* calls since the last host_io_reset()
+    uint8_t count;
+    uint16_t sw;
+    uint8_t data[HOST_RESPONSE_MAX_LEN];
+    size_t length;
+    // The response did not fit in the APDU buffer
+    bool overflow;
+    // Calls to io_seproxyhal_io_heartbeat() since the last host_io_reset()
+    uint32_t heartbeats;
+} host_response_t;
+
+extern host_response_t hostResponse;
+
+void host_io_reset(void);
+
+/**
+ * Decision applied to the pending review / confirmation once the command handler has returned.
+ */
+typedef enum {
+    HOST_UI_APPROVE,
+    HOST_UI_REJECT,
+} host_ui_policy_e;
+
+void host_ui_set_policy(host_ui_policy_e policy);
+
+/**
+ * Called with each review pair browsed by host_ui_resolve(), as NBGL displays it.
+ */
+typedef void (*host_review_observer_t)(uint8_t index, const char *name, const char *value);
+
+void host_ui_set_review_observer(host_review_observer_t observer);
+
+/**
+ * Runs the approval or rejection callback of the screen displayed by the last command, as a
+ * user would, and formats every field of a transaction review as the device does.
+ * Returns false when no confirmation was pending.
+ */
+bool host_ui_resolve(void);
+
+#endif  // LEDGER_APP_NEM_HOST_H
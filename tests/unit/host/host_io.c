@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <string.h>
+#include "host.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+host_response_t hostResponse;
+
+void host_io_reset(void) {
+    memset(&hostResponse, 0, sizeof(hostResponse));
+}
+
+void io_seproxyhal_io_heartbeat(void) {
+    hostResponse.heartbeats++;
+}
+
+int io_send_response_buffers(const buffer_t *rdatalist, size_t count, uint16_t sw) {
+    hostResponse.count++;
+    hostResponse.sw = sw;
+    hostResponse.length = 0;
+    hostResponse.overflow = false;
+    for (size_t i = 0; i < count; i++) {
+        const buffer_t *rdata = &rdatalist[i];
+        size_t length = rdata->size - rdata->offset;
+        if (hostResponse.length + length > HOST_RESPONSE_MAX_LEN) {
+            hostResponse.overflow = true;
+            return -1;
+        }
+        memmove(hostResponse.data + hostResponse.length, rdata->ptr + rdata->offset, length);
+        hostResponse.length += length;
+    }
+    return 0;
+}
+
+bool apdu_parser(command_t *cmd, uint8_t *buf, size_t buf_len) {
+    // CLA INS P1 P2, optionally followed by Lc and exactly Lc bytes of data
+    if (buf_len < 4) {
+        return false;
+    }
+    cmd->cla = buf[0];
+    cmd->ins = buf[1];
+    cmd->p1 = buf[2];
+    cmd->p2 = buf[3];
+    cmd->lc = buf_len > 4 ? buf[4] : 0;
+    cmd->data = buf_len > 5 ? buf + 5 : NULL;
+    return buf_len == 4 || buf_len == (size_t) 5 + cmd->lc;
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <stdio.h>
+#include "host.h"
+#include "address_ui.h"
+#include "idle_menu.h"
+#include "remote_ui.h"
+#include "review_menu.h"
+#include "review_arena.h"
+
+/*
+ * Auto-answering replacement of src/ui: the screens record the callbacks the user would trigger,
+ * and host_ui_resolve() runs one of them once the command handler has returned, as it happens
+ * on the device.
+ */
+
+typedef enum {
+    PENDING_NONE,
+    PENDING_ACTION,
+    PENDING_REVIEW_MENU,
+} pending_e;
+
+// Shared with transaction.c, as in address_ui.c
+action_t approval_action;
+action_t rejection_action;
+
+static host_ui_policy_e uiPolicy = HOST_UI_APPROVE;
+static pending_e pending = PENDING_NONE;
+static result_t *reviewedTransaction;
+static result_action_t reviewCallback;
+static host_review_observer_t reviewObserver;
+
+void host_ui_set_policy(host_ui_policy_e policy) {
+    uiPolicy = policy;
+}
+
+void host_ui_set_review_observer(host_review_observer_t observer) {
+    reviewObserver = observer;
+}
+
+void display_idle_menu() {
+    pending = PENDING_NONE;
+}
+
+void display_address_confirmation_ui(char *address, action_t onApprove, action_t onReject) {
+    (void) address;
+    approval_action = onApprove;
+    rejection_action = onReject;
+    pending = PENDING_ACTION;
+}
+
+void display_address_confirmation_done(bool validated) {
+    (void) validated;
+    display_idle_menu();
+}
+
+void display_remote_account_confirmation_ui(action_t onApprove, action_t onReject) {
+    approval_action = onApprove;
+    rejection_action = onReject;
+    pending = PENDING_ACTION;
+}
+
+void display_remote_accounts_confirmation_ui(const account_path_t *accounts,
+                                             uint8_t count,
+                                             action_t onApprove,
+                                             action_t onReject) {
+    (void) accounts;
+    (void) count;
+    approval_action = onApprove;
+    rejection_action = onReject;
+    pending = PENDING_ACTION;
+}
+
+void display_remote_account_done(bool validated) {
+    (void) validated;
+    display_idle_menu();
+}
+
+void display_review_menu(result_t *transactionParam, result_action_t callback) {
+    reviewedTransaction = transactionParam;
+    reviewCallback = callback;
+    pending = PENDING_REVIEW_MENU;
+}
+
+void display_review_done(bool validated) {
+    (void) validated;
+    display_idle_menu();
+}
+
+// Browses the review pairs as NBGL requests them, from the review arena
+static void review_all_pairs(void) {
+    uint8_t count = review_arena_init(reviewedTransaction);
+
+    for (uint8_t i = 0; i < count; i++) {
+        const char *name;
+        bool pageStart;
+        const char *value = review_arena_get_value(i, &name, &pageStart);
+        PRINTF("Pair %d - Title: %s - Value: %s\n", i, name, value);
+        if (reviewObserver != NULL) {
+            reviewObserver(i, name, value);
+        }
+    }
+}
+
+bool host_ui_resolve(void) {
+    pending_e current = pending;
+    pending = PENDING_NONE;
+
+    switch (current) {
+        case PENDING_ACTION:
+            if (uiPolicy == HOST_UI_APPROVE) {
+                approval_action();
+            } else {
+                rejection_action();
+            }
+            return true;
+        case PENDING_REVIEW_MENU:
+            review_all_pairs();
+            reviewCallback(uiPolicy == HOST_UI_APPROVE ? OPTION_SIGN : OPTION_REJECT);
+            return true;
+        default:
+            return false;
+    }
+}
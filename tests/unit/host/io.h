@@ -0,0 +1,52 @@
+/*******************************************************************************
+ *   NEM Wallet
+ *   (c) 2020 FDS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#ifndef LEDGER_APP_NEM_HOST_IO_H
+#define LEDGER_APP_NEM_HOST_IO_H
+
+/*
+ * Host replacement of the lib_standard_app I/O layer: responses are recorded instead of being
+ * sent, see host.h.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "os.h"
+#include "os_utils.h"
+#include "os_print.h"
+#include "buffer.h"
+#include "parser.h"
+
+#define IO_APDU_BUFFER_SIZE 260
+
+extern uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+int io_send_response_buffers(const buffer_t *rdatalist, size_t count, uint16_t sw);
+
+static inline int io_send_response_buffer(const buffer_t *rdata, uint16_t sw) {
+    return io_send_response_buffers(rdata, 1, sw);
+}
+
+static inline int io_send_response_pointer(const uint8_t *ptr, size_t size, uint16_t sw) {
+    const buffer_t buffer = {ptr, size, 0};
+    return io_send_response_buffers(&buffer, 1, sw);
+}
+
+static inline int io_send_sw(uint16_t sw) {
+    return io_send_response_buffers(NULL, 0, sw);
+}
+
+#endif  // LEDGER_APP_NEM_HOST_IO_H
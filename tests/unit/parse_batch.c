@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nemparse.h"
+#include "fields.h"
+
+// Parses one hex encoded transaction per line of the standard input and prints one line per
+// transaction: the parser status, the field count, then id:dataType:data of each field.
+//
+// The data of the root namespace and unknown mosaic fields points to a local variable of the
+// parser, it is not printed.
+
+#define MAX_LINE_LENGTH (2 * 65536 + 2)
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static long decode_hex(const char *hex, size_t hexLen, uint8_t *out) {
+    if (hexLen % 2 != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        int high = hex_value(hex[2 * i]);
+        int low = hex_value(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return -1;
+        }
+        out[i] = (uint8_t) (high << 4 | low);
+    }
+    return (long) (hexLen / 2);
+}
+
+static void print_result(const nemparse_ctx_t *context, int res) {
+    size_t count = nemparse_field_count(context);
+    printf("%d %zu", res, count);
+    for (size_t i = 0; i < count; i++) {
+        nemparse_field_t field;
+        nemparse_get_field(context, i, &field);
+        printf(" %u:%u:", field.id, field.dataType);
+        if (field.id == NEM_STR_ROOT_NAMESPACE || field.id == NEM_MOSAIC_UNKNOWN_TYPE) {
+            continue;
+        }
+        for (size_t j = 0; j < field.length; j++) {
+            printf("%02x", field.data[j]);
+        }
+    }
+    printf("\n");
+}
+
+int main(void) {
+    char *line = malloc(MAX_LINE_LENGTH);
+    uint8_t *data = malloc(MAX_LINE_LENGTH / 2);
+    nemparse_ctx_t *context = nemparse_new();
+    if (line == NULL || data == NULL || context == NULL) {
+        fprintf(stderr, "Allocation failed\n");
+        return 1;
+    }
+
+    while (fgets(line, MAX_LINE_LENGTH, stdin) != NULL) {
+        size_t lineLen = strcspn(line, "\r\n");
+        long length = decode_hex(line, lineLen, data);
+        if (length < 0) {
+            fprintf(stderr, "Invalid hex line\n");
+            return 1;
+        }
+        print_result(context, nemparse_parse(context, data, (size_t) length));
+    }
+
+    nemparse_free(context);
+    free(data);
+    free(line);
+    return 0;
+}
@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cx.h"
+#include "nemparse.h"
+
+// Times the review work of one hex encoded transaction per line of the standard input: parsing,
+// then the name and value of every field, with the addresses of the public keys derived as the
+// application does. Prints one line per transaction: the parser status, the field count and the
+// fastest of the timed iterations in nanoseconds.
+//
+// Usage: parse_timing [iterations]
+
+#define MAX_LINE_LENGTH     (2 * 65536 + 2)
+#define DEFAULT_ITERATIONS  20
+#define NANOSECONDS_PER_SEC 1000000000LL
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static long decode_hex(const char *hex, size_t hexLen, uint8_t *out) {
+    if (hexLen % 2 != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        int high = hex_value(hex[2 * i]);
+        int low = hex_value(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return -1;
+        }
+        out[i] = (uint8_t) (high << 4 | low);
+    }
+    return (long) (hexLen / 2);
+}
+
+static int sha3_hash(cx_md_t algo, const uint8_t *in, size_t inLen, uint8_t *out) {
+    cx_sha3_t hash;
+    if (algo == CX_KECCAK) {
+        cx_keccak_init_no_throw(&hash, 256);
+    } else {
+        cx_sha3_init_no_throw(&hash, 256);
+    }
+    return cx_hash_no_throw(&hash.header, CX_LAST, in, inLen, out, 32);
+}
+
+static int keccak256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    (void) user;
+    return sha3_hash(CX_KECCAK, in, inLen, out);
+}
+
+static int sha3_256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    (void) user;
+    return sha3_hash(CX_SHA3, in, inLen, out);
+}
+
+static int ripemd160(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    cx_ripemd160_t hash;
+    (void) user;
+    cx_ripemd160_init(&hash);
+    return cx_hash_no_throw(&hash.header, CX_LAST, in, inLen, out, 20);
+}
+
+// Parsing and formatting of all the fields, the status of the parser
+static int review(nemparse_ctx_t *context, const uint8_t *data, size_t length) {
+    char name[NEMPARSE_FIELDNAME_LEN];
+    char value[NEMPARSE_FIELD_LEN];
+
+    int res = nemparse_parse(context, data, length);
+    if (res != NEMPARSE_OK) {
+        return res;
+    }
+    for (size_t i = 0; i < nemparse_field_count(context); i++) {
+        nemparse_field_name(context, i, name, sizeof(name));
+        nemparse_format_field(context, i, value, sizeof(value));
+    }
+    return res;
+}
+
+static long long elapsed_ns(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * NANOSECONDS_PER_SEC + (end->tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    char *line = malloc(MAX_LINE_LENGTH);
+    uint8_t *data = malloc(MAX_LINE_LENGTH / 2);
+    nemparse_ctx_t *context = nemparse_new();
+    if (iterations <= 0 || line == NULL || data == NULL || context == NULL) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    const nemparse_hash_backend_t backend = {keccak256, sha3_256, ripemd160, NULL};
+    nemparse_set_hash_backend(context, &backend);
+
+    while (fgets(line, MAX_LINE_LENGTH, stdin) != NULL) {
+        size_t lineLen = strcspn(line, "\r\n");
+        long length = decode_hex(line, lineLen, data);
+        if (length < 0) {
+            fprintf(stderr, "Invalid hex line\n");
+            return 1;
+        }
+
+        long long fastest = -1;
+        int res = 0;
+        for (int i = 0; i < iterations; i++) {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            res = review(context, data, (size_t) length);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            long long duration = elapsed_ns(&start, &end);
+            if (fastest < 0 || duration < fastest) {
+                fastest = duration;
+            }
+        }
+        printf("%d %zu %lld\n", res, nemparse_field_count(context), fastest);
+    }
+
+    nemparse_free(context);
+    free(data);
+    free(line);
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cx.h"
+#include "aes.h"
+
+// AES-128 CBC of src/aes.c, byte oriented or with AES_TTABLE: known answers of FIPS-197 and
+// SP 800-38A, and random buffers checked against the host cx_aes implementation.
+
+#define RANDOM_ROUNDS 200
+#define MAX_BLOCKS    16
+
+static int failures = 0;
+
+static void hex_decode(const char *hex, uint8_t *out, size_t outLen) {
+    for (size_t i = 0; i < outLen; i++) {
+        unsigned int byte;
+        if (sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            fprintf(stderr, "Invalid hex string %s\n", hex);
+            exit(1);
+        }
+        out[i] = (uint8_t) byte;
+    }
+}
+
+static int check_bytes(const char *name,
+                       const uint8_t *value,
+                       const uint8_t *expected,
+                       size_t length) {
+    if (memcmp(value, expected, length) != 0) {
+        printf("[  ERROR   ] Mismatch in %s: <", name);
+        for (size_t i = 0; i < length; i++) {
+            printf("%02x", value[i]);
+        }
+        printf(">\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Encrypts and decrypts the plain text, the buffer being chained over two calls
+static int check_cbc(const char *key, const char *iv, const char *plain, const char *cipher) {
+    uint8_t rawKey[AES_KEYLEN], rawIv[AES_BLOCKLEN];
+    uint8_t expected[MAX_BLOCKS * AES_BLOCKLEN], buf[MAX_BLOCKS * AES_BLOCKLEN];
+    size_t length = strlen(plain) / 2;
+    size_t split = (length / AES_BLOCKLEN / 2) * AES_BLOCKLEN;
+    struct AES_ctx ctx;
+    int res = 0;
+
+    hex_decode(key, rawKey, sizeof(rawKey));
+    hex_decode(iv, rawIv, sizeof(rawIv));
+    hex_decode(plain, buf, length);
+    hex_decode(cipher, expected, length);
+
+    AES_init_ctx_iv(&ctx, rawKey, rawIv);
+    AES_CBC_encrypt_buffer(&ctx, buf, split);
+    AES_CBC_encrypt_buffer(&ctx, buf + split, length - split);
+    res |= check_bytes("encryption", buf, expected, length);
+
+    hex_decode(plain, expected, length);
+    AES_init_ctx_iv(&ctx, rawKey, rawIv);
+    AES_CBC_decrypt_buffer(&ctx, buf, split);
+    AES_CBC_decrypt_buffer(&ctx, buf + split, length - split);
+    res |= check_bytes("decryption", buf, expected, length);
+    return res;
+}
+
+static int test_fips197(void) {
+    // FIPS-197 Appendix C.1: a single block with a null IV is the block cipher
+    return check_cbc("000102030405060708090a0b0c0d0e0f",
+                     "00000000000000000000000000000000",
+                     "00112233445566778899aabbccddeeff",
+                     "69c4e0d86a7b0430d8cdb78070b4c55a");
+}
+
+static int test_sp800_38a(void) {
+    // NIST SP 800-38A F.2.1 and F.2.2, CBC-AES128
+    return check_cbc("2b7e151628aed2a6abf7158809cf4f3c",
+                     "000102030405060708090a0b0c0d0e0f",
+                     "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+                     "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+                     "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+                     "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7");
+}
+
+static int test_random_buffers(void) {
+    uint8_t key[AES_KEYLEN], iv[AES_BLOCKLEN];
+    uint8_t plain[MAX_BLOCKS * AES_BLOCKLEN], buf[MAX_BLOCKS * AES_BLOCKLEN];
+    uint8_t expected[MAX_BLOCKS * AES_BLOCKLEN];
+    struct AES_ctx ctx;
+    cx_aes_key_t cxKey;
+    int res = 0;
+
+    srand(0);
+    for (int round = 0; round < RANDOM_ROUNDS && res == 0; round++) {
+        size_t length = (1 + rand() % MAX_BLOCKS) * AES_BLOCKLEN;
+        size_t expectedLength = sizeof(expected);
+        for (size_t i = 0; i < sizeof(key); i++) {
+            key[i] = (uint8_t) rand();
+        }
+        for (size_t i = 0; i < sizeof(iv); i++) {
+            iv[i] = (uint8_t) rand();
+        }
+        for (size_t i = 0; i < length; i++) {
+            plain[i] = (uint8_t) rand();
+        }
+
+        res |= cx_aes_init_key_no_throw(key, sizeof(key), &cxKey) != CX_OK;
+        res |= cx_aes_iv_no_throw(&cxKey,
+                                  CX_LAST | CX_ENCRYPT | CX_CHAIN_CBC | CX_PAD_NONE,
+                                  iv,
+                                  sizeof(iv),
+                                  plain,
+                                  length,
+                                  expected,
+                                  &expectedLength) != CX_OK;
+
+        memcpy(buf, plain, length);
+        AES_init_ctx_iv(&ctx, key, iv);
+        AES_CBC_encrypt_buffer(&ctx, buf, length);
+        res |= check_bytes("random encryption", buf, expected, length);
+        AES_ctx_set_iv(&ctx, iv);
+        AES_CBC_decrypt_buffer(&ctx, buf, length);
+        res |= check_bytes("random decryption", buf, plain, length);
+    }
+    return res;
+}
+
+static void run(const char *name, int (*test)(void)) {
+    printf("[ RUN      ]  %s\n", name);
+    if (test() != 0) {
+        printf("[  FAILED  ]  %s\n", name);
+        failures++;
+    } else {
+        printf("[       OK ]  %s\n", name);
+    }
+}
+
+int main(void) {
+    run("fips197", test_fips197);
+    run("sp800_38a", test_sp800_38a);
+    run("random_buffers", test_random_buffers);
+    return failures != 0;
+}
@@ -0,0 +1,466 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cx.h"
+#include "cxhost.h"
+#include "nem_helpers.h"
+
+// Values returned by the application running on Speculos with the default seed
+#define SPECULOS_PUBLIC_KEY "8e494cb179a5acef773c1bbf83ad2cd797673149e3ccdb7df739a1f5deb2fad0"
+#define SPECULOS_MAINNET_ADDRESS "NBA3Q76J33VWORAQNRMXMLLWKJL2MYO25AYKOGJ2"
+#define SPECULOS_TESTNET_ADDRESS "TBA3Q76J33VWORAQNRMXMLLWKJL2MYO25AMLN7SF"
+#if defined(IOCUSTOMCRYPT)
+#define SPECULOS_HARVESTING_KEY "328a20f8900fd5e2fc0f9f02d949feb66a8a448f8822c914b22aba9bcddaa46f"
+#else
+// cx_aes path: AES-256 with the full HMAC key, not the default build of the application
+#define SPECULOS_HARVESTING_KEY "36f1718c38504861d6078b22da3741e7afb5413d81bb00612d79cd1b3eadbd57"
+#endif
+
+static const uint32_t NEM_PATH[] = {0x8000002C, 0x8000002B, 0x80000000, 0x80000000, 0x80000000};
+static const char SIGNED_MESSAGE[] = "NEM Ledger application";
+
+static int failures = 0;
+
+static void hex_decode(const char *hex, uint8_t *out, size_t outLen) {
+    for (size_t i = 0; i < outLen; i++) {
+        unsigned int byte;
+        if (sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            fprintf(stderr, "Invalid hex string %s\n", hex);
+            exit(1);
+        }
+        out[i] = (uint8_t) byte;
+    }
+}
+
+static int check_bytes(const char *name, const uint8_t *value, size_t length, const char *hex) {
+    uint8_t expected[128];
+    if (strlen(hex) != 2 * length || length > sizeof(expected)) {
+        fprintf(stderr, "Invalid expected value for %s\n", name);
+        exit(1);
+    }
+    hex_decode(hex, expected, length);
+    if (memcmp(value, expected, length) != 0) {
+        printf("[  ERROR   ] Mismatch in %s: <", name);
+        for (size_t i = 0; i < length; i++) {
+            printf("%02x", value[i]);
+        }
+        printf("> vs <%s>\n", hex);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_string(const char *name, const char *value, const char *expected) {
+    if (strcmp(value, expected) != 0) {
+        printf("[  ERROR   ] Mismatch in %s: <%s> vs <%s>\n", name, value, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static void run(const char *name, int (*test)(void)) {
+    printf("[ RUN      ]  %s\n", name);
+    if (test() != 0) {
+        printf("[  FAILED  ]  %s\n", name);
+        failures++;
+    } else {
+        printf("[       OK ]  %s\n", name);
+    }
+}
+
+static int hash_message(cx_md_t algo, size_t bits, const char *message, uint8_t *out) {
+    union {
+        cx_hash_t header;
+        cx_sha3_t sha3;
+        cx_sha512_t sha512;
+        cx_ripemd160_t ripemd160;
+    } ctx;
+    switch (algo) {
+        case CX_KECCAK:
+            cx_keccak_init_no_throw(&ctx.sha3, bits);
+            break;
+        case CX_SHA3:
+            cx_sha3_init_no_throw(&ctx.sha3, bits);
+            break;
+        case CX_SHA512:
+            cx_sha512_init_no_throw(&ctx.sha512);
+            break;
+        default:
+            cx_ripemd160_init(&ctx.ripemd160);
+            break;
+    }
+    return cx_hash_no_throw(&ctx.header,
+                            CX_LAST,
+                            (const uint8_t *) message,
+                            strlen(message),
+                            out,
+                            bits / 8);
+}
+
+static int test_hashes(void) {
+    uint8_t digest[64];
+    // 200 bytes spans two Keccak-256 blocks and two SHA-512 blocks
+    char longMessage[201];
+    memset(longMessage, 'a', 200);
+    longMessage[200] = '\0';
+    int error = 0;
+
+    error |= hash_message(CX_KECCAK, 256, "", digest);
+    error |= check_bytes("keccak256",
+                         digest,
+                         32,
+                         "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    error |= hash_message(CX_KECCAK, 512, "", digest);
+    error |= check_bytes("keccak512",
+                         digest,
+                         64,
+                         "0eab42de4c3ceb9235fc91acffe746b29c29a8c366b7c60e4e67c466f36a4304"
+                         "c00fa9caf9d87976ba469bcbe06713b435f091ef2769fb160cdab33d3670680e");
+    error |= hash_message(CX_SHA3, 256, "abc", digest);
+    error |= check_bytes("sha3_256",
+                         digest,
+                         32,
+                         "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+    error |= hash_message(CX_SHA3, 256, longMessage, digest);
+    error |= check_bytes("sha3_256 multi-block",
+                         digest,
+                         32,
+                         "cce34485baf2bf2aca99b94833892a4f52896d3d153f7b840cc4f9fe695f1387");
+    error |= hash_message(CX_SHA512, 512, "abc", digest);
+    error |= check_bytes("sha512",
+                         digest,
+                         64,
+                         "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                         "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    error |= hash_message(CX_SHA512, 512, longMessage, digest);
+    error |= check_bytes("sha512 multi-block",
+                         digest,
+                         64,
+                         "4b11459c33f52a22ee8236782714c150a3b2c60994e9acee17fe68947a3e6789"
+                         "f31e7668394592da7bef827cddca88c4e6f86e4df7ed1ae6cba71f3e98faee9f");
+    error |= hash_message(CX_RIPEMD160, 160, "abc", digest);
+    error |= check_bytes("ripemd160", digest, 20, "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+    return error;
+}
+
+static int test_hmac_sha512(void) {
+    // RFC 4231 test case 2, computed in place as nem_get_remote_private_key() does
+    uint8_t data[64] = "what do ya want for nothing?";
+    const uint8_t *key = (const uint8_t *) "Jefe";
+    size_t length = cx_hmac_sha512(key, 4, data, strlen((char *) data), data, sizeof(data));
+    if (length != 64) {
+        return 1;
+    }
+    return check_bytes("hmac_sha512",
+                       data,
+                       64,
+                       "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+                       "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+}
+
+static int test_aes_cbc(void) {
+    // NIST SP 800-38A F.2.5 and F.2.6, first two blocks
+    uint8_t raw[32], iv[16], plain[32], cipher[32], out[32];
+    size_t outLen = sizeof(out);
+    cx_aes_key_t key;
+    int error = 0;
+
+    hex_decode("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4", raw, 32);
+    hex_decode("000102030405060708090a0b0c0d0e0f", iv, 16);
+    hex_decode("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51", plain, 32);
+    hex_decode("f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d", cipher, 32);
+
+    error |= cx_aes_init_key_no_throw(raw, sizeof(raw), &key);
+    error |= cx_aes_iv_no_throw(&key,
+                                CX_LAST | CX_ENCRYPT | CX_CHAIN_CBC | CX_PAD_NONE,
+                                iv,
+                                sizeof(iv),
+                                plain,
+                                sizeof(plain),
+                                out,
+                                &outLen);
+    error |= outLen != sizeof(out);
+    error |= memcmp(out, cipher, sizeof(cipher)) != 0;
+    error |= cx_aes_iv_no_throw(&key,
+                                CX_LAST | CX_DECRYPT | CX_CHAIN_CBC | CX_PAD_NONE,
+                                iv,
+                                sizeof(iv),
+                                cipher,
+                                sizeof(cipher),
+                                out,
+                                &outLen);
+    error |= memcmp(out, plain, sizeof(plain)) != 0;
+    return error;
+}
+
+static int derive_private_key(cx_ecfp_private_key_t *privateKey) {
+    uint8_t privateKeyData[NEM_RAW_PRIVATE_KEY_LENGTH];
+    int error = os_derive_bip32_with_seed_no_throw(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   NEM_PATH,
+                                                   5,
+                                                   privateKeyData,
+                                                   NULL,
+                                                   (unsigned char *) "ed25519-keccak seed",
+                                                   19);
+    error |= cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519,
+                                               privateKeyData,
+                                               NEM_PRIVATE_KEY_LENGTH,
+                                               privateKey);
+    return error;
+}
+
+static int test_public_key_and_address(void) {
+    cx_ecfp_private_key_t privateKey;
+    cx_ecfp_public_key_t publicKey;
+    uint8_t nemPublicKey[NEM_PUBLIC_KEY_LENGTH];
+    char address[NEM_ADDRESS_LENGTH + 1];
+    int error = 0;
+
+    error |= derive_private_key(&privateKey);
+    error |= cx_ecfp_generate_pair2_no_throw(CX_CURVE_Ed25519,
+                                             &publicKey,
+                                             &privateKey,
+                                             1,
+                                             get_algo(MAINNET));
+    if (error != 0) {
+        return error;
+    }
+    if (nem_public_key_and_address(&publicKey,
+                                   MAINNET,
+                                   get_algo(MAINNET),
+                                   nemPublicKey,
+                                   address,
+                                   sizeof(address)) != SWO_SUCCESS) {
+        return 1;
+    }
+    error |= check_bytes("public key", nemPublicKey, sizeof(nemPublicKey), SPECULOS_PUBLIC_KEY);
+    error |= check_string("mainnet address", address, SPECULOS_MAINNET_ADDRESS);
+
+    if (nem_public_key_to_address(nemPublicKey,
+                                  TESTNET,
+                                  get_algo(TESTNET),
+                                  address,
+                                  sizeof(address)) != SWO_SUCCESS) {
+        return 1;
+    }
+    error |= check_string("testnet address", address, SPECULOS_TESTNET_ADDRESS);
+    return error;
+}
+
+static int test_cosignatory_address(void) {
+    // Cosignatory of multisig_aggregate_modification_tx.json
+    uint8_t publicKey[NEM_PUBLIC_KEY_LENGTH];
+    char address[NEM_ADDRESS_LENGTH + 1];
+
+    hex_decode("a581459b8f16974e59b110fca581ee1ffd140a8c42b9ecdffc316d722f0cda35",
+               publicKey,
+               sizeof(publicKey));
+    if (nem_public_key_to_address(publicKey,
+                                  TESTNET,
+                                  get_algo(TESTNET),
+                                  address,
+                                  sizeof(address)) != SWO_SUCCESS) {
+        return 1;
+    }
+    return check_string("cosignatory address", address, "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O");
+}
+
+static int test_addresses_batch(void) {
+    // Speculos account and cosignatory of multisig_aggregate_modification_tx.json, in one call
+    uint8_t publicKeys[2 * NEM_PUBLIC_KEY_LENGTH];
+    char addresses[2][NEM_ADDRESS_LENGTH + 1];
+    int error = 0;
+
+    hex_decode(SPECULOS_PUBLIC_KEY, publicKeys, NEM_PUBLIC_KEY_LENGTH);
+    hex_decode("a581459b8f16974e59b110fca581ee1ffd140a8c42b9ecdffc316d722f0cda35",
+               publicKeys + NEM_PUBLIC_KEY_LENGTH,
+               NEM_PUBLIC_KEY_LENGTH);
+    if (nem_public_keys_to_addresses(publicKeys,
+                                     2,
+                                     TESTNET,
+                                     get_algo(TESTNET),
+                                     addresses[0],
+                                     sizeof(addresses[0])) != SWO_SUCCESS) {
+        return 1;
+    }
+    error |= check_string("first address", addresses[0], SPECULOS_TESTNET_ADDRESS);
+    error |= check_string("second address",
+                          addresses[1],
+                          "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O");
+    return error;
+}
+
+// Hash functions of the shared address derivation, failing from the call failAt on
+typedef struct {
+    unsigned int calls;
+    unsigned int failAt;
+} hasher_calls_t;
+
+static int hasher_digest(cx_md_t algo, const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    hasher_calls_t *calls = user;
+    union {
+        cx_hash_t header;
+        cx_sha3_t sha3;
+        cx_ripemd160_t ripemd160;
+    } ctx;
+    if (++calls->calls >= calls->failAt) {
+        return -1;
+    }
+    if (algo == CX_KECCAK) {
+        cx_keccak_init_no_throw(&ctx.sha3, 256);
+    } else {
+        cx_ripemd160_init(&ctx.ripemd160);
+    }
+    return cx_hash_no_throw(&ctx.header,
+                            CX_LAST,
+                            in,
+                            inLen,
+                            out,
+                            algo == CX_KECCAK ? NEM_ADDRESS_HASH_LENGTH
+                                              : NEM_ADDRESS_RIPEMD160_LENGTH);
+}
+
+static int hasher_keccak256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    return hasher_digest(CX_KECCAK, in, inLen, out, user);
+}
+
+static int hasher_ripemd160(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    return hasher_digest(CX_RIPEMD160, in, inLen, out, user);
+}
+
+static int test_hash_addresses_batch(void) {
+    // Same keys as addresses_batch, through the derivation shared with libnemparse
+    uint8_t publicKeys[3 * NEM_PUBLIC_KEY_LENGTH];
+    char addresses[3][NEM_ADDRESS_LENGTH + 1];
+    hasher_calls_t calls = {0, UINT32_MAX};
+    const nem_address_hasher_t hasher = {hasher_keccak256, hasher_ripemd160, &calls};
+    int error = 0;
+
+    hex_decode(SPECULOS_PUBLIC_KEY, publicKeys, NEM_PUBLIC_KEY_LENGTH);
+    hex_decode("a581459b8f16974e59b110fca581ee1ffd140a8c42b9ecdffc316d722f0cda35",
+               publicKeys + NEM_PUBLIC_KEY_LENGTH,
+               NEM_PUBLIC_KEY_LENGTH);
+    memcpy(publicKeys + 2 * NEM_PUBLIC_KEY_LENGTH, publicKeys, NEM_PUBLIC_KEY_LENGTH);
+    error |= nem_hash_public_keys_to_addresses(&hasher,
+                                               publicKeys,
+                                               3,
+                                               TESTNET,
+                                               addresses[0],
+                                               sizeof(addresses[0])) != NEM_ADDRESS_OK;
+    error |= calls.calls != 3 * 3;
+    error |= check_string("first address", addresses[0], SPECULOS_TESTNET_ADDRESS);
+    error |= check_string("second address",
+                          addresses[1],
+                          "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O");
+    error |= check_string("third address", addresses[2], SPECULOS_TESTNET_ADDRESS);
+
+    // A failing hash stops the derivation at the second key
+    calls = (hasher_calls_t){0, 5};
+    error |= nem_hash_public_keys_to_addresses(&hasher,
+                                               publicKeys,
+                                               3,
+                                               TESTNET,
+                                               addresses[0],
+                                               sizeof(addresses[0])) != NEM_ADDRESS_HASH_FAILURE;
+    error |= calls.calls != 5;
+    // An address longer than outLen is not encoded
+    calls = (hasher_calls_t){0, UINT32_MAX};
+    error |= nem_hash_public_keys_to_addresses(&hasher,
+                                               publicKeys,
+                                               2,
+                                               TESTNET,
+                                               addresses[0],
+                                               NEM_ADDRESS_LENGTH) != NEM_ADDRESS_ENCODING_FAILURE;
+    return error;
+}
+
+static int test_network_type(void) {
+    uint32_t path[5];
+    uint8_t networkType = 0;
+    int error = 0;
+
+    memcpy(path, NEM_PATH, sizeof(path));
+    error |= get_network_type(path, &networkType) != SWO_SUCCESS || networkType != MAINNET;
+    path[1] = 0x80000001;
+    error |= get_network_type(path, &networkType) != SWO_SUCCESS || networkType != TESTNET;
+    path[1] = 0x80000002;
+    error |= get_network_type(path, &networkType) != SWO_INCORRECT_DATA;
+    return error;
+}
+
+static int test_remote_private_key(void) {
+    cx_ecfp_private_key_t privateKey;
+    uint8_t remoteKey[NEM_PRIVATE_KEY_LENGTH * 2];
+#if defined(IOCUSTOMCRYPT)
+    size_t remoteKeyLength = NEM_PRIVATE_KEY_LENGTH;
+#else
+    size_t remoteKeyLength = sizeof(remoteKey);
+#endif
+
+    // Same parameters as GET_REMOTE_ACCOUNT
+    if (derive_private_key(&privateKey) != 0 ||
+        nem_get_remote_private_key(privateKey.d,
+                                   sizeof(privateKey.d),
+                                   (const uint8_t *) ACC_KEY,
+                                   32,
+                                   (const uint8_t *) ACC_VALUE,
+                                   64,
+                                   1,
+                                   0,
+                                   0,
+                                   remoteKey,
+                                   remoteKeyLength) != SWO_SUCCESS) {
+        return 1;
+    }
+    return check_bytes("harvesting key",
+                       remoteKey,
+                       NEM_PRIVATE_KEY_LENGTH,
+                       SPECULOS_HARVESTING_KEY);
+}
+
+static int test_eddsa_sign(void) {
+    cx_ecfp_private_key_t privateKey;
+    uint8_t signature[64];
+    int error = derive_private_key(&privateKey);
+
+    error |= cx_eddsa_sign_no_throw(&privateKey,
+                                    CX_KECCAK,
+                                    (const uint8_t *) SIGNED_MESSAGE,
+                                    strlen(SIGNED_MESSAGE),
+                                    signature,
+                                    sizeof(signature));
+    error |= check_bytes("keccak signature",
+                         signature,
+                         sizeof(signature),
+                         "e38e3043cebddf62aa74f9efed0a968f1791ba02e53f7edae1495da1f5684d77"
+                         "c066e19c5fcb302c15fb10866dc052235cee42f1bc5f50312e5f15b34841990a");
+    error |= cx_eddsa_sign_no_throw(&privateKey,
+                                    CX_SHA3,
+                                    (const uint8_t *) SIGNED_MESSAGE,
+                                    strlen(SIGNED_MESSAGE),
+                                    signature,
+                                    sizeof(signature));
+    error |= check_bytes("sha3 signature",
+                         signature,
+                         sizeof(signature),
+                         "f29ec718583e56ac831b9edc7a3479e51f24c9bdc576d92ca8e2d5cc121c1aed"
+                         "2c148d2e685f7d6c71f890b6f55e4e2d0a42eb03e3d45410d807e5e8be75e702");
+    return error;
+}
+
+int main(void) {
+    run("hashes", test_hashes);
+    run("hmac_sha512", test_hmac_sha512);
+    run("aes_cbc", test_aes_cbc);
+    run("network_type", test_network_type);
+    run("public_key_and_address", test_public_key_and_address);
+    run("cosignatory_address", test_cosignatory_address);
+    run("addresses_batch", test_addresses_batch);
+    run("hash_addresses_batch", test_hash_addresses_batch);
+    run("remote_private_key", test_remote_private_key);
+    run("eddsa_sign", test_eddsa_sign);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_format.h"
+#include "global.h"
+#include "heartbeat.h"
+#include "host.h"
+#include "nem_parse.h"
+
+// Counts the heartbeats of the worst-case transactions of the timing harness: while they are
+// parsed, then while their fields are formatted for the PARSE_TRANSACTION dry-run, with the costs
+// the dry-run counts. The multisig transactions, with the most cosignatories, must yield several
+// times while parsed, and the dry-run must yield once per address derived.
+//
+// Usage: test_heartbeat worst_cases.json
+
+#define MAX_TRANSACTION_LENGTH 65536
+// Heartbeats of the multisig worst cases while they are parsed
+#define MIN_MULTISIG_PARSE_HEARTBEATS 3
+
+// Used by the address formatter
+transaction_context_t transactionContext;
+
+static parse_context_t context;
+static uint8_t data[MAX_TRANSACTION_LENGTH];
+static int failures = 0;
+
+static size_t decode_hex(const char *hex, size_t hexLen) {
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        unsigned int byte;
+        if (i >= sizeof(data) || sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            fprintf(stderr, "Invalid hex string\n");
+            exit(1);
+        }
+        data[i] = (uint8_t) byte;
+    }
+    return hexLen / 2;
+}
+
+static char *load_file(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "File opening failed %s\n", filename);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    size_t filesize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *content = calloc(filesize + 1, 1);
+    if (content == NULL || fread(content, 1, filesize, f) != filesize) {
+        fprintf(stderr, "File read failed %s\n", filename);
+        exit(1);
+    }
+    fclose(f);
+    return content;
+}
+
+static int check_transaction(const char *name, size_t length) {
+    memset(&context, 0, sizeof(context));
+    context.data = data;
+    context.length = length;
+    host_io_reset();
+    if (parse_txn_context(&context) != 0) {
+        printf("[  ERROR   ] %s not parsed\n", name);
+        return 1;
+    }
+    uint32_t parseHeartbeats = hostResponse.heartbeats;
+
+    // Work of the dry-run records, the formatting itself does not count
+    host_io_reset();
+    uint32_t addresses = 0;
+    for (uint8_t i = 0; i < context.result.numFields; i++) {
+        uint32_t cost = get_field_cost(&context.result.fields[i]);
+        addresses += cost == HEARTBEAT_COST_ADDRESS;
+        heartbeat_consume(cost);
+    }
+    uint32_t dryRunHeartbeats = hostResponse.heartbeats;
+
+    printf("  %-34s %3d fields, %2u heartbeats parsing, %2u for %2u addresses in the dry-run\n",
+           name,
+           context.result.numFields,
+           parseHeartbeats,
+           dryRunHeartbeats,
+           addresses);
+    int res = 0;
+    if (strncmp(name, "multisig", strlen("multisig")) == 0 &&
+        parseHeartbeats < MIN_MULTISIG_PARSE_HEARTBEATS) {
+        printf("[  ERROR   ] Not enough heartbeats while parsing\n");
+        res = 1;
+    }
+    if (dryRunHeartbeats < addresses) {
+        printf("[  ERROR   ] Addresses derived without heartbeat in the dry-run\n");
+        res = 1;
+    }
+    return res;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s worst_cases.json\n", argv[0]);
+        return 1;
+    }
+    char *cases = load_file(argv[1]);
+    int count = 0;
+    char name[64] = "";
+    // Entries of the fixtures: "name" then "hex"
+    for (char *cursor = cases; (cursor = strchr(cursor, '"')) != NULL; cursor++) {
+        if (strncmp(cursor, "\"name\": \"", 9) == 0) {
+            sscanf(cursor + 9, "%63[^\"]", name);
+        } else if (strncmp(cursor, "\"hex\": \"", 8) == 0) {
+            cursor += 8;
+            size_t hexLen = strcspn(cursor, "\"");
+            printf("[ RUN      ]  %s\n", name);
+            if (check_transaction(name, decode_hex(cursor, hexLen)) != 0) {
+                printf("[  FAILED  ]  %s\n", name);
+                failures++;
+            } else {
+                printf("[       OK ]  %s\n", name);
+            }
+            cursor += hexLen;
+            count++;
+        }
+    }
+    free(cases);
+
+    if (count == 0) {
+        fprintf(stderr, "No transaction in %s\n", argv[1]);
+        return 1;
+    }
+    return failures != 0;
+}
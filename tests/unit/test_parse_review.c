@@ -0,0 +1,282 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_format.h"
+#include "constants.h"
+#include "entry.h"
+#include "global.h"
+#include "host.h"
+
+// Sends the worst-case transactions of the timing harness to PARSE_TRANSACTION, then to SIGN,
+// and checks that the field list of the dry-run holds the pairs browsed on the review screens:
+// same count, same order, same names and values, the summary pairs and the parts of the long
+// messages included.
+//
+// Usage: test_parse_review worst_cases.json
+
+#define MAX_TRANSACTION_LENGTH 65536
+#define MAX_STREAM_LENGTH      65536
+#define APDU_HEADER_LEN        5
+#define PATH_LEN               5
+
+#define TAG_FIELD_ID    0x01
+#define TAG_FIELD_TYPE  0x02
+#define TAG_FIELD_NAME  0x03
+#define TAG_FIELD_VALUE 0x04
+
+typedef struct {
+    uint8_t id;
+    uint8_t dataType;
+    char name[REVIEW_PAIR_NAME_LEN];
+    char value[MAX_FIELD_LEN];
+} record_t;
+
+// 44'/43'/0'/0'/0'
+static const uint32_t PATH[PATH_LEN] = {0x8000002C, 0x8000002B, 0x80000000, 0x80000000, 0x80000000};
+
+static uint8_t data[MAX_TRANSACTION_LENGTH];
+static uint8_t stream[MAX_STREAM_LENGTH];
+static size_t streamLength;
+static record_t records[REVIEW_MAX_PAIRS];
+static uint8_t recordCount;
+// Review pairs browsed, and the ones not matching the dry-run
+static unsigned int browsed;
+static unsigned int mismatches;
+static int failures = 0;
+
+static size_t decode_hex(const char *hex, size_t hexLen) {
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        unsigned int byte;
+        if (i >= sizeof(data) || sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            fprintf(stderr, "Invalid hex string\n");
+            exit(1);
+        }
+        data[i] = (uint8_t) byte;
+    }
+    return hexLen / 2;
+}
+
+static char *load_file(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "File opening failed %s\n", filename);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    size_t filesize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *content = calloc(filesize + 1, 1);
+    if (content == NULL || fread(content, 1, filesize, f) != filesize) {
+        fprintf(stderr, "File read failed %s\n", filename);
+        exit(1);
+    }
+    fclose(f);
+    return content;
+}
+
+// Same steps as app_main() for one command, the answer is left to the caller
+static uint16_t send_command(uint8_t ins, uint8_t p1, const uint8_t *payload, uint8_t length) {
+    command_t cmd;
+
+    host_io_reset();
+    G_io_apdu_buffer[0] = CLA;
+    G_io_apdu_buffer[1] = ins;
+    G_io_apdu_buffer[2] = p1;
+    G_io_apdu_buffer[3] = 0x00;
+    G_io_apdu_buffer[4] = length;
+    if (length > 0) {
+        memcpy(G_io_apdu_buffer + APDU_HEADER_LEN, payload, length);
+    }
+    if (!apdu_parser(&cmd, G_io_apdu_buffer, APDU_HEADER_LEN + length)) {
+        return SWO_WRONG_DATA_LENGTH;
+    }
+    handle_apdu(&cmd);
+    return hostResponse.sw;
+}
+
+// Sends the transaction with the chunking of the client, returns the status of the last chunk
+static uint16_t send_transaction(uint8_t ins, size_t length) {
+    uint8_t payload[MAX_APDU_CHUNK_SIZE];
+    size_t offset = 0;
+    bool first = true;
+
+    while (true) {
+        uint8_t payloadLen = 0;
+        if (first) {
+            payload[payloadLen++] = PATH_LEN;
+            for (int i = 0; i < PATH_LEN; i++) {
+                payload[payloadLen++] = (uint8_t) (PATH[i] >> 24);
+                payload[payloadLen++] = (uint8_t) (PATH[i] >> 16);
+                payload[payloadLen++] = (uint8_t) (PATH[i] >> 8);
+                payload[payloadLen++] = (uint8_t) PATH[i];
+            }
+        }
+        size_t part = length - offset;
+        if (part > (size_t) (MAX_APDU_CHUNK_SIZE - payloadLen)) {
+            part = MAX_APDU_CHUNK_SIZE - payloadLen;
+        }
+        memcpy(payload + payloadLen, data + offset, part);
+        payloadLen += part;
+        offset += part;
+
+        uint8_t p1 = (first ? 0x00 : P1_MASK_ORDER) | (offset < length ? P1_MASK_MORE : 0x00);
+        uint16_t sw = send_command(ins, p1, payload, payloadLen);
+        if (offset == length || sw != SWO_SUCCESS) {
+            return sw;
+        }
+        first = false;
+    }
+}
+
+static bool append_response(void) {
+    if (hostResponse.sw != SWO_SUCCESS || hostResponse.length < 1 ||
+        streamLength + hostResponse.length - 1 > sizeof(stream)) {
+        return false;
+    }
+    memcpy(stream + streamLength, hostResponse.data + 1, hostResponse.length - 1);
+    streamLength += hostResponse.length - 1;
+    return true;
+}
+
+// Reads the TLV of the given tag at *offset into dst, of dstLen bytes
+static bool read_tlv(size_t *offset, uint8_t tag, uint8_t *dst, size_t dstLen) {
+    if (*offset + 3 > streamLength || stream[*offset] != tag) {
+        return false;
+    }
+    size_t length = stream[*offset + 1] << 8 | stream[*offset + 2];
+    *offset += 3;
+    if (*offset + length > streamLength || length > dstLen) {
+        return false;
+    }
+    memcpy(dst, stream + *offset, length);
+    *offset += length;
+    return true;
+}
+
+static bool read_records(void) {
+    if (streamLength < 1) {
+        return false;
+    }
+    recordCount = stream[0];
+    size_t offset = 1;
+    for (uint8_t i = 0; i < recordCount; i++) {
+        record_t *record = &records[i];
+        memset(record, 0, sizeof(*record));
+        if (!read_tlv(&offset, TAG_FIELD_ID, &record->id, 1) ||
+            !read_tlv(&offset, TAG_FIELD_TYPE, &record->dataType, 1) ||
+            !read_tlv(&offset,
+                      TAG_FIELD_NAME,
+                      (uint8_t *) record->name,
+                      sizeof(record->name) - 1) ||
+            !read_tlv(&offset,
+                      TAG_FIELD_VALUE,
+                      (uint8_t *) record->value,
+                      sizeof(record->value) - 1)) {
+            return false;
+        }
+    }
+    return offset == streamLength;
+}
+
+static void compare_pair(uint8_t index, const char *name, const char *value) {
+    browsed++;
+    if (index >= recordCount) {
+        printf("[  ERROR   ] Pair %d not in the dry-run\n", index);
+        mismatches++;
+    } else if (strcmp(records[index].name, name) != 0 || strcmp(records[index].value, value) != 0) {
+        printf("[  ERROR   ] Pair %d: \"%s\" = \"%s\" reviewed, \"%s\" = \"%s\" in the dry-run\n",
+               index,
+               name,
+               value,
+               records[index].name,
+               records[index].value);
+        mismatches++;
+    }
+}
+
+static int check_transaction(size_t length, bool *hasSummary, bool *hasParts) {
+    // Dry-run, the field list being read until its end
+    streamLength = 0;
+    if (send_transaction(INS_PARSE_TRANSACTION, length) != SWO_SUCCESS || !append_response()) {
+        printf("[  ERROR   ] PARSE_TRANSACTION failed\n");
+        return 1;
+    }
+    while (hostResponse.data[0] == 0x01) {
+        if (send_command(INS_PARSE_TRANSACTION, P1_MORE_FIELDS, NULL, 0) != SWO_SUCCESS ||
+            !append_response()) {
+            printf("[  ERROR   ] Reading the field list failed\n");
+            return 1;
+        }
+    }
+    if (!read_records()) {
+        printf("[  ERROR   ] Malformed field list\n");
+        return 1;
+    }
+
+    // Review of the same transaction, rejected once browsed
+    browsed = 0;
+    mismatches = 0;
+    if (send_transaction(INS_SIGN, length) != 0 || hostResponse.count != 0) {
+        printf("[  ERROR   ] SIGN failed\n");
+        return 1;
+    }
+    host_ui_resolve();
+    if (browsed != recordCount) {
+        printf("[  ERROR   ] %u pairs reviewed, %d in the dry-run\n", browsed, recordCount);
+        return 1;
+    }
+
+    for (uint8_t i = 0; i < recordCount; i++) {
+        *hasSummary |= records[i].id == 0x00;
+        *hasParts |= strchr(records[i].name, '/') != NULL;
+    }
+    printf("  %u review pairs\n", browsed);
+    return mismatches != 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s worst_cases.json\n", argv[0]);
+        return 1;
+    }
+    char *cases = load_file(argv[1]);
+    int count = 0;
+    bool hasSummary = false;
+    bool hasParts = false;
+    char name[64] = "";
+
+    host_ui_set_policy(HOST_UI_REJECT);
+    host_ui_set_review_observer(compare_pair);
+    // Entries of the fixtures: "name" then "hex"
+    for (char *cursor = cases; (cursor = strchr(cursor, '"')) != NULL; cursor++) {
+        if (strncmp(cursor, "\"name\": \"", 9) == 0) {
+            sscanf(cursor + 9, "%63[^\"]", name);
+        } else if (strncmp(cursor, "\"hex\": \"", 8) == 0) {
+            cursor += 8;
+            size_t hexLen = strcspn(cursor, "\"");
+            printf("[ RUN      ]  %s\n", name);
+            if (check_transaction(decode_hex(cursor, hexLen), &hasSummary, &hasParts) != 0) {
+                printf("[  FAILED  ]  %s\n", name);
+                failures++;
+            } else {
+                printf("[       OK ]  %s\n", name);
+            }
+            cursor += hexLen;
+            count++;
+        }
+    }
+    free(cases);
+
+    if (count == 0) {
+        fprintf(stderr, "No transaction in %s\n", argv[1]);
+        return 1;
+    }
+    if (!hasSummary || !hasParts) {
+        fprintf(stderr, "The transactions must have summary pairs and split messages\n");
+        return 1;
+    }
+    return failures != 0;
+}
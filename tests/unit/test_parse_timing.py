@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Worst-case review time of transactions: parsing, then naming and formatting every field.
+
+build/parse_timing times the review work of the application parser and formatters on the host.
+Times are compared as ratios to the review time of the whole corpus measured in the same run, so
+that the budgets hold on machines of different speed.
+
+Without argument, the worst cases of timing/worst_cases.json are timed and each one must stay
+within its budget. With --search, generated transactions close to the limits and mutations of the
+slowest ones are timed, and the slowest valid transaction of each type is printed, or saved as the
+new worst cases with --write.
+"""
+
+import argparse
+import json
+import struct
+import sys
+from pathlib import Path
+from subprocess import run
+
+NEM_LIB_DIRECTORY = (Path(__file__).parent / "../functional/apps").resolve().as_posix()
+sys.path.append(NEM_LIB_DIRECTORY)
+from nem_transaction_builder import TRANSACTION_TYPES, encode_txn_context  # noqa: E402
+from nem_transaction_generator import TransactionGenerator  # noqa: E402
+
+TIMING_BINARY = (Path(__file__).parent / "build/parse_timing").resolve().as_posix()
+CORPUS_DIR = Path(__file__).resolve().parent.parent / "corpus"
+WORST_CASES = Path(__file__).resolve().parent / "timing" / "worst_cases.json"
+# Budget of a saved worst case, relative to its ratio when found: absorbs the noise of shared
+# runners and coverage builds, not a change of complexity
+BUDGET_MARGIN = 2.0
+# Smallest budget, for the transactions reviewed in about a microsecond
+MIN_BUDGET = 0.05
+
+
+def time_reviews(transactions, iterations):
+    """(status, field count, nanoseconds) of each transaction."""
+    stdin = "".join(data.hex() + "\n" for data in transactions)
+    res = run([TIMING_BINARY, str(iterations)], input=stdin.encode(), capture_output=True, check=False)
+    lines = res.stdout.decode().splitlines()
+    if res.returncode != 0 or len(lines) != len(transactions):
+        print("[  ERROR   ] ", TIMING_BINARY, "exited with", res.returncode, res.stderr.decode().strip())
+        sys.exit(1)
+    return [tuple(int(value) for value in line.split()) for line in lines]
+
+
+def reference_time(iterations):
+    """Review time of the whole corpus, the unit of the ratios."""
+    corpus = []
+    for path in sorted(CORPUS_DIR.glob("*.json")):
+        with open(path, encoding="utf-8") as f:
+            corpus.append(encode_txn_context(json.load(f)))
+    return sum(ns for _, _, ns in time_reviews(corpus, iterations))
+
+
+def check(iterations):
+    with open(WORST_CASES, encoding="utf-8") as f:
+        cases = json.load(f)
+    reference = reference_time(iterations)
+    transactions = [bytes.fromhex(case["hex"]) for case in cases]
+    status = 0
+    print("[ RUN      ] ", "worst-case review time")
+    print(f"  corpus: {reference / 1000:.1f} us")
+    for case, data, (res, count, ns) in zip(cases, transactions, time_reviews(transactions, iterations), strict=True):
+        ratio = ns / reference
+        failed = res != 0 or count != case["fields"] or ratio > case["budget"]
+        status |= failed
+        print(
+            f"  {case['name']:<34} {len(data):>6} B {count:>3} fields "
+            f"{ns / 1000:>9.1f} us {ratio:>6.2f}x / {case['budget']:.2f}x {'FAILED' if failed else 'ok'}"
+        )
+    print("[  FAILED  ] " if status else "[       OK ] ", "worst-case review time")
+    return status
+
+
+def search(args):
+    """Slowest valid transaction of each type, with its ratio."""
+    reference = reference_time(args.iterations)
+    worst = {}
+    for name, code in TRANSACTION_TYPES.items():
+        generator = TransactionGenerator(args.seed, scale=1.0)
+        candidates = [encode_txn_context(generator.generate(name)) for _ in range(args.count)]
+        elites = []
+        for _ in range(args.rounds + 1):
+            timed = [
+                (ns, data)
+                for data, (res, _, ns) in zip(candidates, time_reviews(candidates, args.iterations), strict=True)
+                # Mutations changing the transaction type belong to the search of the other type
+                if res == 0 and struct.unpack_from("<I", data)[0] == code
+            ]
+            elites = sorted(elites + timed, key=lambda item: -item[0])[: args.elites]
+            # Mutations of the slowest: most are rejected, some lengthen what the formatters print
+            candidates = [generator.mutate(data) for _, data in elites for _ in range(args.count // len(elites))]
+        ns, data = elites[0]
+        worst[name] = (ns / reference, data)
+        print(f"{name:<34} {len(data):>6} B {ns / reference:>6.2f}x")
+    return worst
+
+
+def write(worst, iterations):
+    # Timed again with the reference, as the check does
+    reference = reference_time(iterations)
+    transactions = [data for _, data in worst.values()]
+    results = time_reviews(transactions, iterations)
+    cases = []
+    for name, data, (_, count, ns) in zip(worst, transactions, results, strict=True):
+        budget = max(MIN_BUDGET, round(ns / reference * BUDGET_MARGIN, 2))
+        cases.append({"name": name.lower(), "fields": count, "budget": budget, "hex": data.hex()})
+    with open(WORST_CASES, "w", encoding="utf-8") as f:
+        json.dump(cases, f, indent=2)
+        f.write("\n")
+    print(f"{len(cases)} worst cases written to {WORST_CASES}")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--iterations", type=int, default=20, help="Timed reviews of each transaction, the fastest is kept")
+    parser.add_argument("--search", action="store_true", help="Search for the slowest transactions")
+    parser.add_argument("--write", action="store_true", help="Save the search results as the worst cases")
+    parser.add_argument("--seed", type=int, default=0, help="Seed of the generator")
+    parser.add_argument("--count", type=int, default=200, help="Transactions timed per type and round")
+    parser.add_argument("--rounds", type=int, default=5, help="Mutation rounds of the slowest transactions")
+    parser.add_argument("--elites", type=int, default=10, help="Slowest transactions kept between rounds")
+    args = parser.parse_args()
+
+    if args.search:
+        worst = search(args)
+        if args.write:
+            write(worst, args.iterations)
+        sys.exit(0)
+    sys.exit(check(args.iterations))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""Differential test between the application parser and the Python transaction parser.
+
+Generated transactions and mutations of them are parsed by both build/parse_batch (the
+application parser, through libnemparse) and decode_txn_context. The accept/reject decisions are
+compared, then, when both accept, the transaction types, addresses, public keys, amounts, counts
+and number of fields.
+
+Generated transactions must be accepted by both parsers with the same content. Mutations must
+get the same decision and content, except for the divergences of ALLOWED_DIVERGENCES.
+"""
+
+import argparse
+import re
+import struct
+import sys
+from collections import Counter
+from pathlib import Path
+from subprocess import run
+
+NEM_LIB_DIRECTORY = (Path(__file__).parent / "../functional/apps").resolve().as_posix()
+sys.path.append(NEM_LIB_DIRECTORY)
+from nem_transaction_builder import TRANSACTION_TYPES, encode_txn_context  # noqa: E402
+from nem_transaction_generator import MULTIPLIER_UNIT, TransactionGenerator, count_fields  # noqa: E402
+from nem_transaction_parser import decode_txn_context  # noqa: E402
+
+PARSER_BINARY = (Path(__file__).parent / "build/parse_batch").resolve().as_posix()
+FIELDS_H = Path(__file__).resolve().parent.parent.parent / "src" / "nem" / "format" / "fields.h"
+
+# Known differences between the parsers, with the reason they are accepted
+ALLOWED_DIVERGENCES = {
+    # decode_txn_context decodes the names as UTF-8, the application shows the bytes outside
+    # printable ASCII as '?'
+    "invalid UTF-8 string accepted by the application",
+}
+
+
+def read_field_ids(path=FIELDS_H):
+    with open(path, encoding="utf-8") as f:
+        return {name: int(value, 16) for name, value in re.findall(r"#define\s+(NEM_\w+)\s+(0x[0-9A-Fa-f]+)", f.read())}
+
+
+FIELD_IDS = read_field_ids()
+TYPE_IDS = {
+    FIELD_IDS[name]
+    for name in ("NEM_UINT32_TRANSACTION_TYPE", "NEM_UINT32_INNER_TRANSACTION_TYPE", "NEM_UINT32_DETAIL_TRANSACTION_TYPE")
+}
+ADDRESS_IDS = {
+    FIELD_IDS[name]
+    for name in ("NEM_STR_RECIPIENT_ADDRESS", "NEM_STR_MULTISIG_ADDRESS", "NEM_STR_SINK_ADDRESS", "NEM_STR_LEVY_ADDRESS")
+}
+PUBLIC_KEY_IDS = {FIELD_IDS[name] for name in ("NEM_PUBLICKEY_IT_REMOTE", "NEM_PUBLICKEY_AM_COSIGNATORY")}
+AMOUNT_IDS = {
+    FIELD_IDS[name]
+    for name in (
+        "NEM_UINT64_TXN_FEE",
+        "NEM_UINT64_MULTISIG_FEE",
+        "NEM_UINT64_RENTAL_FEE",
+        "NEM_UINT64_LEVY_FEE",
+        "NEM_UINT64_MULTIPLIER",
+        "NEM_MOSAIC_AMOUNT",
+        "NEM_MOSAIC_XEM_QUANTITY",
+        "NEM_MOSAIC_UNITS",
+        "NEM_MOSAIC_CREATE_SUPPLY_DELTA",
+        "NEM_MOSAIC_DELETE_SUPPLY_DELTA",
+    )
+}
+COUNT_IDS = {
+    FIELD_IDS[name] for name in ("NEM_UINT32_AM_COSIGNATORY_NUM", "NEM_UINT32_AM_RELATIVE_CHANGE", "NEM_UINT32_MOSAIC_COUNT")
+}
+
+
+def empty_values():
+    return {"types": [], "addresses": [], "public_keys": [], "amounts": [], "counts": []}
+
+
+def c_values(fields):
+    """Compared values of the fields printed by parse_batch."""
+    values = empty_values()
+    for field_id, data in fields:
+        if field_id in TYPE_IDS:
+            values["types"].append(struct.unpack("<I", data)[0])
+        elif field_id in ADDRESS_IDS:
+            values["addresses"].append(data.decode("ascii", errors="replace"))
+        elif field_id in PUBLIC_KEY_IDS:
+            values["public_keys"].append(data.hex())
+        elif field_id in AMOUNT_IDS:
+            values["amounts"].append(struct.unpack("<Q", data)[0])
+        elif field_id in COUNT_IDS:
+            values["counts"].append(struct.unpack("<I", data)[0])
+    return values
+
+
+def python_values(transaction, values=None):
+    """Same values, from a decoded transaction, in the order the application parser adds them."""
+    values = values if values is not None else empty_values()
+    header = transaction["common_txn_header"]
+    fields = transaction["fields"]
+    transaction_type = header["transactionType"]
+    values["types"].append(TRANSACTION_TYPES[transaction_type])
+    if transaction_type == "TRANSFER":
+        values["addresses"].append(fields["recipient"])
+        if header["version"] == 1:
+            values["amounts"].append(fields["amount"])
+        values["amounts"].append(header["fee"])
+        if header["version"] == 2:
+            mosaics = fields["mosaicList"]
+            if not mosaics or fields["amount"] != MULTIPLIER_UNIT:
+                values["amounts"].append(fields["amount"])
+            if len(mosaics) > 1:
+                values["counts"].append(len(mosaics))
+            for mosaic in mosaics:
+                if len(mosaics) == 1 and (mosaic["namespace"], mosaic["mosaicName"]) != ("nem", "xem"):
+                    values["counts"].append(1)
+                values["amounts"].append(mosaic["quantity"])
+    elif transaction_type == "IMPORTANCE_TRANSFER":
+        values["public_keys"].append(fields["iPublicKey"])
+        values["amounts"].append(header["fee"])
+    elif transaction_type == "MULTISIG_AGGREGATE_MODIFICATION":
+        values["counts"].append(len(fields["cmList"]))
+        values["public_keys"].extend(cm["amPublicKey"] for cm in fields["cmList"])
+        if header["version"] == 2:
+            values["counts"].append(fields["minCm"] if fields["cmLen"] else 0)
+        values["amounts"].append(header["fee"])
+    elif transaction_type in ("MULTISIG", "MULTISIG_SIGNATURE"):
+        if transaction_type == "MULTISIG_SIGNATURE":
+            values["addresses"].append(fields["msAddress"])
+        values["amounts"].append(header["fee"])
+        for inner in fields["transactions"]:
+            python_values(inner, values)
+    elif transaction_type == "PROVISION_NAMESPACE":
+        values["addresses"].append(fields["rAddress"])
+        values["amounts"].extend([fields["rentalFee"], header["fee"]])
+    elif transaction_type == "MOSAIC_DEFINITION":
+        if "levy" in fields:
+            values["addresses"].append(fields["levy"]["lsAddress"])
+            values["amounts"].append(fields["levy"]["fee"])
+        values["addresses"].append(fields["mdAddress"])
+        values["amounts"].extend([fields["mdfee"], header["fee"]])
+    elif transaction_type == "MOSAIC_SUPPLY_CHANGE":
+        values["amounts"].extend([fields["supplyDelta"], header["fee"]])
+    return values
+
+
+def parse_c(transactions):
+    """Status and (id, data) fields of each transaction, from the application parser."""
+    stdin = "".join(data.hex() + "\n" for data in transactions)
+    res = run([PARSER_BINARY], input=stdin.encode(), capture_output=True, check=False)
+    lines = res.stdout.decode().splitlines()
+    if res.returncode != 0 or len(lines) != len(transactions):
+        print("[  ERROR   ] ", PARSER_BINARY, "exited with", res.returncode, res.stderr.decode().strip())
+        sys.exit(1)
+    results = []
+    for line in lines:
+        status, _, *fields = line.split(" ")
+        results.append((int(status), [(int(f.split(":")[0]), bytes.fromhex(f.split(":")[2])) for f in fields]))
+    return results
+
+
+def parse_python(data):
+    """Decoded transaction, or the reason it is rejected."""
+    try:
+        return decode_txn_context(data), None
+    except UnicodeDecodeError:
+        return None, "invalid UTF-8 string"
+    except (AssertionError, KeyError, IndexError, ValueError, struct.error):
+        return None, "invalid transaction"
+
+
+def compare(data, c_result):
+    """Divergence between the two parsers, None if they agree."""
+    status, fields = c_result
+    transaction, error = parse_python(data)
+    if transaction is None:
+        if status != 0:
+            return None
+        if error == "invalid UTF-8 string":
+            return "invalid UTF-8 string accepted by the application"
+        return "accepted by the application only"
+    if status != 0:
+        return "accepted by decode_txn_context only"
+    if len(fields) != count_fields(transaction):
+        return "number of fields"
+    expected = python_values(transaction)
+    for key, value in c_values(fields).items():
+        if value != expected[key]:
+            return key
+    return None
+
+
+def run_suite(name, transactions, allowed, verbose):
+    print("[ RUN      ] ", name)
+    divergences = Counter()
+    for data, c_result in zip(transactions, parse_c(transactions), strict=True):
+        divergence = compare(data, c_result)
+        if divergence is not None:
+            divergences[divergence] += 1
+            if verbose and divergences[divergence] == 1:
+                print(f"  first '{divergence}': {data.hex()}")
+    accepted = len(transactions) - sum(divergences.values())
+    print(f"  {len(transactions)} transactions, {accepted} identical decisions and contents")
+    for divergence, count in divergences.most_common():
+        print(f"  {count:6} {divergence}{' (allowed)' if divergence in allowed else ''}")
+    if set(divergences) - allowed:
+        print("[  FAILED  ] ", name)
+        return 1
+    print("[       OK ] ", name)
+    return 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--seed", type=int, default=0, help="Seed of the generator")
+    parser.add_argument("--count", type=int, default=300, help="Generated transactions per size profile")
+    parser.add_argument("--mutations", type=int, default=4, help="Mutations of each generated transaction")
+    parser.add_argument("--verbose", action="store_true", help="Print the first transaction of each divergence")
+    args = parser.parse_args()
+
+    valid, mutated = [], []
+    for i, scale in enumerate([0.1, 0.5, 1.0]):
+        generator = TransactionGenerator(args.seed + i, scale)
+        for _ in range(args.count):
+            data = encode_txn_context(generator.generate())
+            valid.append(data)
+            mutated.extend(generator.mutate(data) for _ in range(args.mutations))
+
+    status = run_suite("generated transactions", valid, set(), args.verbose)
+    status |= run_suite("mutated transactions", mutated, ALLOWED_DIVERGENCES, args.verbose)
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
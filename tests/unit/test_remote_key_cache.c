@@ -0,0 +1,199 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "constants.h"
+#include "entry.h"
+#include "io.h"
+#include "remote_key_cache.h"
+
+// Session cache of the delegated harvesting keys: lookups by path, replacement of the oldest key,
+// and wipe, also by handle_apdu when the instruction changes.
+
+#define HARDENED 0x80000000u
+
+static int failures = 0;
+
+static void make_key(uint8_t seed, uint8_t *key) {
+    for (int i = 0; i < NEM_PRIVATE_KEY_LENGTH; i++) {
+        key[i] = (uint8_t) (seed + i);
+    }
+}
+
+static void make_path(uint32_t account, uint32_t *path) {
+    path[0] = 44 | HARDENED;
+    path[1] = 43 | HARDENED;
+    path[2] = account | HARDENED;
+    path[3] = 0 | HARDENED;
+    path[4] = 0 | HARDENED;
+}
+
+static int expect(const char *name, bool value, bool expected) {
+    if (value != expected) {
+        printf("[  ERROR   ] %s: %s instead of %s\n",
+               name,
+               value ? "true" : "false",
+               expected ? "true" : "false");
+        return 1;
+    }
+    return 0;
+}
+
+// Whether the key of the path is cached with the key of the seed
+static bool has_key(const uint32_t *path, uint8_t length, uint8_t seed) {
+    uint8_t expected[NEM_PRIVATE_KEY_LENGTH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH] = {0};
+    make_key(seed, expected);
+    return remote_key_cache_get(path, length, key) &&
+           memcmp(key, expected, sizeof(key)) == 0;
+}
+
+static int test_lookups(void) {
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH];
+    int res = 0;
+
+    remote_key_cache_wipe();
+    make_path(0, path);
+    res |= expect("empty cache", has_key(path, MAX_BIP32_PATH, 1), false);
+    make_key(1, key);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    res |= expect("same path", has_key(path, MAX_BIP32_PATH, 1), true);
+    res |= expect("shorter path", has_key(path, MAX_BIP32_PATH - 1, 1), false);
+    make_path(1, path);
+    res |= expect("other account", has_key(path, MAX_BIP32_PATH, 1), false);
+
+    // Storing the key of a cached path replaces it
+    make_path(0, path);
+    make_key(2, key);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    res |= expect("replaced key", has_key(path, MAX_BIP32_PATH, 2), true);
+    return res;
+}
+
+static int test_replacement(void) {
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH];
+    int res = 0;
+
+    remote_key_cache_wipe();
+    for (uint32_t account = 0; account < REMOTE_KEY_CACHE_SIZE; account++) {
+        make_path(account, path);
+        make_key(account, key);
+        remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    }
+    // Storing a cached key again does not take an entry
+    make_path(0, path);
+    make_key(0, key);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    make_path(REMOTE_KEY_CACHE_SIZE - 1, path);
+    res |= expect("full cache", has_key(path, MAX_BIP32_PATH, REMOTE_KEY_CACHE_SIZE - 1), true);
+
+    make_path(REMOTE_KEY_CACHE_SIZE, path);
+    make_key(REMOTE_KEY_CACHE_SIZE, key);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    res |= expect("new key", has_key(path, MAX_BIP32_PATH, REMOTE_KEY_CACHE_SIZE), true);
+    make_path(0, path);
+    res |= expect("oldest key replaced", has_key(path, MAX_BIP32_PATH, 0), false);
+    make_path(1, path);
+    res |= expect("second key kept", has_key(path, MAX_BIP32_PATH, 1), true);
+    return res;
+}
+
+static int test_wipe(void) {
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH];
+    int res = 0;
+
+    make_path(0, path);
+    make_key(1, key);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    remote_key_cache_wipe();
+    res |= expect("wiped", has_key(path, MAX_BIP32_PATH, 1), false);
+    remote_key_cache_put(path, MAX_BIP32_PATH + 1, key);
+    res |= expect("path too long", has_key(path, MAX_BIP32_PATH + 1, 1), false);
+    return res;
+}
+
+// Handlers of the instructions and I/O of handle_apdu, which is only checked for the wipe
+int handle_public_key(const command_t *cmd) {
+    return cmd->ins;
+}
+
+int handle_sign(const command_t *cmd) {
+    return cmd->ins;
+}
+
+int handle_remote_private_key(const command_t *cmd) {
+    return cmd->ins;
+}
+
+int handle_remote_private_keys(const command_t *cmd) {
+    return cmd->ins;
+}
+
+int handle_app_configuration(const command_t *cmd) {
+    return cmd->ins;
+}
+
+int handle_parse_transaction(const command_t *cmd) {
+    return cmd->ins;
+}
+
+void reset_transaction_context(void) {
+}
+
+int io_send_response_buffers(const buffer_t *rdatalist, size_t count, uint16_t sw) {
+    (void) rdatalist;
+    (void) count;
+    return sw;
+}
+
+static void send_command(uint8_t cla, uint8_t ins) {
+    const command_t cmd = {cla, ins, 0, 0, 0, NULL};
+    handle_apdu(&cmd);
+}
+
+static int test_instruction_change(void) {
+    uint32_t path[MAX_BIP32_PATH];
+    uint8_t key[NEM_PRIVATE_KEY_LENGTH];
+    int res = 0;
+
+    make_path(0, path);
+    make_key(1, key);
+    send_command(CLA, INS_GET_REMOTE_ACCOUNT);
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    send_command(CLA, INS_GET_REMOTE_ACCOUNT);
+    res |= expect("same instruction", has_key(path, MAX_BIP32_PATH, 1), true);
+    // Rejected before the instruction is considered
+    send_command(CLA + 1, INS_GET_PUBLIC_KEY);
+    res |= expect("other class", has_key(path, MAX_BIP32_PATH, 1), true);
+    send_command(CLA, INS_GET_REMOTE_ACCOUNTS);
+    res |= expect("other instruction", has_key(path, MAX_BIP32_PATH, 1), false);
+
+    remote_key_cache_put(path, MAX_BIP32_PATH, key);
+    send_command(CLA, INS_GET_REMOTE_ACCOUNTS);
+    res |= expect("batch instruction", has_key(path, MAX_BIP32_PATH, 1), true);
+    send_command(CLA, INS_GET_REMOTE_ACCOUNT);
+    res |= expect("back to the first instruction", has_key(path, MAX_BIP32_PATH, 1), false);
+    return res;
+}
+
+static void run(const char *name, int (*test)(void)) {
+    printf("[ RUN      ]  %s\n", name);
+    if (test() != 0) {
+        printf("[  FAILED  ]  %s\n", name);
+        failures++;
+    } else {
+        printf("[       OK ]  %s\n", name);
+    }
+}
+
+int main(void) {
+    run("lookups", test_lookups);
+    run("replacement", test_replacement);
+    run("wipe", test_wipe);
+    run("instruction_change", test_instruction_change);
+    return failures != 0;
+}
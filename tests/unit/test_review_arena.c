@@ -0,0 +1,446 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_format.h"
+#include "nem_parse.h"
+#include "nemparse.h"
+#include "printers.h"
+#include "review_arena.h"
+
+// Checks the pairs of the review arena against the formatters, for the worst-case transactions
+// of the timing harness: long messages and many pairs, so that the arena runs out of space. The
+// long plain messages are also reviewed as hex messages. Transfers with a multiplier check the
+// Total XEM of the summary. The host library must list the same pairs.
+//
+// Usage: test_review_arena worst_cases.json
+
+#define MAX_TRANSACTION_LENGTH 65536
+// Largest page of the devices, in pairs
+#define MAX_PAGE_PAIRS 7
+// Characters of a whole message, two per byte for hex messages
+#define MAX_MESSAGE_LEN (2 * MAX_RAW_TX + 1)
+
+static parse_context_t context;
+static uint8_t data[MAX_TRANSACTION_LENGTH];
+static char expected[REVIEW_MAX_PAIRS][MAX_FIELD_LEN];
+static char expectedNames[REVIEW_MAX_PAIRS][MAX_FIELDNAME_LEN];
+static bool pageStarts[REVIEW_MAX_PAIRS];
+static char message[MAX_MESSAGE_LEN];
+static char joined[MAX_MESSAGE_LEN];
+static int failures = 0;
+
+static size_t decode_hex(const char *hex, size_t hexLen) {
+    for (size_t i = 0; i < hexLen / 2; i++) {
+        unsigned int byte;
+        if (i >= sizeof(data) || sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+            fprintf(stderr, "Invalid hex string\n");
+            exit(1);
+        }
+        data[i] = (uint8_t) byte;
+    }
+    return hexLen / 2;
+}
+
+static char *load_file(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "File opening failed %s\n", filename);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    size_t filesize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *content = calloc(filesize + 1, 1);
+    if (content == NULL || fread(content, 1, filesize, f) != filesize) {
+        fprintf(stderr, "File read failed %s\n", filename);
+        exit(1);
+    }
+    fclose(f);
+    return content;
+}
+
+// Requests a pair as NBGL does, and compares its value and page start with the expected ones
+static int check_pair(uint8_t index) {
+    const char *name;
+    bool pageStart;
+    const char *value = review_arena_get_value(index, &name, &pageStart);
+    if (strcmp(value, expected[index]) != 0 || strcmp(name, expectedNames[index]) != 0) {
+        printf("[  ERROR   ] Mismatch in pair %d: <%s: %s> vs <%s: %s>\n",
+               index,
+               name,
+               value,
+               expectedNames[index],
+               expected[index]);
+        return 1;
+    }
+    if (pageStart != pageStarts[index]) {
+        printf("[  ERROR   ] Page start of value %d changed\n", index);
+        return 1;
+    }
+    return 0;
+}
+
+// Values of the displayed page must survive the rendering of the others pairs of the page
+static int check_page(uint8_t first, uint8_t end) {
+    const char *values[MAX_PAGE_PAIRS];
+    const char *names[MAX_PAGE_PAIRS];
+    bool pageStart;
+    int res = 0;
+    for (uint8_t i = first; i < end; i++) {
+        values[i - first] = review_arena_get_value(i, &names[i - first], &pageStart);
+    }
+    for (uint8_t i = first; i < end; i++) {
+        if (strcmp(values[i - first], expected[i]) != 0 ||
+            strcmp(names[i - first], expectedNames[i]) != 0) {
+            printf("[  ERROR   ] Value %d overwritten in page %d-%d\n", i, first, end - 1);
+            res = 1;
+        }
+    }
+    return res;
+}
+
+// Pages of up to MAX_PAGE_PAIRS pairs, starting where the arena requires it
+static uint8_t page_end(uint8_t first, uint8_t count) {
+    uint8_t end = first + 1;
+    while (end < count && end - first < MAX_PAGE_PAIRS && !pageStarts[end]) {
+        end++;
+    }
+    return end;
+}
+
+// Whole message, as the parts of its pairs must show it
+static void format_message(const field_t *field) {
+    memset(message, 0, sizeof(message));
+    if (field->data[0] == 0xFE) {
+        snprintf_hex2ascii(message, sizeof(message), field->data + 1, field->length - 1);
+    } else {
+        snprintf_ascii(message, 0, sizeof(message), field->data, field->length);
+    }
+}
+
+// Expected pairs, returns their count
+static uint8_t expect_pairs(const result_t *result) {
+    uint8_t count = 0;
+    for (; count < get_summary_pair_count(&result->summary); count++) {
+        format_summary_pair(&result->summary, count, expected[count]);
+        snprintf(expectedNames[count], MAX_FIELDNAME_LEN, "%s", get_summary_name(count));
+    }
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        const field_t *field = &result->fields[i];
+        uint8_t chunkCount = get_field_chunk_count(field);
+        for (uint8_t chunk = 0; chunk < chunkCount; chunk++, count++) {
+            format_field_chunk(field, chunk, expected[count]);
+            if (chunkCount > 1) {
+                snprintf(expectedNames[count],
+                         MAX_FIELDNAME_LEN,
+                         "%s %d/%d",
+                         get_fieldname(field),
+                         chunk + 1,
+                         chunkCount);
+            } else {
+                snprintf(expectedNames[count], MAX_FIELDNAME_LEN, "%s", get_fieldname(field));
+            }
+        }
+    }
+    return count;
+}
+
+// The parts of a long message show all of it, each one at most MESSAGE_CHUNK_LEN characters
+static int check_message_parts(const result_t *result) {
+    uint8_t pair = get_summary_pair_count(&result->summary);
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        const field_t *field = &result->fields[i];
+        uint8_t chunkCount = get_field_chunk_count(field);
+        if (chunkCount > 1) {
+            joined[0] = '\0';
+            for (uint8_t chunk = 0; chunk < chunkCount; chunk++) {
+                if (strlen(expected[pair + chunk]) > MESSAGE_CHUNK_LEN) {
+                    printf("[  ERROR   ] Part %d of the message too long\n", chunk + 1);
+                    return 1;
+                }
+                strcat(joined, expected[pair + chunk]);
+            }
+            format_message(field);
+            if (strcmp(joined, message) != 0) {
+                printf("[  ERROR   ] Parts of the message do not show it\n");
+                return 1;
+            }
+        }
+        pair += chunkCount;
+    }
+    return 0;
+}
+
+static uint64_t read_amount(const uint8_t *data) {
+    uint64_t amount;
+    memcpy(&amount, data, sizeof(amount));
+    return amount;
+}
+
+// Exact products and sums of the amounts
+__extension__ typedef unsigned __int128 uint128_t;
+
+static void add_total(uint64_t *total, uint128_t amount) {
+    uint128_t sum = *total + amount;
+    *total = sum > UINT64_MAX ? UINT64_MAX : (uint64_t) sum;
+}
+
+// The totals of the summary are the ones of the fields: the fees and rental fees, the XEM amounts,
+// which include the XEM moved by the transfers of version 2 without mosaic, shown as a fee, and
+// the XEM mosaic quantities multiplied by the amount of their transfer in millionths, the distinct
+// mosaics and the cosignatory modifications
+static int check_summary(const result_t *result) {
+    uint64_t xem = 0;
+    uint64_t fees = 0;
+    uint8_t mosaics = 0;
+    uint8_t cosignatoryChanges = 0;
+    bool wrapper = false;
+    // Amount of the last transfer, which follows its recipient
+    const uint8_t *transferAmount = NULL;
+    for (uint8_t i = 0; i < result->numFields; i++) {
+        const field_t *field = &result->fields[i];
+        switch (field->id) {
+            case NEM_STR_RECIPIENT_ADDRESS:
+                transferAmount = field->data + NEM_ADDRESS_LENGTH;
+                break;
+            case NEM_UINT64_MULTISIG_FEE:
+                wrapper = true;
+                add_total(&fees, read_amount(field->data));
+                break;
+            case NEM_UINT64_TXN_FEE:
+                add_total(field->data == transferAmount ? &xem : &fees, read_amount(field->data));
+                break;
+            case NEM_UINT64_RENTAL_FEE:
+                add_total(&fees, read_amount(field->data));
+                break;
+            case NEM_MOSAIC_AMOUNT:
+            case NEM_MOSAIC_XEM_QUANTITY:
+                if (field->data == transferAmount) {
+                    add_total(&xem, read_amount(field->data));
+                } else {
+                    add_total(&xem,
+                              (uint128_t) read_amount(field->data) *
+                                  read_amount(transferAmount) / 1000000);
+                }
+                break;
+            case NEM_STR_TRANSFER_MOSAIC:
+                mosaics++;
+                for (uint8_t j = 0; j < i; j++) {
+                    const field_t *previous = &result->fields[j];
+                    if (previous->id == NEM_STR_TRANSFER_MOSAIC &&
+                        previous->length == field->length &&
+                        memcmp(previous->data, field->data, field->length) == 0) {
+                        mosaics--;
+                        break;
+                    }
+                }
+                break;
+            case NEM_UINT32_AM_MODICATION_TYPE:
+                cosignatoryChanges++;
+                break;
+            default:
+                break;
+        }
+    }
+    const summary_t *summary = &result->summary;
+    if (summary->xemAmount != xem || summary->fees != fees || summary->mosaicCount != mosaics ||
+        summary->cosignatoryChanges != cosignatoryChanges || summary->wrapper != wrapper) {
+        printf("[  ERROR   ] Summary does not match the fields\n");
+        return 1;
+    }
+    return 0;
+}
+
+// The review pairs of the host library are the expected ones
+static int check_library(const uint8_t *transaction, size_t length, uint8_t count) {
+    char pairName[REVIEW_PAIR_NAME_LEN];
+    char value[MAX_FIELD_LEN];
+    int res = 0;
+
+    nemparse_ctx_t *library = nemparse_new();
+    if (library == NULL || nemparse_parse(library, transaction, length) != NEMPARSE_OK ||
+        nemparse_review_pair_count(library) != count) {
+        printf("[  ERROR   ] Wrong number of pairs in the host library\n");
+        res = 1;
+    }
+    for (uint8_t i = 0; res == 0 && i < count; i++) {
+        nemparse_review_pair_name(library, i, pairName, sizeof(pairName));
+        nemparse_format_review_pair(library, i, value, sizeof(value));
+        if (strcmp(value, expected[i]) != 0 || strcmp(pairName, expectedNames[i]) != 0) {
+            printf("[  ERROR   ] Mismatch in pair %d of the host library: <%s: %s> vs <%s: %s>\n",
+                   i,
+                   pairName,
+                   value,
+                   expectedNames[i],
+                   expected[i]);
+            res = 1;
+        }
+    }
+    nemparse_free(library);
+    return res;
+}
+
+static int check_transaction(const char *name, const uint8_t *transaction, size_t length) {
+    memset(&context, 0, sizeof(context));
+    context.data = (uint8_t *) transaction;
+    context.length = length;
+    if (parse_txn_context(&context) != 0) {
+        printf("[  ERROR   ] %s not parsed\n", name);
+        return 1;
+    }
+    const result_t *result = &context.result;
+    uint8_t count = expect_pairs(result);
+
+    int res = check_message_parts(result) | check_summary(result) |
+              check_library(transaction, length, count);
+    uint8_t summaryPairs = get_summary_pair_count(&result->summary);
+    uint8_t segments = 1;
+    // First pass in order, as NBGL counts the pages
+    if (review_arena_init(result) != count) {
+        printf("[  ERROR   ] Wrong number of pairs\n");
+        return 1;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        const char *pairName;
+        const char *value = review_arena_get_value(i, &pairName, &pageStarts[i]);
+        segments += pageStarts[i];
+        if (strcmp(value, expected[i]) != 0 || strcmp(pairName, expectedNames[i]) != 0) {
+            printf("[  ERROR   ] Mismatch in pair %d: <%s: %s> vs <%s: %s>\n",
+                   i,
+                   pairName,
+                   value,
+                   expectedNames[i],
+                   expected[i]);
+            res = 1;
+        }
+    }
+    if (summaryPairs > 0 && !pageStarts[summaryPairs]) {
+        printf("[  ERROR   ] Summary not on its own page\n");
+        res = 1;
+    }
+    // Pages browsed forward, backward, then a jump to the last page and back to the first
+    for (uint8_t first = 0; first < count; first = page_end(first, count)) {
+        res |= check_page(first, page_end(first, count));
+    }
+    for (int i = count - 1; i >= 0; i--) {
+        res |= check_pair((uint8_t) i);
+    }
+    uint8_t last = 0;
+    for (uint8_t first = 0; first < count; first = page_end(first, count)) {
+        last = first;
+    }
+    res |= check_page(last, count);
+    res |= check_page(0, page_end(0, count));
+
+    // A new review starts from an empty layout
+    review_arena_init(result);
+    res |= check_pair(count - 1);
+    res |= check_page(0, page_end(0, count));
+
+    printf("  %-34s %3d pairs, %d segments%s\n",
+           name,
+           count,
+           segments,
+           summaryPairs > 0 ? ", summary" : "");
+    return res;
+}
+
+// Turns the long plain message of the last reviewed transaction into a hex message
+static bool to_hex_message(void) {
+    for (uint8_t i = 0; i < context.result.numFields; i++) {
+        const field_t *field = &context.result.fields[i];
+        if (field->dataType == STI_MESSAGE && get_field_chunk_count(field) > 1 &&
+            field->data[0] != 0xFE) {
+            data[field->data - data] = 0xFE;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run(const char *name, const uint8_t *transaction, size_t length) {
+    printf("[ RUN      ]  %s\n", name);
+    if (check_transaction(name, transaction, length) != 0) {
+        printf("[  FAILED  ]  %s\n", name);
+        failures++;
+    } else {
+        printf("[       OK ]  %s\n", name);
+    }
+}
+
+// multiple_mosaic_tx.json with other amounts: the XEM mosaic quantities are multiplied by the
+// amount of the transfer in millionths
+static const struct {
+    const char *name;
+    const char *hex;
+    const char *totalXem;
+} MULTIPLIER_CASES[] = {
+    {"3 XEM mosaic units, amount 2.5",
+         "010100000200009888af640a200000009f96df7e7a639b4034b8bee5b88ab1d640db66eb5a47afe018e320cb"
+         "130c183df04902000000000098bd640a2800000054423749423644534a4b57425651454b3750443754574f36"
+         "36454357354c59365349534d32434a4aa02526000000000014000000010000000c00000054657374206d6573"
+         "73616765020000001a0000000e000000030000006e656d0300000078656dc0c62d0000000000200000001400"
+         "000007000000746573746e657405000000746f6b656e0100000000000000",
+     "7.5 XEM"},
+    {"2^63 XEM mosaic units, amount 2^63 millionths",
+         "010100000200009888af640a200000009f96df7e7a639b4034b8bee5b88ab1d640db66eb5a47afe018e320cb"
+         "130c183df04902000000000098bd640a2800000054423749423644534a4b57425651454b3750443754574f36"
+         "36454357354c59365349534d32434a4a000000000000008014000000010000000c00000054657374206d6573"
+         "73616765020000001a0000000e000000030000006e656d0300000078656d0000000000000080200000001400"
+         "000007000000746573746e657405000000746f6b656e0100000000000000",
+     "Overflow"},
+};
+
+static void run_multiplier_cases(void) {
+    char totalXem[MAX_FIELD_LEN];
+    for (size_t i = 0; i < sizeof(MULTIPLIER_CASES) / sizeof(MULTIPLIER_CASES[0]); i++) {
+        const char *hex = MULTIPLIER_CASES[i].hex;
+        size_t length = decode_hex(hex, strlen(hex));
+        run(MULTIPLIER_CASES[i].name, data, length);
+        format_summary_pair(&context.result.summary, 0, totalXem);
+        if (strcmp(totalXem, MULTIPLIER_CASES[i].totalXem) != 0) {
+            printf("[  ERROR   ] Mismatch in Total XEM: <%s> vs <%s>\n",
+                   totalXem,
+                   MULTIPLIER_CASES[i].totalXem);
+            failures++;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s worst_cases.json\n", argv[0]);
+        return 1;
+    }
+    run_multiplier_cases();
+    char *cases = load_file(argv[1]);
+    int count = 0;
+    char name[64] = "";
+    // Entries of the fixtures: "name" then "hex"
+    for (char *cursor = cases; (cursor = strchr(cursor, '"')) != NULL; cursor++) {
+        if (strncmp(cursor, "\"name\": \"", 9) == 0) {
+            sscanf(cursor + 9, "%63[^\"]", name);
+        } else if (strncmp(cursor, "\"hex\": \"", 8) == 0) {
+            cursor += 8;
+            size_t hexLen = strcspn(cursor, "\"");
+            size_t length = decode_hex(cursor, hexLen);
+            run(name, data, length);
+            if (to_hex_message()) {
+                strncat(name, " (hex)", sizeof(name) - strlen(name) - 1);
+                run(name, data, length);
+            }
+            cursor += hexLen;
+            count++;
+        }
+    }
+    free(cases);
+
+    if (count == 0) {
+        fprintf(stderr, "No transaction in %s\n", argv[1]);
+        return 1;
+    }
+    return failures != 0;
+}
@@ -0,0 +1,244 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "nem_parse.h"
+#include "swap_check.h"
+
+// Checks of the transactions signed in swap mode against the transfer validated in the exchange
+// application, on transfers built field by field.
+
+#define RECIPIENT "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O"
+#define OTHER     "TBMOSAICOD4F54EE5CDMR23CCBGOAM2XSJBR5OLC"
+#define AMOUNT    5000000
+#define FEE       100000
+
+typedef struct {
+    uint32_t type;
+    uint8_t version;
+    const char *recipient;
+    uint64_t amount;
+    uint64_t fee;
+    // Plain message, NULL for an encrypted one
+    const char *message;
+    // Mosaic "namespace:name" of a version 2 transfer, NULL for none
+    const char *mosaic;
+} transfer_t;
+
+static uint8_t data[1024];
+static size_t length;
+static parse_context_t context;
+static int failures = 0;
+
+static void put_u32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        data[length++] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static void put_u64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        data[length++] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static void put_bytes(const void *bytes, size_t count) {
+    memcpy(data + length, bytes, count);
+    length += count;
+}
+
+static void put_common_header(uint32_t type, uint8_t version, uint64_t fee) {
+    static const uint8_t publicKey[32] = {0};
+    put_u32(type);
+    data[length++] = version;
+    data[length++] = 0;
+    data[length++] = 0;
+    data[length++] = TESTNET;
+    put_u32(0);
+    put_u32(sizeof(publicKey));
+    put_bytes(publicKey, sizeof(publicKey));
+    put_u64(fee);
+    put_u32(0);
+}
+
+static void put_transfer(const transfer_t *transfer) {
+    put_common_header(NEM_TXN_TRANSFER, transfer->version, transfer->fee);
+    put_u32(NEM_ADDRESS_LENGTH);
+    put_bytes(transfer->recipient, NEM_ADDRESS_LENGTH);
+    put_u64(transfer->amount);
+    if (transfer->message == NULL) {
+        put_u32(2 * sizeof(uint32_t) + 48);
+        put_u32(2);
+        put_u32(48);
+        length += 48;
+    } else if (transfer->message[0] == '\0') {
+        put_u32(0);
+    } else {
+        uint32_t messageLen = strlen(transfer->message);
+        put_u32(2 * sizeof(uint32_t) + messageLen);
+        put_u32(1);
+        put_u32(messageLen);
+        put_bytes(transfer->message, messageLen);
+    }
+    if (transfer->version == 2) {
+        put_u32(transfer->mosaic != NULL ? 1 : 0);
+        if (transfer->mosaic != NULL) {
+            const char *separator = strchr(transfer->mosaic, ':');
+            uint32_t nsLen = separator - transfer->mosaic;
+            uint32_t nameLen = strlen(separator + 1);
+            uint32_t mosaicIdLen = 2 * sizeof(uint32_t) + nsLen + nameLen;
+            put_u32(sizeof(uint32_t) + mosaicIdLen + sizeof(uint64_t));
+            put_u32(mosaicIdLen);
+            put_u32(nsLen);
+            put_bytes(transfer->mosaic, nsLen);
+            put_u32(nameLen);
+            put_bytes(separator + 1, nameLen);
+            put_u64(AMOUNT);
+        }
+    }
+}
+
+static bool parse(void) {
+    memset(&context, 0, sizeof(context));
+    context.data = data;
+    context.length = length;
+    return parse_txn_context(&context) == 0;
+}
+
+// 1 when the transaction can be signed, 0 when it is rejected, -1 when it is not parsed
+static int check(const transfer_t *transfer, const swap_validated_t *validated) {
+    length = 0;
+    put_transfer(transfer);
+    if (!parse()) {
+        return -1;
+    }
+    return swap_check_transaction(&context, validated);
+}
+
+static swap_validated_t validated_transfer(const char *extraId) {
+    swap_validated_t validated = {.initialized = true, .amount = AMOUNT, .fee = FEE};
+    strcpy(validated.destination, RECIPIENT);
+    strcpy(validated.extraId, extraId);
+    return validated;
+}
+
+static int expect(const char *name, int value, bool expected) {
+    if (value != expected) {
+        printf("[  ERROR   ] %s: %s instead of %s\n",
+               name,
+               value < 0 ? "not parsed" : value ? "accepted" : "rejected",
+               expected ? "accepted" : "rejected");
+        return 1;
+    }
+    return 0;
+}
+
+static int test_amounts(void) {
+    uint64_t value;
+    const uint8_t small[] = {0x4c, 0x4b, 0x40};
+    const uint8_t padded[16] = {[8] = 0xff, [15] = 0x01};
+    const uint8_t large[9] = {0x01};
+    int res = 0;
+
+    res |= expect("3 bytes", swap_read_amount(small, sizeof(small), &value), true);
+    res |= expect("3 bytes value", value == AMOUNT, true);
+    res |= expect("16 bytes", swap_read_amount(padded, sizeof(padded), &value), true);
+    res |= expect("16 bytes value", value == 0xff00000000000001, true);
+    res |= expect("2^64", swap_read_amount(large, sizeof(large), &value), false);
+    res |= expect("empty", swap_read_amount(small, 0, &value) && value == 0, true);
+    return res;
+}
+
+static int test_transfers(void) {
+    swap_validated_t validated = validated_transfer("");
+    transfer_t transfer = {NEM_TXN_TRANSFER, 1, RECIPIENT, AMOUNT, FEE, "", NULL};
+    int res = 0;
+
+    res |= expect("validated transfer", check(&transfer, &validated), true);
+    transfer.amount = AMOUNT + 1;
+    res |= expect("other amount", check(&transfer, &validated), false);
+    transfer.amount = AMOUNT;
+    transfer.fee = FEE * 2;
+    res |= expect("other fee", check(&transfer, &validated), false);
+    transfer.fee = FEE;
+    transfer.recipient = OTHER;
+    res |= expect("other recipient", check(&transfer, &validated), false);
+    transfer.recipient = RECIPIENT;
+
+    validated.initialized = false;
+    res |= expect("nothing validated", check(&transfer, &validated), false);
+    return res;
+}
+
+static int test_messages(void) {
+    swap_validated_t validated = validated_transfer("12345");
+    transfer_t transfer = {NEM_TXN_TRANSFER, 1, RECIPIENT, AMOUNT, FEE, "12345", NULL};
+    int res = 0;
+
+    res |= expect("memo", check(&transfer, &validated), true);
+    transfer.message = "123456";
+    res |= expect("other memo", check(&transfer, &validated), false);
+    transfer.message = "";
+    res |= expect("missing memo", check(&transfer, &validated), false);
+    transfer.message = NULL;
+    res |= expect("encrypted message", check(&transfer, &validated), false);
+
+    validated = validated_transfer("");
+    transfer.message = "12345";
+    res |= expect("unexpected message", check(&transfer, &validated), false);
+    return res;
+}
+
+static int test_mosaics(void) {
+    swap_validated_t validated = validated_transfer("");
+    transfer_t transfer = {NEM_TXN_TRANSFER, 2, RECIPIENT, AMOUNT, FEE, "", NULL};
+    int res = 0;
+
+    res |= expect("version 2 without mosaic", check(&transfer, &validated), true);
+    // The quantity is multiplied by the amount of the transaction
+    transfer.mosaic = "nem:xem";
+    transfer.amount = 2000000;
+    res |= expect("version 2 with XEM mosaic", check(&transfer, &validated), false);
+    transfer.amount = 1000000;
+    res |= expect("version 2 with XEM mosaic, multiplier 1", check(&transfer, &validated), false);
+    transfer.mosaic = "foo:bar";
+    transfer.amount = AMOUNT;
+    res |= expect("other mosaic", check(&transfer, &validated), false);
+    return res;
+}
+
+static int test_multisig(void) {
+    swap_validated_t validated = validated_transfer("");
+    transfer_t transfer = {NEM_TXN_TRANSFER, 1, RECIPIENT, AMOUNT, FEE, "", NULL};
+    uint8_t inner[sizeof(data)];
+
+    length = 0;
+    put_transfer(&transfer);
+    size_t innerLength = length;
+    memcpy(inner, data, innerLength);
+    length = 0;
+    put_common_header(NEM_TXN_MULTISIG, 1, 0);
+    put_u32(innerLength);
+    put_bytes(inner, innerLength);
+    return expect("multisig", parse() ? swap_check_transaction(&context, &validated) : -1, false);
+}
+
+static void run(const char *name, int (*test)(void)) {
+    printf("[ RUN      ]  %s\n", name);
+    if (test() != 0) {
+        printf("[  FAILED  ]  %s\n", name);
+        failures++;
+    } else {
+        printf("[       OK ]  %s\n", name);
+    }
+}
+
+int main(void) {
+    run("amounts", test_amounts);
+    run("transfers", test_transfers);
+    run("messages", test_messages);
+    run("mosaics", test_mosaics);
+    run("multisig", test_multisig);
+    return failures != 0;
+}
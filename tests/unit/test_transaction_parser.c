@@ -3,13 +3,11 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
-#include "nem_parse.h"
-#include "app_format.h"
-#include "global.h"  // FIXME: transaction_context_t should be defined elsewhere
-
-transaction_context_t transactionContext;
+#include "cx.h"
+#include "nemparse.h"
 
 typedef struct {
     const char *field_name;
@@ -44,10 +42,36 @@ static uint8_t *load_transaction_data(const char *filename, size_t *size) {
     return data;
 }
 
+static int sha3_hash(cx_md_t algo, const uint8_t *in, size_t inLen, uint8_t *out) {
+    cx_sha3_t hash;
+    if (algo == CX_KECCAK) {
+        cx_keccak_init_no_throw(&hash, 256);
+    } else {
+        cx_sha3_init_no_throw(&hash, 256);
+    }
+    return cx_hash_no_throw(&hash.header, CX_LAST, in, inLen, out, 32);
+}
+
+static int keccak256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    (void) user;
+    return sha3_hash(CX_KECCAK, in, inLen, out);
+}
+
+static int sha3_256(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    (void) user;
+    return sha3_hash(CX_SHA3, in, inLen, out);
+}
+
+static int ripemd160(const uint8_t *in, size_t inLen, uint8_t *out, void *user) {
+    cx_ripemd160_t hash;
+    (void) user;
+    cx_ripemd160_init(&hash);
+    return cx_hash_no_throw(&hash.header, CX_LAST, in, inLen, out, 20);
+}
+
 static void check_transaction_results(const char *filename) {
-    parse_context_t context = {0};
-    char field_name[MAX_FIELDNAME_LEN];
-    char field_value[MAX_FIELD_LEN];
+    char field_name[NEMPARSE_FIELDNAME_LEN];
+    char field_value[NEMPARSE_FIELD_LEN];
 
     size_t tx_length;
     uint8_t *const tx_data = load_transaction_data(filename, &tx_length);
@@ -56,23 +80,30 @@ static void check_transaction_results(const char *filename) {
         exit(1);
     }
 
-    context.data = tx_data;
-    context.length = tx_length;
+    nemparse_ctx_t *context = nemparse_new();
+    if (context == NULL) {
+        fprintf(stderr, "Context allocation failed\n");
+        exit(1);
+    }
+
+    // Displays the addresses of remote and cosignatory public keys, as the application does
+    const nemparse_hash_backend_t backend = {keccak256, sha3_256, ripemd160, NULL};
+    nemparse_set_hash_backend(context, &backend);
 
-    int res = parse_txn_context(&context);
+    int res = nemparse_parse(context, tx_data, tx_length);
     if (res != 0) {
         fprintf(stderr, "Parsing returned %d\n", res);
         exit(1);
     }
 
-    for (int i = 0; i < context.result.numFields; i++) {
-        const field_t *field = &context.result.fields[i];
-        resolve_fieldname(field, field_name);
-        format_field(field, field_value);
+    for (size_t i = 0; i < nemparse_field_count(context); i++) {
+        nemparse_field_name(context, i, field_name, sizeof(field_name));
+        nemparse_format_field(context, i, field_value, sizeof(field_value));
 
         printf("%s::%s\n", field_name, field_value);
     }
 
+    nemparse_free(context);
     free(tx_data);
 
     return;
@@ -1,5 +1,11 @@
 #!/usr/bin/env python3
+"""Names and values of the fields of the corpus transactions, as the application shows them.
 
+With --tx-types, the parser is a lean build supporting these transaction types only (NEM_TX_TYPES
+in the Makefile): the transactions of the other types, or wrapping them, must be rejected.
+"""
+
+import argparse
 import json
 import sys
 from pathlib import Path
@@ -7,7 +13,14 @@ from subprocess import run
 
 NEM_LIB_DIRECTORY = (Path(__file__).parent / "../functional/apps").resolve().as_posix()
 sys.path.append(NEM_LIB_DIRECTORY)
-from nem_transaction_builder import encode_txn_context  # noqa: E402
+from nem_transaction_builder import (  # noqa: E402
+    COMMON_TXN_HEADER,
+    TRANSACTION_TYPES,
+    TRANSFER_TXN_HEADER,
+    UINT32,
+    encode_txn_context,
+)
+from nem_transaction_generator import MAX_RAW_TX  # noqa: E402
 
 CORPUS_DIR = Path(__file__).resolve().parent.parent / "corpus"
 PARSER_BINARY = (Path(__file__).parent / "build/test_transaction_parser").resolve().as_posix()
@@ -181,6 +194,193 @@ TESTS_CASES = {
         ("Rental Fee", "100 XEM"),
         ("Fee", "0.15 XEM"),
     ],
+    "importance_transfer_tx.json": [
+        ("Transaction Type", "Importance Transfer TX"),
+        ("Importance Mode", "Activate"),
+        ("Rmt. Address", "TDOG4QCU4ZXDGHOEKWDOGWMVXVJVJW2LYGQNXLHC"),
+        ("Fee", "0.1 XEM"),
+    ],
+    "multisig_aggregate_modification_tx.json": [
+        ("Transaction Type", "Multisig TX"),
+        ("Multisig Fee", "0.15 XEM"),
+        ("Inner TX Type", "Modify Multisig Aggregate TX"),
+        ("Cosignatory Num", "1"),
+        ("Mod. Type", "Add cosignatory"),
+        ("CosignatoryAddr", "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O"),
+        ("Fee", "0.5 XEM"),
+    ],
+    "multisig_aggregate_modification_2_tx.json": [
+        ("Transaction Type", "Multisig TX"),
+        ("Multisig Fee", "0.15 XEM"),
+        ("Inner TX Type", "Modify Multisig Aggregate TX"),
+        ("Cosignatory Num", "1"),
+        ("Mod. Type", "Add cosignatory"),
+        ("CosignatoryAddr", "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O"),
+        ("Relative Change", "1"),
+        ("Fee", "0.5 XEM"),
+    ],
+}
+
+
+def rename_property(transaction):
+    transaction["fields"]["properties"][1]["propertyName"] = "fooBar"
+    return transaction
+
+
+def lengthen_hex_message(transaction):
+    # 600 bytes: longer than the hex characters fitting in a field value
+    transaction["fields"]["payload"] = "fe" + "ab" * 600
+    return transaction
+
+
+def multiply_mosaics(transaction):
+    # 3 XEM mosaic units, multiplied by 2.5: 7.5 XEM moved
+    transaction["fields"]["amount"] = 2500000
+    transaction["fields"]["mosaicList"][0]["quantity"] = 3000000
+    return transaction
+
+
+def overlong_message(transaction):
+    # More bytes than the application receives, and more review pairs than a field counts
+    transaction["fields"]["payload"] = "ab" * (MAX_RAW_TX + 1)
+    return transaction
+
+
+# Corpus transactions changed before parsing: name, (corpus file, change, expected fields or None
+# when the parser rejects the transaction)
+CHANGED_TESTS_CASES = {
+    "create_mosaic_tx.json, unknown property": (
+        "create_mosaic_tx.json",
+        rename_property,
+        [
+            ("Transaction Type", "Mosaic Definition TX"),
+            ("Parent Name", "test_nem"),
+            ("Mosaic Name", "mosaic_name"),
+            ("Description", "mosaic description"),
+            ("divisibility", "2"),
+            ("Unknown Property", "fooBar: 12"),
+            ("supplyMutable", "true"),
+            ("transferable", "true"),
+            ("Sink Address", "TBMOSAICOD4F54EE5CDMR23CCBGOAM2XSJBR5OLC"),
+            ("Rental Fee", "10 XEM"),
+            ("Fee", "0.15 XEM"),
+        ],
+    ),
+    "transfer_tx.json, long hex message": (
+        "transfer_tx.json",
+        lengthen_hex_message,
+        [
+            ("Transaction Type", "Transfer TX"),
+            ("Recipient", "TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O"),
+            ("Amount", "5 XEM"),
+            ("Message", "ab" * 511),
+            ("Fee", "0.1 XEM"),
+        ],
+    ),
+    "multiple_mosaic_tx.json, multiplier 2.5": (
+        "multiple_mosaic_tx.json",
+        multiply_mosaics,
+        [
+            ("Transaction Type", "Transfer TX"),
+            ("Recipient", "TB7IB6DSJKWBVQEK7PD7TWO66ECW5LY6SISM2CJJ"),
+            ("Message", "Test message"),
+            ("Fee", "0.15 XEM"),
+            ("Multiplier", "2.5"),
+            ("Mosaics", "Found 2"),
+            ("XEM Quantity", "3 XEM"),
+            ("Unknown Mosaic", "Divisibility and levy cannot be shown"),
+            ("Namespace", "testnet: token"),
+            ("Micro Units", "1"),
+        ],
+    ),
+    "transfer_tx.json, message longer than MAX_RAW_TX": ("transfer_tx.json", overlong_message, None),
+}
+
+
+def shorten_prefix(value, last=False):
+    """Lowers by one the length prefix of a fixed size value: address, public key or hash."""
+
+    def corrupt(data):
+        prefixed = UINT32.pack(len(value)) + value
+        offset = data.rfind(prefixed) if last else data.find(prefixed)
+        assert offset >= 0, f"{value.hex()} not found"
+        return data[:offset] + UINT32.pack(len(value) - 1) + data[offset + UINT32.size :]
+
+    return corrupt
+
+
+def add_to_uint32(offset, delta):
+    def corrupt(data):
+        return data[:offset] + UINT32.pack(UINT32.unpack_from(data, offset)[0] + delta) + data[offset + UINT32.size :]
+
+    return corrupt
+
+
+def address(text):
+    return text.encode("ascii")
+
+
+def key(text):
+    return bytes.fromhex(text)
+
+
+# Signer of most corpus transactions, and creator of the mosaics they define
+SIGNER_KEY = bytes.fromhex("9f96df7e7a639b4034b8bee5b88ab1d640db66eb5a47afe018e320cb130c183d")
+# Offset of the message structure length in a transfer transaction
+MESSAGE_LENGTH_OFFSET = COMMON_TXN_HEADER.size + TRANSFER_TXN_HEADER.size - UINT32.size
+# Offset of the inner transaction length of a multisig transaction
+INNER_LENGTH_OFFSET = COMMON_TXN_HEADER.size
+
+# Encoded corpus transactions corrupted before parsing, the parser must reject them: name, (corpus
+# file, corruption of the encoded transaction)
+CORRUPTED_TESTS_CASES = {
+    "transfer_tx.json, trailing byte": ("transfer_tx.json", lambda data: data + b"\x00"),
+    "transfer_tx.json, signer key length 31": ("transfer_tx.json", shorten_prefix(SIGNER_KEY)),
+    "transfer_tx.json, recipient length 39": (
+        "transfer_tx.json",
+        shorten_prefix(address("TBE56Z7MLQZ4S755JZL46VRYM7OD37SLPGFZPO5O")),
+    ),
+    "transfer_tx.json, message structure longer than its payload": (
+        "transfer_tx.json",
+        add_to_uint32(MESSAGE_LENGTH_OFFSET, 1),
+    ),
+    "importance_transfer_tx.json, remote key length 31": (
+        "importance_transfer_tx.json",
+        shorten_prefix(key("6da3760713019e26b186243ab6ecba9f70784c59923d689ab54d4b2bf0e20f5d")),
+    ),
+    "multisig_aggregate_modification_tx.json, cosignatory key length 31": (
+        "multisig_aggregate_modification_tx.json",
+        shorten_prefix(key("a581459b8f16974e59b110fca581ee1ffd140a8c42b9ecdffc316d722f0cda35")),
+    ),
+    "multisig_aggregate_modification_tx.json, inner signer key length 31": (
+        "multisig_aggregate_modification_tx.json",
+        shorten_prefix(key("180158d9feed1711fbfc7718ed144275311dcfd10a4480035d1856cdac7242ab")),
+    ),
+    "multisig_transfer_transaction_tx.json, inner transaction longer than its length": (
+        "multisig_transfer_transaction_tx.json",
+        add_to_uint32(INNER_LENGTH_OFFSET, -1),
+    ),
+    "multisig_signature_transaction.json, hash length 31": (
+        "multisig_signature_transaction.json",
+        shorten_prefix(key("d2c70f814fa87b13da000ca42e52085fa233ce0aae718aaefe16c5652d1a6932")),
+    ),
+    "multisig_signature_transaction.json, multisig address length 39": (
+        "multisig_signature_transaction.json",
+        shorten_prefix(address("TCE7RGODJ5MLM5MCVNCIRSWTEHMLYEEFTY5TBXQB")),
+    ),
+    "create_namespace_tx.json, sink address length 39": (
+        "create_namespace_tx.json",
+        shorten_prefix(address("TAMESPACEWH4MKFMBCVFERDPOOP4FK7MTDJEYP35")),
+    ),
+    "create_mosaic_tx.json, creator key length 31": ("create_mosaic_tx.json", shorten_prefix(SIGNER_KEY, last=True)),
+    "create_mosaic_tx.json, sink address length 39": (
+        "create_mosaic_tx.json",
+        shorten_prefix(address("TBMOSAICOD4F54EE5CDMR23CCBGOAM2XSJBR5OLC")),
+    ),
+    "create_mosaic_levy_tx.json, levy address length 39": (
+        "create_mosaic_levy_tx.json",
+        shorten_prefix(address("TB7IB6DSJKWBVQEK7PD7TWO66ECW5LY6SISM2CJJ")),
+    ),
 }
 # pylint: enable=line-too-long
 
@@ -192,21 +392,43 @@ def assert_equal(a, b, text):
     return True
 
 
-def test_parsing(filename, expected):
-    print("[ RUN      ] ", filename)
+def transaction_types(transaction):
+    """Types of the transaction and of the transactions it wraps."""
+    types = {transaction["common_txn_header"]["transactionType"]}
+    for inner in transaction["fields"].get("transactions", []):
+        types |= transaction_types(inner)
+    return types
+
+
+def test_parsing(filename, expected, binary, tx_types, name=None, change=None, corrupt=None):
+    name = name or filename
+    print("[ RUN      ] ", name)
     with open(CORPUS_DIR / filename, encoding="utf-8") as f:
         transaction = json.load(f)
+    if change is not None:
+        transaction = change(transaction)
 
     tx_data = encode_txn_context(transaction)
+    if corrupt is not None:
+        tx_data = corrupt(tx_data)
 
     with open(TEMP_TXN_FILE, "wb") as f:
         f.write(tx_data)
 
-    cmd = [PARSER_BINARY, TEMP_TXN_FILE]
+    cmd = [binary, TEMP_TXN_FILE]
     res = run(cmd, capture_output=True, check=False)
     status = res.returncode
 
-    if status != 0:
+    if not transaction_types(transaction) <= tx_types:
+        # Left out of the build: rejected by the parser
+        status = 0 if status != 0 and b"Parsing returned" in res.stderr else 1
+        if status != 0:
+            print("[  ERROR   ]  not rejected by a build without", " ".join(sorted(transaction_types(transaction) - tx_types)))
+    elif expected is None:
+        status = 0 if status != 0 and b"Parsing returned" in res.stderr else 1
+        if status != 0:
+            print("[  ERROR   ]  not rejected")
+    elif status != 0:
         print("[  ERROR   ] ", res.stderr)
     else:
         parsed = res.stdout.decode().strip()
@@ -223,16 +445,30 @@ def test_parsing(filename, expected):
                     break
 
     if status != 0:
-        print("[  FAILED  ] ", filename)
+        print("[  FAILED  ] ", name)
     else:
-        print("[       OK ] ", filename)
+        print("[       OK ] ", name)
     return status
 
 
 def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--binary", default=PARSER_BINARY, help="Parser to test, a build of test_transaction_parser.c")
+    parser.add_argument("--tx-types", nargs="+", choices=TRANSACTION_TYPES, help="Transaction types of the build, all by default")
+    args = parser.parse_args()
+    tx_types = set(args.tx_types or TRANSACTION_TYPES)
+
     status = 0
     for filename, expected in TESTS_CASES.items():
-        res = test_parsing(filename, expected)
+        res = test_parsing(filename, expected, args.binary, tx_types)
+        if res != 0:
+            status = res
+    for name, (filename, change, expected) in CHANGED_TESTS_CASES.items():
+        res = test_parsing(filename, expected, args.binary, tx_types, name, change)
+        if res != 0:
+            status = res
+    for name, (filename, corrupt) in CORRUPTED_TESTS_CASES.items():
+        res = test_parsing(filename, None, args.binary, tx_types, name, corrupt=corrupt)
         if res != 0:
             status = res
 